@@ -0,0 +1,275 @@
+#include "message_tracer.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace tracing
+{
+
+namespace
+{
+
+constexpr std::array<char, 8> traceMagic{'P', 'L', 'D', 'M',
+                                         'T', 'R', 'C', '1'};
+
+/** @brief size of a trace file before it is rotated */
+constexpr size_t maxTraceFileSize = 8 * 1024 * 1024;
+
+constexpr size_t traceCapacity = 1024;
+constexpr std::chrono::milliseconds traceFlushInterval{100};
+
+/** @brief header of a record in a trace file, followed by the captured bytes
+ *         of the message
+ */
+struct RecordHeader
+{
+    uint64_t timestamp;
+    uint32_t length;
+    uint16_t captured;
+    uint8_t eid;
+    uint8_t isTx;
+};
+static_assert(sizeof(RecordHeader) == 16);
+
+uint64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+MessageTracer::MessageTracer(size_t capacity,
+                             std::chrono::milliseconds flushInterval) :
+    ring(std::bit_ceil(std::max<size_t>(capacity, 2))),
+    mask(ring.size() - 1), flushInterval(flushInterval)
+{}
+
+MessageTracer::~MessageTracer()
+{
+    stop();
+}
+
+MessageTracer& MessageTracer::GetInstance()
+{
+    static MessageTracer tracer(traceCapacity, traceFlushInterval);
+    return tracer;
+}
+
+bool MessageTracer::start(const fs::path& tracePath)
+{
+    if (enabled)
+    {
+        return true;
+    }
+
+    this->tracePath = tracePath;
+    if (mkdir(tracePath.parent_path().c_str(), S_IRWXU) && errno != EEXIST)
+    {
+        error("Failed to create the trace directory of : {TRACE_PATH}",
+              "TRACE_PATH", tracePath);
+        return false;
+    }
+    if (!open())
+    {
+        return false;
+    }
+
+    stopping = false;
+    enabled = true;
+    flusher = std::thread(&MessageTracer::run, this);
+    info("Tracing the PLDM messages into : {TRACE_PATH}", "TRACE_PATH",
+         tracePath);
+    return true;
+}
+
+void MessageTracer::stop()
+{
+    if (!enabled)
+    {
+        return;
+    }
+
+    enabled = false;
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    stopped.notify_one();
+    flusher.join();
+    if (traceFd != -1)
+    {
+        close(traceFd);
+        traceFd = -1;
+    }
+}
+
+void MessageTracer::record(uint8_t eid, bool isTx,
+                           std::span<const uint8_t> message)
+{
+    if (!enabled)
+    {
+        return;
+    }
+
+    auto start = now();
+    auto index = head.load(std::memory_order_relaxed);
+    if (index - tail.load(std::memory_order_acquire) == ring.size())
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto& slot = ring[index & mask];
+    auto captured = std::min(message.size(), captureSize);
+    slot.timestamp = start;
+    slot.length = static_cast<uint32_t>(message.size());
+    slot.eid = eid;
+    slot.isTx = isTx;
+    std::memcpy(slot.data.data(), message.data(), captured);
+    head.store(index + 1, std::memory_order_release);
+
+    recorded.fetch_add(1, std::memory_order_relaxed);
+    recordTime.fetch_add(now() - start, std::memory_order_relaxed);
+}
+
+MessageTracer::Counters MessageTracer::getCounters() const
+{
+    return {recorded.load(std::memory_order_relaxed),
+            dropped.load(std::memory_order_relaxed),
+            recordTime.load(std::memory_order_relaxed)};
+}
+
+void MessageTracer::run()
+{
+    std::unique_lock lock(mutex);
+    bool done = false;
+    while (!done)
+    {
+        done = stopped.wait_for(lock, flushInterval,
+                                [this] { return stopping; });
+        drain();
+    }
+}
+
+void MessageTracer::drain()
+{
+    auto index = tail.load(std::memory_order_relaxed);
+    auto end = head.load(std::memory_order_acquire);
+    for (; index != end; ++index)
+    {
+        const auto& slot = ring[index & mask];
+        RecordHeader header{
+            slot.timestamp, slot.length,
+            static_cast<uint16_t>(std::min<size_t>(slot.length, captureSize)),
+            slot.eid, slot.isTx};
+        auto headerBytes = reinterpret_cast<const uint8_t*>(&header);
+        buffer.insert(buffer.end(), headerBytes, headerBytes + sizeof(header));
+        buffer.insert(buffer.end(), slot.data.begin(),
+                      slot.data.begin() + header.captured);
+        traceFileSize += sizeof(header) + header.captured;
+        tail.store(index + 1, std::memory_order_release);
+
+        if (traceFileSize > maxTraceFileSize)
+        {
+            flush();
+            if (traceFd != -1)
+            {
+                close(traceFd);
+            }
+            std::error_code ec;
+            fs::rename(tracePath, fs::path(tracePath).concat(".1"), ec);
+            if (!open())
+            {
+                // Keep draining the ring buffer so that the daemon is not
+                // held back, the records are lost
+                error("Failed to rotate the trace file : {TRACE_PATH}",
+                      "TRACE_PATH", tracePath);
+            }
+        }
+    }
+    flush();
+}
+
+bool MessageTracer::open()
+{
+    // Never follow a link planted in place of the trace file
+    traceFd = ::open(tracePath.c_str(),
+                     O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW | O_CLOEXEC,
+                     S_IRUSR | S_IWUSR);
+    if (traceFd == -1)
+    {
+        error("Failed to open the trace file : {TRACE_PATH}, error - {ERROR}",
+              "TRACE_PATH", tracePath, "ERROR", errno);
+        return false;
+    }
+    buffer.assign(traceMagic.begin(), traceMagic.end());
+    traceFileSize = traceMagic.size();
+    return true;
+}
+
+void MessageTracer::flush()
+{
+    size_t offset = 0;
+    while (traceFd != -1 && offset < buffer.size())
+    {
+        auto rc = write(traceFd, buffer.data() + offset,
+                        buffer.size() - offset);
+        if (rc == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            // The records are lost, the ring buffer keeps being drained
+            break;
+        }
+        offset += rc;
+    }
+    buffer.clear();
+}
+
+std::vector<TraceRecord> MessageTracer::parse(std::istream& stream)
+{
+    std::vector<TraceRecord> records;
+    std::array<char, traceMagic.size()> magic{};
+    if (!stream.read(magic.data(), magic.size()) || magic != traceMagic)
+    {
+        return records;
+    }
+
+    RecordHeader header{};
+    while (stream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        if (header.captured > captureSize)
+        {
+            break;
+        }
+        TraceRecord record{header.timestamp, header.length, header.eid,
+                           header.isTx != 0,
+                           std::vector<uint8_t>(header.captured)};
+        if (!stream.read(reinterpret_cast<char*>(record.data.data()),
+                         header.captured))
+        {
+            break;
+        }
+        records.emplace_back(std::move(record));
+    }
+    return records;
+}
+
+} // namespace tracing
+} // namespace pldm
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace pldm
+{
+namespace tracing
+{
+
+namespace fs = std::filesystem;
+
+static constexpr auto messageTracePath = "/run/pldm/message_trace";
+
+/** @brief A PLDM message read back from a trace file */
+struct TraceRecord
+{
+    uint64_t timestamp; //!< nanoseconds since the epoch
+    uint32_t length;    //!< length of the message
+    uint8_t eid;        //!< remote endpoint ID
+    bool isTx;          //!< the message was sent by pldmd
+    std::vector<uint8_t> data; //!< the first bytes of the message
+};
+
+/** @class MessageTracer
+ *
+ *  @brief Records the PLDM messages into a binary trace file, for the
+ *  verbose mode of pldmd.
+ *
+ *  Recording copies the first bytes of a message, with its timestamp and
+ *  EID, into a fixed size single producer single consumer ring buffer,
+ *  without locking nor formatting. A background thread writes the records
+ *  to the trace file every flush interval, the trace file is rotated once
+ *  it exceeds 8 MiB. The trace file is private to root and is never opened
+ *  through a symbolic link. Messages recorded while the ring buffer is full are
+ *  dropped and counted. `pldmtool trace` renders the trace files.
+ *
+ *  The messages must all be recorded from the same thread.
+ */
+class MessageTracer
+{
+  public:
+    /** @brief bytes of a message kept in a record */
+    static constexpr size_t captureSize = 64;
+
+    struct Counters
+    {
+        uint64_t recorded = 0;   //!< messages recorded
+        uint64_t dropped = 0;    //!< messages dropped, the ring buffer full
+        uint64_t recordTime = 0; //!< nanoseconds spent recording messages
+    };
+
+    /** @brief Constructor
+     *
+     *  @param[in] capacity - number of records the ring buffer holds, a
+     *                        power of 2
+     *  @param[in] flushInterval - interval the records are written at
+     */
+    MessageTracer(size_t capacity, std::chrono::milliseconds flushInterval);
+
+    MessageTracer(const MessageTracer&) = delete;
+    MessageTracer& operator=(const MessageTracer&) = delete;
+    ~MessageTracer();
+
+    /** @brief Get the tracer of the PLDM daemon */
+    static MessageTracer& GetInstance();
+
+    /** @brief Start writing the records to a trace file, its directory is
+     *         created if missing
+     *
+     *  @param[in] tracePath - path of the trace file
+     *
+     *  @return true if the trace file could be opened
+     */
+    bool start(const fs::path& tracePath);
+
+    /** @brief Write the pending records and stop the background thread */
+    void stop();
+
+    /** @brief Check if the messages are recorded
+     *
+     *  @return true once started
+     */
+    bool isEnabled() const
+    {
+        return enabled;
+    }
+
+    /** @brief Record a PLDM message, a no-op until started
+     *
+     *  @param[in] eid - remote endpoint ID
+     *  @param[in] isTx - the message is sent by pldmd
+     *  @param[in] message - the PLDM message
+     */
+    void record(uint8_t eid, bool isTx, std::span<const uint8_t> message);
+
+    /** @brief Get the tracer counters
+     *
+     *  @return the counters
+     */
+    Counters getCounters() const;
+
+    /** @brief Read the records of a trace file
+     *
+     *  @param[in] stream - content of the trace file
+     *
+     *  @return the records, up to the first truncated or invalid one
+     */
+    static std::vector<TraceRecord> parse(std::istream& stream);
+
+  private:
+    struct Slot
+    {
+        uint64_t timestamp;
+        uint32_t length;
+        uint8_t eid;
+        bool isTx;
+        std::array<uint8_t, captureSize> data;
+    };
+
+    /** @brief Write the records to the trace file until stopped */
+    void run();
+
+    /** @brief Write the records in the ring buffer to the trace file */
+    void drain();
+
+    /** @brief Open a new trace file */
+    bool open();
+
+    /** @brief Write the buffered records to the trace file */
+    void flush();
+
+    std::vector<Slot> ring;
+    size_t mask;
+    std::chrono::milliseconds flushInterval;
+
+    std::atomic<size_t> head = 0; //!< next slot written, by record()
+    std::atomic<size_t> tail = 0; //!< next slot read, by the thread
+
+    std::atomic<uint64_t> recorded = 0;
+    std::atomic<uint64_t> dropped = 0;
+    std::atomic<uint64_t> recordTime = 0;
+
+    bool enabled = false;
+    fs::path tracePath;
+    int traceFd = -1;
+    size_t traceFileSize = 0;
+
+    /** @brief records written to the trace file on the next flush */
+    std::vector<uint8_t> buffer;
+
+    std::mutex mutex;
+    std::condition_variable stopped;
+    bool stopping = false;
+    std::thread flusher;
+};
+
+} // namespace tracing
+} // namespace pldm
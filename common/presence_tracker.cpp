@@ -0,0 +1,195 @@
+#include "presence_tracker.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace utils
+{
+
+namespace
+{
+
+constexpr auto itemInterface = "xyz.openbmc_project.Inventory.Item";
+constexpr auto presentProperty = "Present";
+
+} // namespace
+
+PresenceTracker& PresenceTracker::GetInstance()
+{
+    static PresenceTracker tracker;
+    return tracker;
+}
+
+std::vector<std::unique_ptr<sdbusplus::bus::match_t>>
+    PresenceTracker::watch(const std::string& path)
+{
+    using namespace sdbusplus::bus::match::rules;
+
+    auto& bus = DBusHandler::getBus();
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> pathMatches;
+    pathMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, propertiesChanged(path, itemInterface),
+        [this](sdbusplus::message_t& msg) { onPropertiesChanged(msg); }));
+    pathMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, interfacesAddedAtPath(path),
+        [this](sdbusplus::message_t& msg) { onInterfacesAdded(msg); }));
+    pathMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, interfacesRemovedAtPath(path),
+        [this](sdbusplus::message_t& msg) { onInterfacesRemoved(msg); }));
+    return pathMatches;
+}
+
+bool PresenceTracker::isPresent(const std::string& path)
+{
+    if (auto it = presence.find(path); it != presence.end())
+    {
+        return it->second;
+    }
+
+    // Subscribe ahead of the read, so that no transition is missed in between
+    bool watched = matches.contains(path);
+    if (!watched)
+    {
+        try
+        {
+            matches.emplace(path, watch(path));
+            watched = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to track the presence of the inventory item at {PATH}, error - {ERROR}",
+                "PATH", path, "ERROR", e);
+        }
+    }
+
+    auto present = readPresence(path);
+    if (!present)
+    {
+        return false;
+    }
+    if (watched)
+    {
+        presence.try_emplace(path, *present);
+    }
+    return *present;
+}
+
+bool PresenceTracker::setPresence(const std::string& path, bool present)
+{
+    if (!writePresence(path, present))
+    {
+        return false;
+    }
+    if (presence.contains(path))
+    {
+        update(path, present);
+    }
+    return true;
+}
+
+void PresenceTracker::subscribe(Subscriber subscriber)
+{
+    subscribers.emplace_back(std::move(subscriber));
+}
+
+void PresenceTracker::update(const std::string& path, bool present)
+{
+    auto [it, inserted] = presence.try_emplace(path, present);
+    if (!inserted)
+    {
+        if (it->second == present)
+        {
+            return;
+        }
+        it->second = present;
+    }
+
+    for (const auto& subscriber : subscribers)
+    {
+        subscriber(path, present);
+    }
+}
+
+std::optional<bool> PresenceTracker::readPresence(const std::string& path)
+{
+    try
+    {
+        auto propVal = DBusHandler().getDbusPropertyVariant(
+            path.c_str(), presentProperty, itemInterface);
+        return std::get<bool>(propVal);
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to check for FRU presence at {PATH}, error - {ERROR}",
+              "PATH", path, "ERROR", e);
+    }
+    return std::nullopt;
+}
+
+bool PresenceTracker::writePresence(const std::string& path, bool present)
+{
+    PropertyValue value{present};
+    DBusMapping dbusMapping;
+    dbusMapping.objectPath = path;
+    dbusMapping.interface = itemInterface;
+    dbusMapping.propertyName = presentProperty;
+    dbusMapping.propertyType = "bool";
+    try
+    {
+        DBusHandler().setDbusProperty(dbusMapping, value);
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to set the present property on path '{PATH}', error - {ERROR}.",
+            "PATH", path, "ERROR", e);
+        return false;
+    }
+    return true;
+}
+
+void PresenceTracker::onInterfacesAdded(sdbusplus::message_t& msg)
+{
+    sdbusplus::message::object_path path;
+    InterfaceMap interfaces;
+    msg.read(path, interfaces);
+
+    if (auto present = getFruPresence(interfaces))
+    {
+        update(path.str, *present);
+    }
+}
+
+void PresenceTracker::onInterfacesRemoved(sdbusplus::message_t& msg)
+{
+    sdbusplus::message::object_path path;
+    std::vector<std::string> interfaces;
+    msg.read(path, interfaces);
+
+    if (std::ranges::find(interfaces, itemInterface) != interfaces.end())
+    {
+        update(path.str, false);
+    }
+}
+
+void PresenceTracker::onPropertiesChanged(sdbusplus::message_t& msg)
+{
+    std::string interface;
+    DbusChangedProps props;
+    msg.read(interface, props);
+
+    auto present = props.find(presentProperty);
+    if (present != props.end() && std::holds_alternative<bool>(present->second))
+    {
+        update(msg.get_path(), std::get<bool>(present->second));
+    }
+}
+
+} // namespace utils
+} // namespace pldm
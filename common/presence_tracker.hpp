@@ -0,0 +1,138 @@
+#pragma once
+
+#include "common/utils.hpp"
+
+#include <sdbusplus/bus/match.hpp>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @class PresenceTracker
+ *
+ *  @brief Tracks the Present property of the inventory items in memory.
+ *
+ *  An item is read from D-Bus on its first presence query and tracked from
+ *  then on, through the PropertiesChanged, InterfacesAdded and
+ *  InterfacesRemoved signals of its own object path, so that the later
+ *  queries are answered without a D-Bus round trip. Only the items queried
+ *  are watched. The subscribers are notified of the presence transitions of
+ *  the tracked items. An item that can't be read or watched is not tracked,
+ *  its next query goes to D-Bus.
+ */
+class PresenceTracker
+{
+  public:
+    /** @brief Callback notified of a presence transition
+     *
+     *  @param[in] path - object path of the inventory item
+     *  @param[in] present - presence of the item
+     */
+    using Subscriber =
+        std::function<void(const std::string& path, bool present)>;
+
+    PresenceTracker() = default;
+    PresenceTracker(const PresenceTracker&) = delete;
+    PresenceTracker& operator=(const PresenceTracker&) = delete;
+    virtual ~PresenceTracker() = default;
+
+    /** @brief Get the tracker used by checkForFruPresence and
+     *         setFruPresence
+     */
+    static PresenceTracker& GetInstance();
+
+    /** @brief Check if an inventory item is present, the item is read from
+     *         D-Bus and tracked if it is not yet
+     *
+     *  @param[in] path - object path of the inventory item
+     *
+     *  @return true if the item is present, false if it is absent or can't
+     *          be read
+     */
+    bool isPresent(const std::string& path);
+
+    /** @brief Set the Present property of an inventory item, the tracked
+     *         presence is updated once the property is set
+     *
+     *  @param[in] path - object path of the inventory item
+     *  @param[in] present - presence of the item
+     *
+     *  @return true if the property is set
+     */
+    bool setPresence(const std::string& path, bool present);
+
+    /** @brief Subscribe to the presence transitions of the tracked items
+     *
+     *  @param[in] subscriber - callback notified of the transitions
+     */
+    void subscribe(Subscriber subscriber);
+
+    /** @brief Update the presence of a tracked inventory item, notifying the
+     *         subscribers if it changed
+     *
+     *  @param[in] path - object path of the inventory item
+     *  @param[in] present - presence of the item
+     */
+    void update(const std::string& path, bool present);
+
+  protected:
+    /** @brief Subscribe to the signals of an inventory item
+     *
+     *  @param[in] path - object path of the inventory item
+     *
+     *  @return the matches of the signals
+     *
+     *  @throw std::exception if the signals can't be subscribed to
+     */
+    virtual std::vector<std::unique_ptr<sdbusplus::bus::match_t>>
+        watch(const std::string& path);
+
+    /** @brief Read the Present property of an inventory item from D-Bus
+     *
+     *  @param[in] path - object path of the inventory item
+     *
+     *  @return presence of the item, std::nullopt if the property can't be
+     *          read
+     */
+    virtual std::optional<bool> readPresence(const std::string& path);
+
+    /** @brief Set the Present property of an inventory item on D-Bus
+     *
+     *  @param[in] path - object path of the inventory item
+     *  @param[in] present - presence of the item
+     *
+     *  @return true if the property is set
+     */
+    virtual bool writePresence(const std::string& path, bool present);
+
+  private:
+    /** @brief Handle the InterfacesAdded signal of an inventory item */
+    void onInterfacesAdded(sdbusplus::message_t& msg);
+
+    /** @brief Handle the InterfacesRemoved signal of an inventory item */
+    void onInterfacesRemoved(sdbusplus::message_t& msg);
+
+    /** @brief Handle the PropertiesChanged signal of an inventory item */
+    void onPropertiesChanged(sdbusplus::message_t& msg);
+
+    /** @brief presence of the tracked inventory items keyed by object path */
+    std::unordered_map<std::string, bool> presence;
+
+    std::vector<Subscriber> subscribers;
+
+    /** @brief matches of the watched inventory items keyed by object path */
+    std::unordered_map<std::string,
+                       std::vector<std::unique_ptr<sdbusplus::bus::match_t>>>
+        matches;
+};
+
+} // namespace utils
+} // namespace pldm
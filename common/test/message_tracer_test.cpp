@@ -0,0 +1,101 @@
+#include "common/message_tracer.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::tracing;
+using namespace std::chrono_literals;
+
+TEST(MessageTracer, recordAndParse)
+{
+    auto tracePath = fs::temp_directory_path() / "message_tracer_test";
+    MessageTracer tracer(8, 10ms);
+
+    std::vector<uint8_t> request{0x80, 0x00, 0x04, 0x00, 0x00};
+    tracer.record(9, false, request);
+    EXPECT_EQ(tracer.getCounters().recorded, 0u);
+
+    ASSERT_TRUE(tracer.start(tracePath));
+    tracer.record(9, false, request);
+    std::vector<uint8_t> response(MessageTracer::captureSize + 16, 0xaa);
+    tracer.record(9, true, response);
+    tracer.stop();
+
+    std::ifstream traceFile(tracePath, std::ios::binary);
+    auto records = MessageTracer::parse(traceFile);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].eid, 9);
+    EXPECT_FALSE(records[0].isTx);
+    EXPECT_EQ(records[0].length, request.size());
+    EXPECT_EQ(records[0].data, request);
+    EXPECT_TRUE(records[1].isTx);
+    EXPECT_EQ(records[1].length, response.size());
+    EXPECT_EQ(records[1].data.size(), MessageTracer::captureSize);
+    EXPECT_LE(records[0].timestamp, records[1].timestamp);
+
+    auto counters = tracer.getCounters();
+    EXPECT_EQ(counters.recorded, 2u);
+    EXPECT_EQ(counters.dropped, 0u);
+    fs::remove(tracePath);
+}
+
+TEST(MessageTracer, dropWhenFull)
+{
+    auto tracePath = fs::temp_directory_path() / "message_tracer_full_test";
+    MessageTracer tracer(4, 1h);
+    ASSERT_TRUE(tracer.start(tracePath));
+
+    // The records are not written before the tracer is stopped
+    std::vector<uint8_t> request{0x80, 0x00, 0x04};
+    for (uint8_t i = 0; i < 6; ++i)
+    {
+        request[2] = i;
+        tracer.record(8, false, request);
+    }
+    tracer.stop();
+
+    auto counters = tracer.getCounters();
+    EXPECT_EQ(counters.recorded, 4u);
+    EXPECT_EQ(counters.dropped, 2u);
+
+    std::ifstream traceFile(tracePath, std::ios::binary);
+    auto records = MessageTracer::parse(traceFile);
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_EQ(records[3].data[2], 3);
+    fs::remove(tracePath);
+}
+
+TEST(MessageTracer, privateTraceFile)
+{
+    auto traceDir = fs::temp_directory_path() / "message_tracer_link_test";
+    fs::remove_all(traceDir);
+    auto tracePath = traceDir / "trace";
+    auto targetPath = fs::temp_directory_path() / "message_tracer_target";
+    std::ofstream(targetPath) << "target";
+
+    // The trace directory is created, the trace file is private
+    MessageTracer tracer(4, 1h);
+    ASSERT_TRUE(tracer.start(tracePath));
+    tracer.stop();
+    EXPECT_EQ(fs::status(tracePath).permissions(),
+              fs::perms::owner_read | fs::perms::owner_write);
+
+    // A link planted in place of the trace file is never followed
+    fs::remove(tracePath);
+    fs::create_symlink(targetPath, tracePath);
+    EXPECT_FALSE(tracer.start(tracePath));
+    EXPECT_FALSE(tracer.isEnabled());
+    EXPECT_EQ(fs::file_size(targetPath), 6u);
+
+    fs::remove_all(traceDir);
+    fs::remove(targetPath);
+}
+
+TEST(MessageTracer, parseInvalid)
+{
+    std::istringstream notATrace("PLDMTRC0");
+    EXPECT_TRUE(MessageTracer::parse(notATrace).empty());
+}
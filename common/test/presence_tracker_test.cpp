@@ -0,0 +1,111 @@
+#include "common/presence_tracker.hpp"
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+
+namespace
+{
+
+class MockTracker : public PresenceTracker
+{
+  public:
+    std::map<std::string, bool> items;
+    std::vector<std::string> reads;
+    std::vector<std::string> watched;
+    std::vector<std::pair<std::string, bool>> writes;
+    bool writeFails = false;
+
+  protected:
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>>
+        watch(const std::string& path) override
+    {
+        watched.emplace_back(path);
+        return {};
+    }
+
+    std::optional<bool> readPresence(const std::string& path) override
+    {
+        reads.emplace_back(path);
+        if (auto it = items.find(path); it != items.end())
+        {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    bool writePresence(const std::string& path, bool present) override
+    {
+        writes.emplace_back(path, present);
+        return !writeFails;
+    }
+};
+
+constexpr auto cpu0 = "/xyz/openbmc_project/inventory/system/cpu0";
+constexpr auto cpu1 = "/xyz/openbmc_project/inventory/system/cpu1";
+constexpr auto dimm0 = "/xyz/openbmc_project/inventory/system/dimm0";
+
+} // namespace
+
+TEST(PresenceTracker, trackOnFirstQuery)
+{
+    MockTracker tracker;
+    tracker.items = {{cpu0, true}, {cpu1, false}};
+
+    std::vector<std::pair<std::string, bool>> transitions;
+    tracker.subscribe([&transitions](const std::string& path, bool present) {
+        transitions.emplace_back(path, present);
+    });
+
+    // Each item is read and watched once, then answered from memory
+    EXPECT_TRUE(tracker.isPresent(cpu0));
+    EXPECT_FALSE(tracker.isPresent(cpu1));
+    EXPECT_TRUE(tracker.isPresent(cpu0));
+    EXPECT_FALSE(tracker.isPresent(cpu1));
+    EXPECT_EQ(tracker.reads, (std::vector<std::string>{cpu0, cpu1}));
+    EXPECT_EQ(tracker.watched, (std::vector<std::string>{cpu0, cpu1}));
+
+    // Only the transitions are notified
+    tracker.update(cpu0, true);
+    tracker.update(cpu1, true);
+    EXPECT_TRUE(tracker.isPresent(cpu1));
+    EXPECT_TRUE(tracker.setPresence(cpu0, false));
+    EXPECT_FALSE(tracker.isPresent(cpu0));
+    EXPECT_EQ(tracker.writes,
+              (std::vector<std::pair<std::string, bool>>{{cpu0, false}}));
+    EXPECT_EQ(transitions,
+              (std::vector<std::pair<std::string, bool>>{{cpu1, true},
+                                                         {cpu0, false}}));
+}
+
+TEST(PresenceTracker, failedRead)
+{
+    MockTracker tracker;
+
+    // An item that can't be read is reported absent and read again
+    EXPECT_FALSE(tracker.isPresent(dimm0));
+    tracker.items[dimm0] = true;
+    EXPECT_TRUE(tracker.isPresent(dimm0));
+    EXPECT_TRUE(tracker.isPresent(dimm0));
+    EXPECT_EQ(tracker.reads, (std::vector<std::string>{dimm0, dimm0}));
+    EXPECT_EQ(tracker.watched, std::vector<std::string>{dimm0});
+}
+
+TEST(PresenceTracker, failedWrite)
+{
+    MockTracker tracker;
+    tracker.items = {{cpu0, true}};
+    EXPECT_TRUE(tracker.isPresent(cpu0));
+
+    // The tracked presence is left as is when the property can't be set
+    tracker.writeFails = true;
+    EXPECT_FALSE(tracker.setPresence(cpu0, false));
+    EXPECT_TRUE(tracker.isPresent(cpu0));
+}
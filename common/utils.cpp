@@ -1,5 +1,7 @@
 #include "utils.hpp"
 
+#include "presence_tracker.hpp"
+
 #include <libpldm/pdr.h>
 #include <libpldm/pldm_types.h>
 
@@ -616,22 +618,23 @@ std::string getCurrentSystemTime()
 
 bool checkForFruPresence(const std::string& objPath)
 {
-    bool isPresent = false;
-    static constexpr auto presentInterface =
-        "xyz.openbmc_project.Inventory.Item";
-    static constexpr auto presentProperty = "Present";
-    try
+    return PresenceTracker::GetInstance().isPresent(objPath);
+}
+
+std::optional<bool> getFruPresence(const InterfaceMap& interfaces)
+{
+    auto item = interfaces.find("xyz.openbmc_project.Inventory.Item");
+    if (item == interfaces.end())
     {
-        auto propVal = pldm::utils::DBusHandler().getDbusPropertyVariant(
-            objPath.c_str(), presentProperty, presentInterface);
-        isPresent = std::get<bool>(propVal);
+        return std::nullopt;
     }
-    catch (const sdbusplus::exception::SdBusError& e)
+    auto present = item->second.find("Present");
+    if (present == item->second.end() ||
+        !std::holds_alternative<bool>(present->second))
     {
-        error("Failed to check for FRU presence at {PATH}, error - {ERROR}",
-              "PATH", objPath, "ERROR", e);
+        return std::nullopt;
     }
-    return isPresent;
+    return std::get<bool>(present->second);
 }
 
 bool checkIfLogicalBitSet(const uint16_t& containerId)
@@ -641,22 +644,7 @@ bool checkIfLogicalBitSet(const uint16_t& containerId)
 
 void setFruPresence(const std::string& fruObjPath, bool present)
 {
-    pldm::utils::PropertyValue value{present};
-    pldm::utils::DBusMapping dbusMapping;
-    dbusMapping.objectPath = fruObjPath;
-    dbusMapping.interface = "xyz.openbmc_project.Inventory.Item";
-    dbusMapping.propertyName = "Present";
-    dbusMapping.propertyType = "bool";
-    try
-    {
-        pldm::utils::DBusHandler().setDbusProperty(dbusMapping, value);
-    }
-    catch (const std::exception& e)
-    {
-        error(
-            "Failed to set the present property on path '{PATH}', error - {ERROR}.",
-            "PATH", fruObjPath, "ERROR", e);
-    }
+    PresenceTracker::GetInstance().setPresence(fruObjPath, present);
 }
 
 } // namespace utils
@@ -24,6 +24,7 @@
 #include <filesystem>
 #include <iostream>
 #include <map>
+#include <optional>
 #include <string>
 #include <variant>
 #include <vector>
@@ -466,13 +467,24 @@ std::vector<std::string> split(std::string_view srcStr, std::string_view delim,
  */
 std::string getCurrentSystemTime();
 
-/** @brief checks if the FRU is actually present.
+/** @brief checks if the FRU is actually present, as tracked by the
+ *         PresenceTracker.
  *  @param[in] objPath - FRU object path.
  *
  *  @return bool to indicate presence or absence of FRU.
  */
 bool checkForFruPresence(const std::string& objPath);
 
+/** @brief Get the presence of an inventory item from its interfaces, as
+ *         fetched along with the inventory objects
+ *
+ *  @param[in] interfaces - interfaces and properties of the inventory item
+ *
+ *  @return the Present property, std::nullopt if the interfaces don't carry
+ *          it
+ */
+std::optional<bool> getFruPresence(const InterfaceMap& interfaces);
+
 /** @brief Method to check if the logical bit is set
  *
  *  @param[containerId] - container id of the entity
@@ -0,0 +1,77 @@
+#include "descriptor_index.hpp"
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+DescriptorIndex::DescriptorIndex(const DescriptorMap& descriptorMap) :
+    descriptorMap(descriptorMap)
+{
+    eids.reserve(descriptorMap.size());
+    for (const auto& [id, descriptors] : descriptorMap)
+    {
+        eids.emplace_back(id);
+        for (const auto& [type, value] : descriptors)
+        {
+            index[DescriptorKey(type, value)].emplace_back(id);
+        }
+    }
+}
+
+std::vector<eid> DescriptorIndex::match(const Descriptors& descriptors) const
+{
+    if (descriptors.empty())
+    {
+        return eids;
+    }
+
+    // Start from the descriptor shared by the fewest firmware devices
+    const std::vector<eid>* candidates = nullptr;
+    DescriptorType selectedType{};
+    for (const auto& [type, value] : descriptors)
+    {
+        auto search = index.find(DescriptorKey(type, value));
+        if (search == index.end())
+        {
+            return {};
+        }
+        if (!candidates || search->second.size() < candidates->size())
+        {
+            candidates = &search->second;
+            selectedType = type;
+        }
+    }
+
+    std::vector<eid> matches;
+    for (auto id : *candidates)
+    {
+        bool matched = true;
+        for (const auto& [type, value] : descriptors)
+        {
+            if (type != selectedType && !hasDescriptor(id, type, value))
+            {
+                matched = false;
+                break;
+            }
+        }
+        if (matched)
+        {
+            matches.emplace_back(id);
+        }
+    }
+    return matches;
+}
+
+bool DescriptorIndex::hasDescriptor(
+    eid id, DescriptorType type, const Descriptors::mapped_type& value) const
+{
+    const auto& descriptors = descriptorMap.at(id);
+    auto search = descriptors.find(type);
+    return search != descriptors.end() && search->second == value;
+}
+
+} // namespace fw_update
+
+} // namespace pldm
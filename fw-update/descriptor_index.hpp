@@ -0,0 +1,77 @@
+#pragma once
+
+#include "common/types.hpp"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+/** @class DescriptorIndex
+ *
+ *  @brief Index of the descriptors of the discovered firmware devices, keyed
+ *  by the (descriptor type, descriptor value) tuple. A firmware device ID
+ *  record of a package resolves to its matching endpoints by looking up its
+ *  most selective descriptor and checking the remaining descriptors of the
+ *  few candidates left, instead of comparing it against every endpoint.
+ *
+ *  The index refers to the descriptor map it was built from, which must
+ *  outlive it and not change in between.
+ */
+class DescriptorIndex
+{
+  public:
+    DescriptorIndex() = delete;
+    DescriptorIndex(const DescriptorIndex&) = delete;
+    DescriptorIndex& operator=(const DescriptorIndex&) = delete;
+    DescriptorIndex(DescriptorIndex&&) = default;
+    DescriptorIndex& operator=(DescriptorIndex&&) = delete;
+    ~DescriptorIndex() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] descriptorMap - descriptors of the firmware devices keyed by
+     *                             EID, as discovered by the InventoryManager
+     */
+    explicit DescriptorIndex(const DescriptorMap& descriptorMap);
+
+    /** @brief Find the firmware devices matching a set of descriptors
+     *
+     *  @param[in] descriptors - descriptors of a firmware device ID record
+     *
+     *  @return EIDs of the firmware devices having all the descriptors, in
+     *          the iteration order of the descriptor map
+     */
+    std::vector<eid> match(const Descriptors& descriptors) const;
+
+  private:
+    using DescriptorKey = std::pair<DescriptorType, Descriptors::mapped_type>;
+
+    /** @brief Check if a firmware device has a descriptor
+     *
+     *  @param[in] id - EID of the firmware device
+     *  @param[in] type - descriptor type
+     *  @param[in] value - descriptor value
+     *
+     *  @return true if the firmware device has the descriptor
+     */
+    bool hasDescriptor(eid id, DescriptorType type,
+                       const Descriptors::mapped_type& value) const;
+
+    const DescriptorMap& descriptorMap; //!< descriptors keyed by EID
+    std::vector<eid> eids; //!< EIDs in the iteration order of descriptorMap
+
+    /** @brief EIDs having a descriptor, in the iteration order of
+     *         descriptorMap
+     */
+    std::map<DescriptorKey, std::vector<eid>> index;
+};
+
+} // namespace fw_update
+
+} // namespace pldm
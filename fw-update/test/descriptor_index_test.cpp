@@ -0,0 +1,99 @@
+#include "fw-update/descriptor_index.hpp"
+
+#include <libpldm/firmware_update.h>
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace pldm::fw_update;
+
+TEST(DescriptorIndex, match)
+{
+    DescriptorMap descriptorMap{
+        {1,
+         {{PLDM_FWUP_IANA_ENTERPRISE_ID,
+           std::vector<uint8_t>{0x0a, 0x0b, 0x0c, 0x0d}},
+          {PLDM_FWUP_VENDOR_DEFINED,
+           std::make_tuple("OpenBMC", std::vector<uint8_t>{0x01, 0x02})}}},
+        {2,
+         {{PLDM_FWUP_IANA_ENTERPRISE_ID,
+           std::vector<uint8_t>{0x0a, 0x0b, 0x0c, 0x0d}},
+          {PLDM_FWUP_VENDOR_DEFINED,
+           std::make_tuple("OpenBMC", std::vector<uint8_t>{0x01, 0x03})}}},
+        {3,
+         {{PLDM_FWUP_IANA_ENTERPRISE_ID,
+           std::vector<uint8_t>{0x0a, 0x0b, 0x0c, 0x0e}}}}};
+    DescriptorIndex descriptorIndex(descriptorMap);
+
+    Descriptors vendor{
+        {PLDM_FWUP_IANA_ENTERPRISE_ID,
+         std::vector<uint8_t>{0x0a, 0x0b, 0x0c, 0x0d}}};
+    auto matches = descriptorIndex.match(vendor);
+    std::ranges::sort(matches);
+    EXPECT_EQ(matches, (std::vector<eid>{1, 2}));
+
+    Descriptors device{
+        {PLDM_FWUP_IANA_ENTERPRISE_ID,
+         std::vector<uint8_t>{0x0a, 0x0b, 0x0c, 0x0d}},
+        {PLDM_FWUP_VENDOR_DEFINED,
+         std::make_tuple("OpenBMC", std::vector<uint8_t>{0x01, 0x03})}};
+    EXPECT_EQ(descriptorIndex.match(device), (std::vector<eid>{2}));
+
+    Descriptors unknown{
+        {PLDM_FWUP_IANA_ENTERPRISE_ID,
+         std::vector<uint8_t>{0x0a, 0x0b, 0x0c, 0x0d}},
+        {PLDM_FWUP_VENDOR_DEFINED,
+         std::make_tuple("OpenBMC", std::vector<uint8_t>{0x01, 0x04})}};
+    EXPECT_TRUE(descriptorIndex.match(unknown).empty());
+
+    EXPECT_EQ(descriptorIndex.match({}).size(), descriptorMap.size());
+}
+
+TEST(DescriptorIndex, matchSyntheticPopulation)
+{
+    // 250 firmware devices spread across 10 vendors and 25 device IDs, with
+    // a package carrying a record for every vendor and device ID pair
+    constexpr uint8_t numVendors = 10;
+    constexpr uint8_t numDeviceIds = 25;
+
+    DescriptorMap descriptorMap;
+    for (uint8_t vendor = 0; vendor < numVendors; ++vendor)
+    {
+        for (uint8_t deviceId = 0; deviceId < numDeviceIds; ++deviceId)
+        {
+            descriptorMap.emplace(
+                vendor * numDeviceIds + deviceId,
+                Descriptors{{PLDM_FWUP_IANA_ENTERPRISE_ID,
+                             std::vector<uint8_t>{0x00, 0x00, 0x00, vendor}},
+                            {PLDM_FWUP_PCI_DEVICE_ID,
+                             std::vector<uint8_t>{deviceId, 0x00}}});
+        }
+    }
+    DescriptorIndex descriptorIndex(descriptorMap);
+
+    for (uint8_t vendor = 0; vendor < numVendors; ++vendor)
+    {
+        for (uint8_t deviceId = 0; deviceId < numDeviceIds; ++deviceId)
+        {
+            Descriptors record{
+                {PLDM_FWUP_IANA_ENTERPRISE_ID,
+                 std::vector<uint8_t>{0x00, 0x00, 0x00, vendor}},
+                {PLDM_FWUP_PCI_DEVICE_ID,
+                 std::vector<uint8_t>{deviceId, 0x00}}};
+
+            std::vector<eid> expected;
+            for (const auto& [id, descriptors] : descriptorMap)
+            {
+                if (std::includes(descriptors.begin(), descriptors.end(),
+                                  record.begin(), record.end()))
+                {
+                    expected.emplace_back(id);
+                }
+            }
+            ASSERT_EQ(expected.size(), 1u);
+            EXPECT_EQ(descriptorIndex.match(record), expected);
+        }
+    }
+}
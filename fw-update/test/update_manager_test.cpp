@@ -0,0 +1,107 @@
+#include "common/utils.hpp"
+#include "fw-update/update_manager.hpp"
+#include "test/test_instance_id.hpp"
+
+#include <libpldm/firmware_update.h>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace std::chrono;
+using namespace pldm::fw_update;
+
+class UpdateManagerTest : public testing::Test
+{
+  protected:
+    UpdateManagerTest() :
+        event(sdeventplus::Event::get_default()), instanceIdDb(),
+        reqHandler(nullptr, event, instanceIdDb, false, seconds(1), 2,
+                   milliseconds(100)),
+        updateManager(event, reqHandler, instanceIdDb, descriptorMap,
+                      componentInfoMap)
+    {
+        char tmpDir[] = "/tmp/pldm_fw_update_test_XXXXXX";
+        packageDir = mkdtemp(tmpDir);
+    }
+
+    ~UpdateManagerTest()
+    {
+        std::filesystem::remove_all(packageDir);
+    }
+
+    /** @brief Copy the first size bytes of the test package */
+    std::filesystem::path copyPackage(const std::string& name, size_t size)
+    {
+        std::ifstream in("./test_pkg", std::ios::binary);
+        std::vector<char> data(size);
+        in.read(data.data(), data.size());
+        data.resize(in.gcount());
+
+        auto path = packageDir / name;
+        std::ofstream out(path, std::ios::binary);
+        out.write(data.data(), data.size());
+        return path;
+    }
+
+    /** @brief Run the scheduled ingestion stage */
+    void runStage()
+    {
+        event.run(microseconds(0));
+    }
+
+    sdeventplus::Event event;
+    TestInstanceIdDb instanceIdDb;
+    requester::Handler<requester::Request> reqHandler;
+    DescriptorMap descriptorMap{
+        {0x01,
+         {{PLDM_FWUP_UUID,
+           std::vector<uint8_t>{0x16, 0x20, 0x23, 0xC9, 0x3E, 0xC5, 0x41, 0x15,
+                                0x95, 0xF4, 0x48, 0x70, 0x1D, 0x49, 0xD6,
+                                0x75}}}}};
+    ComponentInfoMap componentInfoMap{};
+    UpdateManager updateManager;
+    std::filesystem::path packageDir;
+};
+
+TEST_F(UpdateManagerTest, ingestStages)
+{
+    auto badPackage = copyPackage("bad_pkg", 10);
+    auto goodPackage = copyPackage("good_pkg", 1163);
+
+    EXPECT_EQ(updateManager.processPackage(badPackage), 0);
+    EXPECT_EQ(updateManager.processPackage(goodPackage), 0);
+    EXPECT_EQ(updateManager.processPackage(packageDir / "missing_pkg"), -1);
+
+    // Nothing is read till the loop runs the scheduled stage
+    EXPECT_EQ(updateManager.getIngestStage(), IngestStage::Open);
+    EXPECT_TRUE(std::filesystem::exists(badPackage));
+
+    // The truncated package is rejected, the next package is opened
+    runStage();
+    EXPECT_EQ(updateManager.getIngestResult(), -1);
+    EXPECT_FALSE(std::filesystem::exists(badPackage));
+    EXPECT_EQ(updateManager.getIngestStage(), IngestStage::Open);
+
+    runStage();
+    EXPECT_EQ(updateManager.getIngestStage(), IngestStage::Read);
+
+    // The header of the test package fits in a single chunk
+    runStage();
+    EXPECT_EQ(updateManager.getIngestStage(), IngestStage::Parse);
+
+    runStage();
+    EXPECT_EQ(updateManager.getIngestStage(), IngestStage::Activate);
+}
+
+TEST_F(UpdateManagerTest, noManagedDevices)
+{
+    descriptorMap.clear();
+    auto package = copyPackage("good_pkg", 1163);
+
+    EXPECT_EQ(updateManager.processPackage(package), 0);
+    EXPECT_EQ(updateManager.getIngestStage(), std::nullopt);
+}
@@ -2,14 +2,17 @@
 
 #include "activation.hpp"
 #include "common/utils.hpp"
+#include "descriptor_index.hpp"
 #include "package_parser.hpp"
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <string>
 
 PHOSPHOR_LOG2_USING;
@@ -31,6 +34,109 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
         return 0;
     }
 
+    // A package dropped while another one is being activated is rejected
+    if (activation && activation->activation() ==
+                          software::Activation::Activations::Activating)
+    {
+        error(
+            "Activation of PLDM fw update package for version '{VERSION}' already in progress, rejecting '{FILE}'.",
+            "VERSION", parser->pkgVersion, "FILE", packageFilePath.c_str());
+        std::filesystem::remove(packageFilePath);
+        return -1;
+    }
+
+    std::error_code ec;
+    if (!fs::is_regular_file(packageFilePath, ec))
+    {
+        error("PLDM fw update package file '{FILE}' is not a regular file",
+              "FILE", packageFilePath.c_str());
+        return -1;
+    }
+
+    // The packages are ingested one at a time in the order they are dropped
+    packageQueue.emplace_back(packageFilePath);
+    if (packageQueue.size() == 1)
+    {
+        scheduleIngestStage(IngestStage::Open);
+    }
+
+    return 0;
+}
+
+std::optional<IngestStage> UpdateManager::getIngestStage() const
+{
+    if (packageQueue.empty())
+    {
+        return std::nullopt;
+    }
+    return ingestStage;
+}
+
+void UpdateManager::scheduleIngestStage(IngestStage stage)
+{
+    ingestStage = stage;
+    ingestEvent = std::make_unique<sdeventplus::source::Defer>(
+        event, std::bind(std::mem_fn(&UpdateManager::processIngestStage), this,
+                         std::placeholders::_1));
+}
+
+void UpdateManager::processIngestStage(
+    sdeventplus::source::EventBase& /*source*/)
+{
+    ingestEvent.reset();
+
+    const auto& packageFilePath = packageQueue.front();
+    int rc = 0;
+    switch (ingestStage)
+    {
+        case IngestStage::Open:
+            rc = openPackage(packageFilePath);
+            if (!rc)
+            {
+                scheduleIngestStage(IngestStage::Read);
+                return;
+            }
+            break;
+        case IngestStage::Read:
+            rc = readPackageHeader();
+            if (!rc)
+            {
+                scheduleIngestStage(packageHeaderRead < packageHeader.size()
+                                        ? IngestStage::Read
+                                        : IngestStage::Parse);
+                return;
+            }
+            break;
+        case IngestStage::Parse:
+            rc = parsePackage();
+            if (!rc)
+            {
+                scheduleIngestStage(IngestStage::Activate);
+                return;
+            }
+            break;
+        case IngestStage::Activate:
+            rc = createActivation(packageFilePath);
+            break;
+    }
+
+    if (rc)
+    {
+        error("Failed to ingest the PLDM fw update package '{FILE}'", "FILE",
+              packageFilePath.c_str());
+    }
+    ingestResult = rc;
+    packageHeader.clear();
+    packageHeaderRead = 0;
+    packageQueue.pop_front();
+    if (!packageQueue.empty())
+    {
+        scheduleIngestStage(IngestStage::Open);
+    }
+}
+
+int UpdateManager::openPackage(const std::filesystem::path& packageFilePath)
+{
     namespace software = sdbusplus::xyz::openbmc_project::Software::server;
     // If a firmware activation of a package is in progress, don't proceed with
     // package processing
@@ -63,7 +169,7 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
         return -1;
     }
 
-    uintmax_t packageSize = package.tellg();
+    packageSize = package.tellg();
     if (packageSize < sizeof(pldm_package_header_information))
     {
         error(
@@ -76,7 +182,7 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
     }
 
     package.seekg(0);
-    std::vector<uint8_t> packageHeader(sizeof(pldm_package_header_information));
+    packageHeader.resize(sizeof(pldm_package_header_information));
     package.read(reinterpret_cast<char*>(packageHeader.data()),
                  sizeof(pldm_package_header_information));
 
@@ -85,11 +191,19 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
             packageHeader.data());
     auto pkgHeaderInfoSize = sizeof(pldm_package_header_information) +
                              pkgHeaderInfo->package_version_string_length;
-    packageHeader.clear();
     packageHeader.resize(pkgHeaderInfoSize);
-    package.seekg(0);
-    package.read(reinterpret_cast<char*>(packageHeader.data()),
-                 pkgHeaderInfoSize);
+    package.read(reinterpret_cast<char*>(&packageHeader[sizeof(
+                     pldm_package_header_information)]),
+                 pkgHeaderInfoSize - sizeof(pldm_package_header_information));
+    if (!package.good())
+    {
+        error(
+            "Failed to read the PLDM fw update package header information of '{FILE}'",
+            "FILE", packageFilePath.c_str());
+        package.close();
+        std::filesystem::remove(packageFilePath);
+        return -1;
+    }
 
     parser = parsePkgHeader(packageHeader);
     if (parser == nullptr)
@@ -104,12 +218,43 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
     size_t versionHash = std::hash<std::string>{}(parser->pkgVersion);
     objPath = swRootPath + std::to_string(versionHash);
 
-    package.seekg(0);
+    // The rest of the package header is read by the Read stage
+    packageHeaderRead = std::min<size_t>(pkgHeaderInfoSize,
+                                         parser->pkgHeaderSize);
     packageHeader.resize(parser->pkgHeaderSize);
-    package.read(reinterpret_cast<char*>(packageHeader.data()),
-                 parser->pkgHeaderSize);
+    return 0;
+}
+
+int UpdateManager::readPackageHeader()
+{
+    auto length = std::min(ingestChunkSize,
+                           packageHeader.size() - packageHeaderRead);
+    package.read(reinterpret_cast<char*>(packageHeader.data() +
+                                         packageHeaderRead),
+                 length);
+    if (!package.good())
+    {
+        error(
+            "Failed to read the PLDM fw update package header at offset '{OFFSET}'",
+            "OFFSET", packageHeaderRead);
+        activation = std::make_unique<Activation>(
+            pldm::utils::DBusHandler::getBus(), objPath,
+            software::Activation::Activations::Invalid, this);
+        package.close();
+        parser.reset();
+        return -1;
+    }
+
+    packageHeaderRead += length;
+    return 0;
+}
+
+int UpdateManager::parsePackage()
+{
     try
     {
+        // Validates the header checksum and the package size against the
+        // component image information
         parser->parse(packageHeader, packageSize);
     }
     catch (const std::exception& e)
@@ -123,6 +268,12 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
         return -1;
     }
 
+    return 0;
+}
+
+int UpdateManager::createActivation(
+    const std::filesystem::path& packageFilePath)
+{
     auto deviceUpdaterInfos =
         associatePkgToDevices(parser->getFwDeviceIDRecords(), descriptorMap,
                               totalNumComponentUpdates);
@@ -137,7 +288,6 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
         parser.reset();
         return 0;
     }
-
     const auto& fwDeviceIDRecords = parser->getFwDeviceIDRecords();
     const auto& compImageInfos = parser->getComponentImageInfos();
 
@@ -159,7 +309,6 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
         software::Activation::Activations::Ready, this);
     activationProgress = std::make_unique<ActivationProgress>(
         pldm::utils::DBusHandler::getBus(), objPath);
-
     return 0;
 }
 
@@ -169,21 +318,17 @@ DeviceUpdaterInfos UpdateManager::associatePkgToDevices(
     TotalComponentUpdates& totalNumComponentUpdates)
 {
     DeviceUpdaterInfos deviceUpdaterInfos;
+    DescriptorIndex descriptorIndex(descriptorMap);
     for (size_t index = 0; index < fwDeviceIDRecords.size(); ++index)
     {
         const auto& deviceIDDescriptors =
             std::get<Descriptors>(fwDeviceIDRecords[index]);
-        for (const auto& [eid, descriptors] : descriptorMap)
+        for (auto eid : descriptorIndex.match(deviceIDDescriptors))
         {
-            if (std::includes(descriptors.begin(), descriptors.end(),
-                              deviceIDDescriptors.begin(),
-                              deviceIDDescriptors.end()))
-            {
-                deviceUpdaterInfos.emplace_back(std::make_pair(eid, index));
-                const auto& applicableComponents =
-                    std::get<ApplicableComponents>(fwDeviceIDRecords[index]);
-                totalNumComponentUpdates += applicableComponents.size();
-            }
+            deviceUpdaterInfos.emplace_back(std::make_pair(eid, index));
+            const auto& applicableComponents =
+                std::get<ApplicableComponents>(fwDeviceIDRecords[index]);
+            totalNumComponentUpdates += applicableComponents.size();
         }
     }
     return deviceUpdaterInfos;
@@ -9,9 +9,13 @@
 
 #include <libpldm/base.h>
 
+#include <sdeventplus/source/event.hpp>
+
 #include <chrono>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <tuple>
 #include <unordered_map>
 
@@ -33,6 +37,21 @@ using TotalComponentUpdates = size_t;
 class Activation;
 class ActivationProgress;
 
+/** @brief Stages of the ingestion of a firmware update package, each stage
+ *         runs in its own iteration of the event loop
+ */
+enum class IngestStage
+{
+    Open,     //!< Open the package and read the package header information
+    Read,     //!< Read the package header, a chunk per iteration
+    Parse,    //!< Parse and validate the package header
+    Activate, //!< Match the devices and create the activation object
+};
+
+/** @brief Bytes of the package header read per iteration of the event loop
+ */
+constexpr size_t ingestChunkSize = 4096;
+
 class UpdateManager
 {
   public:
@@ -69,8 +88,30 @@ class UpdateManager
     Response handleRequest(mctp_eid_t eid, uint8_t command,
                            const pldm_msg* request, size_t reqMsgLen);
 
+    /** @brief Queue a firmware update package for ingestion
+     *
+     *  @param[in] packageFilePath - path of the package
+     *
+     *  @return 0 if the package is queued or no device is managed, -1 if the
+     *          package is rejected
+     */
     int processPackage(const std::filesystem::path& packageFilePath);
 
+    /** @brief Get the stage the ingestion of the front queued package is at
+     *
+     *  @return the ingestion stage, std::nullopt if no package is queued
+     */
+    std::optional<IngestStage> getIngestStage() const;
+
+    /** @brief Get the result of the last completed ingestion
+     *
+     *  @return 0 if the package was ingested, -1 if it was rejected
+     */
+    int getIngestResult() const
+    {
+        return ingestResult;
+    }
+
     void updateDeviceCompletion(mctp_eid_t eid, bool status);
 
     void updateActivationProgress();
@@ -98,6 +139,49 @@ class UpdateManager
     InstanceIdDb& instanceIdDb; //!< reference to an InstanceIdDb
 
   private:
+    /** @brief Schedule a stage of the ingestion of the package at the front
+     *         of the queue
+     *
+     *  @param[in] stage - ingestion stage
+     */
+    void scheduleIngestStage(IngestStage stage);
+
+    /** @brief Run the scheduled ingestion stage, then schedule the next stage
+     *         or the next queued package
+     *
+     *  @param[in] source - sdeventplus event source
+     */
+    void processIngestStage(sdeventplus::source::EventBase& source);
+
+    /** @brief Open the package and read the package header information
+     *
+     *  @param[in] packageFilePath - path of the package
+     *
+     *  @return 0 on success, -1 if the package is rejected
+     */
+    int openPackage(const std::filesystem::path& packageFilePath);
+
+    /** @brief Read the next chunk of the package header
+     *
+     *  @return 0 on success, -1 if the package can't be read
+     */
+    int readPackageHeader();
+
+    /** @brief Parse and validate the package header
+     *
+     *  @return 0 if the package header is valid, -1 otherwise
+     */
+    int parsePackage();
+
+    /** @brief Associate the package to the devices and create the activation
+     *         object
+     *
+     *  @param[in] packageFilePath - path of the package
+     *
+     *  @return 0
+     */
+    int createActivation(const std::filesystem::path& packageFilePath);
+
     /** @brief Device identifiers of the managed FDs */
     const DescriptorMap& descriptorMap;
     /** @brief Component information needed for the update of the managed FDs */
@@ -112,6 +196,21 @@ class UpdateManager
     std::unique_ptr<PackageParser> parser;
     std::ifstream package;
 
+    /** @brief Packages waiting for ingestion, the front one is in progress */
+    std::deque<std::filesystem::path> packageQueue;
+    /** @brief Event source of the scheduled ingestion stage */
+    std::unique_ptr<sdeventplus::source::Defer> ingestEvent;
+    /** @brief Scheduled ingestion stage */
+    IngestStage ingestStage = IngestStage::Open;
+    /** @brief Size of the package being ingested */
+    uintmax_t packageSize = 0;
+    /** @brief Header of the package being ingested */
+    std::vector<uint8_t> packageHeader;
+    /** @brief Bytes of the package header read so far */
+    size_t packageHeaderRead = 0;
+    /** @brief Result of the last completed ingestion */
+    int ingestResult = 0;
+
     std::unordered_map<mctp_eid_t, std::unique_ptr<DeviceUpdater>>
         deviceUpdaterMap;
     std::unordered_map<mctp_eid_t, bool> deviceUpdateCompletionMap;
@@ -182,6 +182,51 @@ void CustomDBus::setPCIeDeviceProps(const std::string& path, int64_t lanesInuse,
     }
 }
 
+bool CustomDBus::setPCIeDeviceFunction0Props(
+    const std::string& path, const pldm::utils::PropertyMap& properties)
+{
+    auto it = pcieDevice.find(path);
+    if (it == pcieDevice.end())
+    {
+        return false;
+    }
+
+    auto& device = *it->second;
+    for (const auto& [name, value] : properties)
+    {
+        auto propValue = std::get_if<std::string>(&value);
+        if (!propValue)
+        {
+            continue;
+        }
+        if (name == "Function0VendorId")
+        {
+            device.function0VendorId(*propValue);
+        }
+        else if (name == "Function0DeviceId")
+        {
+            device.function0DeviceId(*propValue);
+        }
+        else if (name == "Function0RevisionId")
+        {
+            device.function0RevisionId(*propValue);
+        }
+        else if (name == "Function0ClassCode")
+        {
+            device.function0ClassCode(*propValue);
+        }
+        else if (name == "Function0SubsystemVendorId")
+        {
+            device.function0SubsystemVendorId(*propValue);
+        }
+        else if (name == "Function0SubsystemId")
+        {
+            device.function0SubsystemId(*propValue);
+        }
+    }
+    return true;
+}
+
 void CustomDBus::setCableAttributes(const std::string& path, double length,
                                     const std::string& cableDescription,
                                     const std::string& /*status*/)
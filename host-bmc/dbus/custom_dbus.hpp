@@ -366,6 +366,16 @@ class CustomDBus
     void setPCIeDeviceProps(const std::string& path, int64_t lanesInuse,
                             const std::string& value);
 
+    /** @brief Set the function 0 properties of a PCIe device hosted by pldm
+     *
+     *  @param[in] path - PCIe device D-Bus object path
+     *  @param[in] properties - function 0 properties by property name
+     *
+     *  @return false if pldm doesn't host the PCIe device
+     */
+    bool setPCIeDeviceFunction0Props(
+        const std::string& path, const pldm::utils::PropertyMap& properties);
+
     /** @brief set cable attributes */
     void setCableAttributes(const std::string& path, double length,
                             const std::string& cableDescription,
@@ -124,9 +124,6 @@ void HostEffecterParser::processHostEffecterChangeNotification(
     const DbusChgHostEffecterProps& chProperties, size_t effecterInfoIndex,
     size_t dbusInfoIndex, uint16_t effecterId)
 {
-    using BootProgress =
-        sdbusplus::client::xyz::openbmc_project::state::boot::Progress<>;
-
     const auto& propertyName = hostEffecterInfo[effecterInfoIndex]
                                    .dbusInfo[dbusInfoIndex]
                                    .dbusMap.propertyName;
@@ -140,15 +137,7 @@ void HostEffecterParser::processHostEffecterChangeNotification(
 
     if (effecterId == PLDM_INVALID_EFFECTER_ID)
     {
-        constexpr auto localOrRemote = false;
-        effecterId = findStateEffecterId(
-            pdrRepo, hostEffecterInfo[effecterInfoIndex].entityType,
-            hostEffecterInfo[effecterInfoIndex].entityInstance,
-            hostEffecterInfo[effecterInfoIndex].containerId,
-            hostEffecterInfo[effecterInfoIndex]
-                .dbusInfo[dbusInfoIndex]
-                .state.stateSetId,
-            localOrRemote);
+        effecterId = findHostEffecterId(effecterInfoIndex, dbusInfoIndex);
         if (effecterId == PLDM_INVALID_EFFECTER_ID)
         {
             error(
@@ -161,6 +150,62 @@ void HostEffecterParser::processHostEffecterChangeNotification(
             return;
         }
     }
+
+    uint8_t newState{};
+    try
+    {
+        newState = findNewStateValue(effecterInfoIndex, dbusInfoIndex,
+                                     it->second);
+    }
+    catch (const std::out_of_range& e)
+    {
+        error("Failed to find new state '{NEW_STATE}' in json, error - {ERROR}",
+              "ERROR", e, "NEW_STATE", newState);
+        return;
+    }
+
+    // Gather the composite states of the effecter changed within the
+    // batching window, a later change of the same state replaces the earlier
+    // one so the host never sees the intermediate state.
+    auto [pending, inserted] = pendingEffecterStates.try_emplace(
+        effecterId, PendingEffecterStates{effecterInfoIndex, {}});
+    if (inserted)
+    {
+        pending->second.stateField.assign(
+            hostEffecterInfo[effecterInfoIndex].compEffecterCnt,
+            {PLDM_NO_CHANGE, 0});
+    }
+    if (dbusInfoIndex < pending->second.stateField.size())
+    {
+        pending->second.stateField[dbusInfoIndex] = {PLDM_REQUEST_SET,
+                                                     newState};
+    }
+
+    if (!batchTimer)
+    {
+        batchTimer = std::make_unique<sdbusplus::Timer>(
+            [this]() { flushPendingEffecterStates(); });
+    }
+    if (!batchTimer->isRunning())
+    {
+        batchTimer->start(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                effecterBatchWindow));
+    }
+}
+
+void HostEffecterParser::flushPendingEffecterStates()
+{
+    using BootProgress =
+        sdbusplus::client::xyz::openbmc_project::state::boot::Progress<>;
+
+    auto pendingStates = std::move(pendingEffecterStates);
+    pendingEffecterStates.clear();
+    if (pendingStates.empty())
+    {
+        return;
+    }
+
     constexpr auto hostStatePath = "/xyz/openbmc_project/state/host0";
 
     try
@@ -189,50 +234,57 @@ void HostEffecterParser::processHostEffecterChangeNotification(
             "Error in getting current remote terminus state. Will still continue to set the remote terminus effecter, error - {ERROR}",
             "ERROR", e);
     }
-    uint8_t newState{};
-    try
-    {
-        newState = findNewStateValue(effecterInfoIndex, dbusInfoIndex,
-                                     it->second);
-    }
-    catch (const std::out_of_range& e)
-    {
-        error("Failed to find new state '{NEW_STATE}' in json, error - {ERROR}",
-              "ERROR", e, "NEW_STATE", newState);
-        return;
-    }
 
-    std::vector<set_effecter_state_field> stateField;
-    for (uint8_t i = 0; i < hostEffecterInfo[effecterInfoIndex].compEffecterCnt;
-         i++)
+    for (auto& [effecterId, pending] : pendingStates)
     {
-        if (i == dbusInfoIndex)
+        int rc{};
+        try
         {
-            stateField.push_back({PLDM_REQUEST_SET, newState});
+            rc = setHostStateEffecter(pending.effecterInfoIndex,
+                                      pending.stateField, effecterId);
         }
-        else
+        catch (const std::runtime_error& e)
         {
-            stateField.push_back({PLDM_NO_CHANGE, 0});
+            error(
+                "Failed to set remote terminus state effecter for effecter ID '{EFFECTERID}', error - {ERROR}",
+                "ERROR", e, "EFFECTERID", effecterId);
+            continue;
+        }
+        if (rc != PLDM_SUCCESS)
+        {
+            error(
+                "Failed to set the remote terminus state effecter for effecter ID '{EFFECTERID}', response code '{RC}'",
+                "EFFECTERID", effecterId, "RC", rc);
         }
     }
-    int rc{};
-    try
-    {
-        rc = setHostStateEffecter(effecterInfoIndex, stateField, effecterId);
-    }
-    catch (const std::runtime_error& e)
+}
+
+void HostEffecterParser::clearEffecterIdCache()
+{
+    effecterIdCache.clear();
+}
+
+uint16_t HostEffecterParser::findHostEffecterId(size_t effecterInfoIndex,
+                                                size_t dbusInfoIndex)
+{
+    auto key = std::make_pair(effecterInfoIndex, dbusInfoIndex);
+    if (auto it = effecterIdCache.find(key); it != effecterIdCache.end())
     {
-        error(
-            "Failed to set remote terminus state effecter for effecter ID '{EFFECTERID}', error - {ERROR}",
-            "ERROR", e, "EFFECTERID", effecterId);
-        return;
+        return it->second;
     }
-    if (rc != PLDM_SUCCESS)
+
+    constexpr auto localOrRemote = false;
+    const auto& effecterInfo = hostEffecterInfo[effecterInfoIndex];
+    auto effecterId = findStateEffecterId(
+        pdrRepo, effecterInfo.entityType, effecterInfo.entityInstance,
+        effecterInfo.containerId,
+        effecterInfo.dbusInfo[dbusInfoIndex].state.stateSetId, localOrRemote);
+    if (effecterId != PLDM_INVALID_EFFECTER_ID)
     {
-        error(
-            "Failed to set the remote terminus state effecter for effecter ID '{EFFECTERID}', response code '{RC}'",
-            "EFFECTERID", effecterId, "RC", rc);
+        effecterIdCache.emplace(key, effecterId);
     }
+
+    return effecterId;
 }
 
 uint8_t
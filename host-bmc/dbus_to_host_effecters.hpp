@@ -7,7 +7,10 @@
 #include "requester/handler.hpp"
 
 #include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/timer.hpp>
 
+#include <chrono>
+#include <map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -58,6 +61,20 @@ struct EffecterInfo
         dbusInfo;            //!< D-Bus information for the effecter id
 };
 
+/** @struct PendingEffecterStates
+ *  Composite states of an effecter gathered within the batching window
+ */
+struct PendingEffecterStates
+{
+    size_t effecterInfoIndex; //!< Index of effecterInfo in hostEffecterInfo
+    std::vector<set_effecter_state_field> stateField; //!< Composite states
+};
+
+/** @brief Window in which D-Bus property changes of host effecters are
+ *         coalesced into a single SetStateEffecterStates per effecter ID
+ */
+constexpr auto effecterBatchWindow = std::chrono::milliseconds(20);
+
 /** @class HostEffecterParser
  *
  *  @brief This class parses the Host Effecter json file and monitors for the
@@ -176,6 +193,26 @@ class HostEffecterParser
     /* @brief Returns the PDR repository */
     const pldm_pdr* getPldmPDR();
 
+    /* @brief Drops the cached effecter IDs, called when remote PDRs are
+     *        merged into or removed from the PDR repository
+     */
+    void clearEffecterIdCache();
+
+    /* @brief Finds the effecter ID of a host effecter in the PDR repository,
+     *        the result is cached till clearEffecterIdCache is called
+     *
+     * @param[in] effecterInfoIndex - index of effecterInfo in hostEffecterInfo
+     * @param[in] dbusInfoIndex - index of dbusInfo within effecterInfo
+     * @return - effecter ID, PLDM_INVALID_EFFECTER_ID if not found
+     */
+    uint16_t findHostEffecterId(size_t effecterInfoIndex,
+                                size_t dbusInfoIndex);
+
+    /* @brief Sends the composite states gathered within the batching window,
+     *        one SetStateEffecterStates per effecter ID
+     */
+    void flushPendingEffecterStates();
+
     /* @brief Sends the SetStateEffecterStates request
      * object
      *
@@ -202,6 +239,14 @@ class HostEffecterParser
     const pldm::utils::DBusHandler* dbusHandler; //!< D-bus Handler
     /** @brief PLDM request handler */
     pldm::requester::Handler<pldm::requester::Request>* handler;
+    /** @brief Composite states waiting to be sent, keyed by effecter ID */
+    std::map<uint16_t, PendingEffecterStates> pendingEffecterStates;
+    /** @brief Timer closing the batching window */
+    std::unique_ptr<sdbusplus::Timer> batchTimer;
+    /** @brief Effecter IDs found in the PDR repository, keyed by the
+     *         effecterInfo and dbusInfo indices
+     */
+    std::map<std::pair<size_t, size_t>, uint16_t> effecterIdCache;
 };
 
 } // namespace host_effecters
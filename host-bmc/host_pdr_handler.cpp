@@ -2,6 +2,7 @@
 
 #include <libpldm/fru.h>
 #include <libpldm/pdr.h>
+#include <libpldm/utils.h>
 
 #ifdef OEM_IBM
 #include <libpldm/oem/ibm/fru.h>
@@ -10,6 +11,7 @@
 #include "dbus/custom_dbus.hpp"
 #include "dbus/deserialize.hpp"
 #include "dbus/serialize.hpp"
+#include "libpldmresponder/sensor_event_emitter.hpp"
 
 #include <assert.h>
 
@@ -61,11 +63,11 @@ uint16_t extractTerminusHandle(std::vector<uint8_t>& pdr)
 }
 
 template <typename T>
-void updateContainerId(pldm_entity_association_tree* entityTree,
+void updateContainerId(EntityAssociationTree& entityTree,
                        std::vector<uint8_t>& pdr)
 {
     T* t = nullptr;
-    if (entityTree == nullptr)
+    if (entityTree.get() == nullptr)
     {
         return;
     }
@@ -83,8 +85,7 @@ void updateContainerId(pldm_entity_association_tree* entityTree,
     }
 
     pldm_entity entity{t->entity_type, t->entity_instance, t->container_id};
-    auto node = pldm_entity_association_tree_find_with_locality(entityTree,
-                                                                &entity, true);
+    auto node = entityTree.find(entity, true);
     if (node)
     {
         pldm_entity e = pldm_entity_extract(node);
@@ -92,6 +93,33 @@ void updateContainerId(pldm_entity_association_tree* entityTree,
     }
 }
 
+/** @brief Remove the copies of a PDR from a list of host PDRs
+ *
+ *  @param[in] pdrs - list of host PDRs
+ *  @param[in] recordHandle - record handle of the PDR
+ */
+void removePDR(PDRList& pdrs, uint32_t recordHandle)
+{
+    std::erase_if(pdrs, [recordHandle](const auto& pdr) {
+        return reinterpret_cast<const pldm_pdr_hdr*>(pdr.data())
+                   ->record_handle == recordHandle;
+    });
+}
+
+/** @brief Remove the copies of a batch of PDRs from a list of host PDRs
+ *
+ *  @param[in] pdrs - list of host PDRs
+ *  @param[in] recordHandles - record handles of the PDRs
+ */
+void removePDR(PDRList& pdrs,
+               const std::unordered_set<uint32_t>& recordHandles)
+{
+    std::erase_if(pdrs, [&recordHandles](const auto& pdr) {
+        return recordHandles.contains(
+            reinterpret_cast<const pldm_pdr_hdr*>(pdr.data())->record_handle);
+    });
+}
+
 HostPDRHandler::HostPDRHandler(
     int mctp_fd, uint8_t mctp_eid, sdeventplus::Event& event, pldm_pdr* repo,
     const std::string& eventsJsonsDir, pldm_entity_association_tree* entityTree,
@@ -105,12 +133,14 @@ HostPDRHandler::HostPDRHandler(
     mctp_fd(mctp_fd),
     mctp_eid(mctp_eid), event(event), repo(repo),
     stateSensorHandler(eventsJsonsDir), entityTree(entityTree),
-    bmcEntityTree(bmcEntityTree), hostEffecterParser(hostEffecterParser),
+    bmcEntityTree(bmcEntityTree), entityTreeIndex(entityTree),
+    hostEffecterParser(hostEffecterParser),
     instanceIdDb(instanceIdDb), handler(handler),
     associationsParser(associationsParser),
     oemPlatformHandler(oemPlatformHandler),
     entityMaps(parseEntityMap(ENTITY_MAP_JSON)),
-    oemUtilsHandler(oemUtilsHandler)
+    oemUtilsHandler(oemUtilsHandler),
+    mergedAssociations(repo, entityTreeIndex, entityAssociations, objPathMap)
 {
     isHostOff = false;
     isHostTransitioningToOff = false;
@@ -119,7 +149,7 @@ HostPDRHandler::HostPDRHandler(
         pldm::utils::DBusHandler::getBus(),
         propertiesChanged("/xyz/openbmc_project/state/host0",
                           "xyz.openbmc_project.State.Host"),
-        [this, repo, entityTree, bmcEntityTree](sdbusplus::message_t& msg) {
+        [this, repo, bmcEntityTree](sdbusplus::message_t& msg) {
         DbusChangedProps props{};
         std::string intf;
         msg.read(intf, props);
@@ -139,9 +169,13 @@ HostPDRHandler::HostPDRHandler(
                 // state of all the dbus objects to false
                 this->setPresenceFrus();
                 pldm_pdr_remove_remote_pdrs(repo);
-                pldm_entity_association_tree_destroy_root(entityTree);
-                pldm_entity_association_tree_copy_root(bmcEntityTree,
-                                                       entityTree);
+                hostPDRSignatures.clear();
+                staleRecordHandles.reset();
+                mergedAssociations.clear();
+                repoModified(repo);
+                clearEffecterIdCache();
+                entityTreeIndex.reset(bmcEntityTree);
+                entityPathResolver.clear();
                 this->sensorMap.clear();
                 this->isHostPdrModified = false;
                 this->responseReceived = false;
@@ -352,63 +386,52 @@ void HostPDRHandler::mergeEntityAssociations(
     bool merged = false;
     auto entityPdr = reinterpret_cast<pldm_pdr_entity_association*>(
         const_cast<uint8_t*>(pdr.data()) + sizeof(pldm_pdr_hdr));
+    pldm::utils::Entities mergedEntities;
+    std::vector<uint32_t> bmcRecordHandles;
+
+    // A changed PDR replaces what it was merged as
+    unmergeEntityAssociations(record_handle);
 
     if (oemPlatformHandler &&
         oemPlatformHandler->checkRecordHandleInRange(record_handle))
     {
         // Adding the remote range PDRs to the repo before merging it
         uint32_t handle = record_handle;
-        pldm_pdr_add_check(repo, pdr.data(), size, true, 0xFFFF, &handle);
+        if (!pldm_pdr_add_check(repo, pdr.data(), size, true, 0xFFFF,
+                                &handle))
+        {
+            bmcRecordHandles.emplace_back(handle);
+        }
     }
 
     pldm_entity_association_pdr_extract(pdr.data(), pdr.size(), &numEntities,
                                         &entities);
     if (numEntities > 0)
     {
-        pldm_entity_node* pNode = nullptr;
-        if (!mergedHostParents)
-        {
-            pNode = pldm_entity_association_tree_find_with_locality(
-                entityTree, &entities[0], false);
-        }
-        else
-        {
-            pNode = pldm_entity_association_tree_find_with_locality(
-                entityTree, &entities[0], true);
-        }
-        if (!pNode)
+        auto entityAssoc = entityTreeIndex.mergeRemoteAssociation(
+            entities, numEntities, entityPdr->association_type,
+            mergedHostParents);
+        if (entityAssoc.empty())
         {
+            mergedAssociations.add(record_handle, mergedEntities,
+                                   std::move(bmcRecordHandles));
+            free(entities);
             return;
         }
 
-        Entities entityAssoc;
-        entityAssoc.push_back(pNode);
-        for (size_t i = 1; i < numEntities; ++i)
-        {
-            auto node = pldm_entity_association_tree_add_entity(
-                entityTree, &entities[i], entities[i].entity_instance_num,
-                pNode, entityPdr->association_type, true,
-                !(entities[i].entity_container_id & 0x8000), 0xFFFF);
-            if (!node)
-            {
-                continue;
-            }
-            merged = true;
-            entityAssoc.push_back(node);
-        }
-
         mergedHostParents = true;
-        if (merged)
+        if (entityAssoc.size() > 1)
         {
-            entityAssociations.push_back(entityAssoc);
+            merged = true;
+            mergedEntities = entityAssoc;
+            entityAssociations.emplace_back(std::move(entityAssoc));
         }
     }
 
     if (merged)
     {
         // Update our PDR repo with the merged entity association PDRs
-        pldm_entity_node* node = nullptr;
-        pldm_find_entity_ref_in_tree(entityTree, entities[0], &node);
+        auto node = entityTreeIndex.find(entities[0], false);
         if (node == nullptr)
         {
             error("Failed to find referrence of the entity in the tree");
@@ -443,6 +466,16 @@ void HostPDRHandler::mergeEntityAssociations(
                     error("Failed to add entity association PDR from node:{RC}",
                           "RC", rc);
                 }
+                else
+                {
+                    auto last = pldm_pdr_get_record_handle(
+                        repo, oemPlatformHandler->fetchLastBMCRecord(repo));
+                    for (auto handle = record_handle + 1; handle <= last;
+                         ++handle)
+                    {
+                        bmcRecordHandles.emplace_back(handle);
+                    }
+                }
             }
             else
             {
@@ -459,9 +492,21 @@ void HostPDRHandler::mergeEntityAssociations(
                     error("Failed to add entity association PDR from node:{RC}",
                           "RC", rc);
                 }
+                else
+                {
+                    auto last = pldm_pdr_get_record_handle(
+                        repo, oemPlatformHandler->fetchLastBMCRecord(repo));
+                    for (auto handle = record_handle + 1; handle <= last;
+                         ++handle)
+                    {
+                        bmcRecordHandles.emplace_back(handle);
+                    }
+                }
             }
         }
     }
+    mergedAssociations.add(record_handle, mergedEntities,
+                           std::move(bmcRecordHandles));
     free(entities);
 }
 
@@ -608,7 +653,7 @@ void HostPDRHandler::parseStateSensorPDRs()
             error("Terminus handle out of range {HAN}", "HAN", terminusHandle);
             sensorEntry.terminusID = PLDM_TID_RESERVED;
         }
-        sensorMap.emplace(sensorEntry, std::move(sensorInfo));
+        sensorMap.insert_or_assign(sensorEntry, sensorInfo);
     }
 }
 
@@ -690,7 +735,12 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
                 rh = pdrHdr->record_handle;
             }
 
-            if (pdrHdr->type == PLDM_PDR_ENTITY_ASSOCIATION)
+            if (!updatePDRSignature(rh, pdr))
+            {
+                // Unchanged since the last fetch, the repository and the
+                // D-Bus objects already reflect it
+            }
+            else if (pdrHdr->type == PLDM_PDR_ENTITY_ASSOCIATION)
             {
                 this->mergeEntityAssociations(pdr, respCount, rh);
                 merged = true;
@@ -730,21 +780,32 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
                 {
                     pdrTerminusHandle =
                         extractTerminusHandle<pldm_state_sensor_pdr>(pdr);
-                    updateContainerId<pldm_state_sensor_pdr>(entityTree, pdr);
+                    updateContainerId<pldm_state_sensor_pdr>(entityTreeIndex,
+                                                             pdr);
+                    if (staleRecordHandles)
+                    {
+                        removePDR(stateSensorPDRs, pdrHdr->record_handle);
+                    }
                     stateSensorPDRs.emplace_back(pdr);
                 }
                 else if (pdrHdr->type == PLDM_PDR_FRU_RECORD_SET)
                 {
                     pdrTerminusHandle =
                         extractTerminusHandle<pldm_pdr_fru_record_set>(pdr);
-                    updateContainerId<pldm_pdr_fru_record_set>(entityTree, pdr);
+                    updateContainerId<pldm_pdr_fru_record_set>(entityTreeIndex,
+                                                               pdr);
+                    if (staleRecordHandles)
+                    {
+                        removePDR(fruRecordSetPDRs, pdrHdr->record_handle);
+                    }
                     fruRecordSetPDRs.emplace_back(pdr);
                 }
                 else if (pdrHdr->type == PLDM_STATE_EFFECTER_PDR)
                 {
                     pdrTerminusHandle =
                         extractTerminusHandle<pldm_state_effecter_pdr>(pdr);
-                    updateContainerId<pldm_state_effecter_pdr>(entityTree, pdr);
+                    updateContainerId<pldm_state_effecter_pdr>(entityTreeIndex,
+                                                               pdr);
                 }
                 else if (pdrHdr->type == PLDM_NUMERIC_EFFECTER_PDR)
                 {
@@ -752,7 +813,7 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
                         extractTerminusHandle<pldm_numeric_effecter_value_pdr>(
                             pdr);
                     updateContainerId<pldm_numeric_effecter_value_pdr>(
-                        entityTree, pdr);
+                        entityTreeIndex, pdr);
                 }
                 // if the TLPDR is invalid update the repo accordingly
                 if (!tlValid)
@@ -841,6 +902,8 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
                     }
                 }
             }
+            repoModified(repo);
+            clearEffecterIdCache();
         }
     }
     if (!nextRecordHandle)
@@ -863,8 +926,14 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
                 "VALID", std::get<2>(terminusInfo));
         }
 
+        if (staleRecordHandles)
+        {
+            deleteStalePDRs();
+        }
+
         updateEntityAssociation(entityAssociations, entityTree, objPathMap,
-                                entityMaps, oemPlatformHandler);
+                                entityMaps, oemPlatformHandler,
+                                &entityPathResolver);
         pldm::serialize::Serialize::getSerialize().setObjectPathMaps(
             objPathMap);
         if (oemUtilsHandler)
@@ -1093,15 +1162,16 @@ void HostPDRHandler::_setHostSensorState()
                     uint8_t eventState;
                     uint8_t previousEventState;
                     uint8_t sensorOffset = comp_sensor_count - 1;
+                    auto& emitter = pldm::responder::StateSensorEventEmitter::
+                        GetInstance();
 
                     for (size_t i = 0; i < comp_sensor_count; i++)
                     {
                         eventState = stateField[i].present_state;
                         previousEventState = stateField[i].previous_state;
 
-                        emitStateSensorEventSignal(tid, sensorId, sensorOffset,
-                                                   eventState,
-                                                   previousEventState);
+                        emitter.emit({tid, sensorId, sensorOffset, eventState,
+                                      previousEventState});
 
                         SensorEntry sensorEntry{tid, sensorId};
 
@@ -1852,32 +1922,54 @@ std::string HostPDRHandler::getParentChassis(const std::string& frupath)
     return "";
 }
 
-void HostPDRHandler::setRecordPresent(uint32_t recordHandle)
+void HostPDRHandler::setFrusNotPresent(const PDRList& pdrs)
 {
-    pldm_entity recordEntity = pldm_get_entity_from_record_handle(repo,
-                                                                  recordHandle);
+    auto entityKey = [](uint16_t type, uint16_t instance, uint16_t container) {
+        return (static_cast<uint64_t>(type) << 32) |
+               (static_cast<uint64_t>(instance) << 16) | container;
+    };
+
+    std::unordered_set<uint64_t> entities;
+    for (const auto& pdr : pdrs)
+    {
+        if (pdr.size() <
+                sizeof(pldm_pdr_hdr) + sizeof(pldm_pdr_fru_record_set) ||
+            reinterpret_cast<const pldm_pdr_hdr*>(pdr.data())->type !=
+                PLDM_PDR_FRU_RECORD_SET)
+        {
+            continue;
+        }
+        auto fru = reinterpret_cast<const pldm_pdr_fru_record_set*>(
+            pdr.data() + sizeof(pldm_pdr_hdr));
+        entities.emplace(entityKey(fru->entity_type, fru->entity_instance,
+                                   fru->container_id));
+    }
+    if (entities.empty())
+    {
+        return;
+    }
+
     for (const auto& [path, dbusEntity] : objPathMap)
     {
-        if (dbusEntity.entity_type == recordEntity.entity_type &&
-            dbusEntity.entity_instance_num ==
-                recordEntity.entity_instance_num &&
-            dbusEntity.entity_container_id == recordEntity.entity_container_id)
+        if (!entities.contains(entityKey(dbusEntity.entity_type,
+                                         dbusEntity.entity_instance_num,
+                                         dbusEntity.entity_container_id)))
         {
-            error(
-                "Removing Host FRU [ {PATH} ] with entityid [ {ENTITY_TYP}, {ENTITY_NUM}, {ENTITY_ID} ]",
-                "PATH", path, "ENTITY_TYP", (unsigned)recordEntity.entity_type,
-                "ENTITY_NUM", (unsigned)recordEntity.entity_instance_num,
-                "ENTITY_ID", (unsigned)recordEntity.entity_container_id);
-            // if the record has the same entity id, mark that dbus object as
-            // not present
-            CustomDBus::getCustomDBus().updateItemPresentStatus(path, false);
-            CustomDBus::getCustomDBus().setOperationalStatus(
-                path, false, getParentChassis(path));
-            // Delete the LED object path
-            auto ledGroupPath = updateLedGroupPath(path);
-            pldm::dbus::CustomDBus::getCustomDBus().deleteObject(ledGroupPath);
-            return;
+            continue;
         }
+        error(
+            "Removing Host FRU [ {PATH} ] with entityid [ {ENTITY_TYP}, {ENTITY_NUM}, {ENTITY_ID} ]",
+            "PATH", path, "ENTITY_TYP", (unsigned)dbusEntity.entity_type,
+            "ENTITY_NUM", (unsigned)dbusEntity.entity_instance_num,
+            "ENTITY_ID", (unsigned)dbusEntity.entity_container_id);
+        // if the record has the same entity id, mark that dbus object as
+        // not present
+        CustomDBus::getCustomDBus().updateItemPresentStatus(path, false);
+        CustomDBus::getCustomDBus().setOperationalStatus(
+            path, false, getParentChassis(path));
+        // Delete the LED object path
+        auto ledGroupPath = updateLedGroupPath(path);
+        pldm::dbus::CustomDBus::getCustomDBus().deleteObject(ledGroupPath);
     }
 }
 
@@ -1900,9 +1992,103 @@ void HostPDRHandler::deletePDRFromRepo(PDRRecordHandles&& recordHandles)
     {
         error("Record handle deleted: {REC_HANDLE}", "REC_HANDLE",
               recordHandle);
-        this->setRecordPresent(recordHandle);
-        pldm_delete_by_record_handle(repo, recordHandle, true);
     }
+    deletePDRs(std::unordered_set<uint32_t>(recordHandles.begin(),
+                                            recordHandles.end()));
+}
+
+void HostPDRHandler::refreshPDR(uint8_t tid)
+{
+    staleRecordHandles.emplace();
+    staleRecordHandles->reserve(hostPDRSignatures.size());
+    for (const auto& [recordHandle, signature] : hostPDRSignatures)
+    {
+        staleRecordHandles->emplace(recordHandle);
+    }
+    fetchPDR(PDRRecordHandles{}, tid);
+}
+
+bool HostPDRHandler::updatePDRSignature(uint32_t recordHandle,
+                                        const std::vector<uint8_t>& pdr)
+{
+    auto signature = crc32(pdr.data(), pdr.size());
+    auto unchanged = false;
+    if (staleRecordHandles)
+    {
+        staleRecordHandles->erase(recordHandle);
+        auto search = hostPDRSignatures.find(recordHandle);
+        unchanged = search != hostPDRSignatures.end() &&
+                    search->second == signature;
+    }
+    hostPDRSignatures.insert_or_assign(recordHandle, signature);
+    return !unchanged;
+}
+
+void HostPDRHandler::deletePDRs(
+    const std::unordered_set<uint32_t>& recordHandles)
+{
+    if (recordHandles.empty())
+    {
+        return;
+    }
+
+    auto removed = removeRemotePDRs(
+        repo, [&recordHandles](RecordHandle recordHandle,
+                               pdr::TerminusHandle /*terminusHandle*/) {
+        return recordHandles.contains(recordHandle);
+    });
+    setFrusNotPresent(removed);
+    for (auto recordHandle : recordHandles)
+    {
+        unmergeEntityAssociations(recordHandle);
+        hostPDRSignatures.erase(recordHandle);
+    }
+    clearEffecterIdCache();
+}
+
+void HostPDRHandler::unmergeEntityAssociations(uint32_t recordHandle)
+{
+    auto removed = mergedAssociations.remove(recordHandle);
+    if (!removed.empty())
+    {
+        // The paths resolved through the deleted nodes are stale
+        entityPathResolver.clear();
+    }
+    for (auto handle : removed)
+    {
+        if (handle != recordHandle)
+        {
+            info(
+                "Entity association PDR '{REC_HANDLE}' is merged again once fetched, its container is gone",
+                "REC_HANDLE", handle);
+            hostPDRSignatures.erase(handle);
+        }
+    }
+}
+
+void HostPDRHandler::clearEffecterIdCache()
+{
+    if (hostEffecterParser)
+    {
+        hostEffecterParser->clearEffecterIdCache();
+    }
+}
+
+void HostPDRHandler::deleteStalePDRs()
+{
+    for (auto recordHandle : *staleRecordHandles)
+    {
+        info("Record handle '{REC_HANDLE}' is gone from the host repository",
+             "REC_HANDLE", recordHandle);
+    }
+    deletePDRs(*staleRecordHandles);
+    removePDR(stateSensorPDRs, *staleRecordHandles);
+    removePDR(fruRecordSetPDRs, *staleRecordHandles);
+    staleRecordHandles.reset();
+
+    // Drop the sensors of the deleted PDRs, the state sensor PDRs are parsed
+    // again at the end of the PDR exchange
+    sensorMap.clear();
 }
 
 } // namespace pldm
@@ -5,6 +5,8 @@
 #include "common/utils.hpp"
 #include "dbus_to_host_effecters.hpp"
 #include "host_associations_parser.hpp"
+#include "merged_associations.hpp"
+#include "libpldmresponder/entity_association_tree.hpp"
 #include "libpldmresponder/event_parser.hpp"
 #include "libpldmresponder/oem_handler.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
@@ -21,6 +23,9 @@
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace pldm
@@ -112,6 +117,15 @@ class HostPDRHandler
 
     void deletePDRFromRepo(PDRRecordHandles&& recordHandles);
 
+    /** @brief Refresh the host PDRs on a refresh entire repository event.
+     *  The host repository is walked and compared record by record against
+     *  the signatures of the PDRs fetched so far: only the added and changed
+     *  records are processed and the records the host no longer reports are
+     *  deleted, the others are left in place along with their D-Bus objects.
+     *  @param[in] tid - terminus ID of the host firmware
+     */
+    void refreshPDR(uint8_t tid);
+
     /** @brief Send a PLDM event to host firmware containing a list of record
      *  handles of PDRs that the host firmware has to fetch.
      *  @param[in] pdrTypes - list of PDR types that need to be looked up in the
@@ -254,6 +268,41 @@ class HostPDRHandler
     void _processFetchPDREvent(uint32_t nextRecordHandle,
                                sdeventplus::source::EventBase& source);
 
+    /** @brief Record the signature of a PDR fetched from the host
+     *  @param[in] recordHandle - record handle of the PDR
+     *  @param[in] pdr - PDR as received from the host
+     *  @return false if a refresh of the host repository is ongoing and the
+     *          PDR is unchanged since it was last fetched, true otherwise
+     */
+    bool updatePDRSignature(uint32_t recordHandle,
+                            const std::vector<uint8_t>& pdr);
+
+    /** @brief Delete a batch of host PDRs from the BMC repository in a
+     *  single pass and mark the frus of the deleted FRU record set PDRs as
+     *  not present
+     *  @param[in] recordHandles - record handles of the PDRs
+     */
+    void deletePDRs(const std::unordered_set<uint32_t>& recordHandles);
+
+    /** @brief Take out what the merge of a host entity association PDR
+     *  added to the BMC's repository and entity association tree
+     *  @details The merges under the entities of the PDR are taken out too,
+     *  their signatures are dropped so that they are merged again when they
+     *  are fetched next.
+     *  @param[in] recordHandle - host record handle of the PDR
+     */
+    void unmergeEntityAssociations(uint32_t recordHandle);
+
+    /** @brief Drop the host effecter IDs cached by the host effecter parser,
+     *  they are looked up again from the updated repository
+     */
+    void clearEffecterIdCache();
+
+    /** @brief Delete the host PDRs the refresh of the host repository didn't
+     *  come across, and end the refresh
+     */
+    void deleteStalePDRs();
+
     /** @brief Get FRU record table metadata by remote PLDM terminus
      *
      *  @param[out] uint16_t    - total table records
@@ -344,10 +393,11 @@ class HostPDRHandler
      */
     std::string updateLedGroupPath(const std::string& path);
 
-    /** @brief set the presence of the fru from record handle
-     *  @param[in] recorHandle - record handle of the PDR
+    /** @brief mark the frus of FRU record set PDRs as not present
+     *  @param[in] pdrs - PDRs, the ones other than FRU record set PDRs are
+     *                    skipped
      */
-    void setRecordPresent(uint32_t recorHandle);
+    void setFrusNotPresent(const PDRList& pdrs);
 
     /** @brief Get FRU Record Set Identifier from FRU Record data Format
      *  @param[in] fruRecordSetPDRs - fru record set pdr
@@ -380,6 +430,9 @@ class HostPDRHandler
     /** @brief Pointer to BMC's entity association tree */
     pldm_entity_association_tree* bmcEntityTree;
 
+    /** @brief Hash indexed view of entityTree used while merging host PDRs */
+    pldm::responder::pdr_utils::EntityAssociationTree entityTreeIndex;
+
     /** @brief Pointer to host effecter parser */
     pldm::host_effecters::HostEffecterParser* hostEffecterParser;
 
@@ -407,6 +460,16 @@ class HostPDRHandler
     /** @brief list of PDR record handles modified pointing to host PDRs */
     PDRRecordHandles modifiedPDRRecordHandles;
 
+    /** @brief CRC32 of the host PDRs as last fetched, keyed by record handle
+     */
+    std::unordered_map<uint32_t, uint32_t> hostPDRSignatures;
+
+    /** @brief record handles of the host PDRs the ongoing refresh of the host
+     *  repository didn't come across yet, std::nullopt when no refresh is
+     *  ongoing
+     */
+    std::optional<std::unordered_set<uint32_t>> staleRecordHandles;
+
     /** @brief D-Bus property changed signal match */
     std::unique_ptr<sdbusplus::bus::match_t> hostOffMatch;
 
@@ -446,9 +509,19 @@ class HostPDRHandler
      */
     pldm::utils::EntityMaps entityMaps;
 
+    /** @brief object paths of the entities resolved so far, kept across the
+     *         PDR exchanges until the host is powered off
+     */
+    pldm::hostbmc::utils::EntityPathResolver entityPathResolver;
+
     /** @OEM Utils handler */
     pldm::responder::oem_utils::Handler* oemUtilsHandler;
 
+    /** @brief what the merge of each host entity association PDR added to
+     *         the BMC's repository and entity association tree
+     */
+    pldm::hostbmc::MergedAssociations mergedAssociations;
+
     PDRList stateSensorPDRs;
     PDRList fruRecordSetPDRs{};
 
@@ -0,0 +1,120 @@
+#include "merged_associations.hpp"
+
+#include "libpldmresponder/pdr_utils.hpp"
+
+#include <algorithm>
+
+namespace pldm
+{
+
+namespace hostbmc
+{
+
+namespace
+{
+
+bool isSameEntity(const pldm_entity& lhs, const pldm_entity& rhs)
+{
+    return lhs.entity_type == rhs.entity_type &&
+           lhs.entity_instance_num == rhs.entity_instance_num &&
+           lhs.entity_container_id == rhs.entity_container_id;
+}
+
+} // namespace
+
+void MergedAssociations::add(uint32_t recordHandle,
+                             const pldm::utils::Entities& merged,
+                             std::vector<uint32_t>&& bmcRecordHandles)
+{
+    if (merged.empty() && bmcRecordHandles.empty())
+    {
+        return;
+    }
+
+    auto& merge = merges[recordHandle];
+    if (!merged.empty())
+    {
+        merge.container = pldm_entity_extract(merged.front());
+        for (auto it = merged.begin() + 1; it != merged.end(); ++it)
+        {
+            merge.entities.emplace_back(pldm_entity_extract(*it));
+        }
+    }
+    merge.recordHandles.insert(merge.recordHandles.end(),
+                               bmcRecordHandles.begin(),
+                               bmcRecordHandles.end());
+}
+
+std::vector<uint32_t> MergedAssociations::remove(uint32_t recordHandle)
+{
+    std::vector<uint32_t> removed;
+    auto it = merges.find(recordHandle);
+    if (it == merges.end())
+    {
+        return removed;
+    }
+
+    auto merge = std::move(it->second);
+    merges.erase(it);
+    removed.emplace_back(recordHandle);
+
+    // The merges contained by the entities of this one go first, their nodes
+    // are deleted along with the nodes of this merge
+    std::vector<uint32_t> contained;
+    for (const auto& [handle, other] : merges)
+    {
+        const auto& container = other.container;
+        if (std::ranges::any_of(merge.entities,
+                                [&container](const auto& entity) {
+            return isSameEntity(entity, container);
+        }))
+        {
+            contained.emplace_back(handle);
+        }
+    }
+    for (auto handle : contained)
+    {
+        auto handles = remove(handle);
+        removed.insert(removed.end(), handles.begin(), handles.end());
+    }
+
+    for (auto handle : merge.recordHandles)
+    {
+        pldm_delete_by_record_handle(repo, handle, true);
+    }
+    if (!merge.recordHandles.empty())
+    {
+        responder::pdr_utils::repoModified(repo);
+    }
+
+    std::vector<pldm_entity_node*> nodes;
+    for (const auto& entity : merge.entities)
+    {
+        if (auto node = tree.find(entity, false))
+        {
+            nodes.emplace_back(node);
+        }
+    }
+    std::erase_if(entityAssociations, [&nodes](const auto& entities) {
+        return entities.size() > 1 &&
+               std::any_of(entities.begin() + 1, entities.end(),
+                           [&nodes](auto node) {
+            return std::ranges::find(nodes, node) != nodes.end();
+        });
+    });
+    std::erase_if(objPathMap, [&merge](const auto& item) {
+        return std::ranges::any_of(merge.entities,
+                                   [&item](const auto& entity) {
+            return isSameEntity(entity, item.second);
+        });
+    });
+    for (const auto& entity : merge.entities)
+    {
+        tree.deleteEntity(entity);
+    }
+
+    return removed;
+}
+
+} // namespace hostbmc
+} // namespace pldm
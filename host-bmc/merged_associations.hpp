@@ -0,0 +1,107 @@
+#pragma once
+
+#include "common/utils.hpp"
+#include "libpldmresponder/entity_association_tree.hpp"
+
+#include <libpldm/pdr.h>
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace pldm
+{
+
+namespace hostbmc
+{
+
+/** @class MergedAssociations
+ *
+ *  Keeps what the merge of each host entity association PDR added to the
+ *  BMC's PDR repository and entity association tree, keyed by the host
+ *  record handle, so that a changed or removed host PDR can be taken out of
+ *  the BMC's view before it is merged again.
+ */
+class MergedAssociations
+{
+  public:
+    MergedAssociations() = delete;
+    MergedAssociations(const MergedAssociations&) = delete;
+    MergedAssociations& operator=(const MergedAssociations&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] repo - BMC's PDR repository
+     *  @param[in] tree - BMC's entity association tree
+     *  @param[in] entityAssociations - container nodes and the nodes merged
+     *                                  under them
+     *  @param[in] objPathMap - object paths of the merged entities
+     */
+    MergedAssociations(
+        pldm_pdr* repo, responder::pdr_utils::EntityAssociationTree& tree,
+        pldm::utils::EntityAssociations& entityAssociations,
+        pldm::utils::ObjectPathMaps& objPathMap) :
+        repo(repo),
+        tree(tree), entityAssociations(entityAssociations),
+        objPathMap(objPathMap)
+    {}
+
+    /** @brief Record the merge of a host entity association PDR
+     *
+     *  @param[in] recordHandle - host record handle of the PDR
+     *  @param[in] merged - container node followed by the merged nodes
+     *  @param[in] bmcRecordHandles - record handles of the PDRs the merge
+     *                                added to the BMC's repository
+     */
+    void add(uint32_t recordHandle, const pldm::utils::Entities& merged,
+             std::vector<uint32_t>&& bmcRecordHandles);
+
+    /** @brief Take out of the repository and the tree what the merge of a
+     *         host PDR added, the merges under the entities it added go
+     *         along with it
+     *
+     *  @param[in] recordHandle - host record handle of the PDR
+     *
+     *  @return host record handles of the merges taken out
+     */
+    std::vector<uint32_t> remove(uint32_t recordHandle);
+
+    /** @brief Forget all the merges, to be called when the remote PDRs and
+     *         entities are dropped altogether
+     */
+    void clear()
+    {
+        merges.clear();
+    }
+
+  private:
+    struct Merge
+    {
+        /** @brief container entity of the merged entities */
+        pldm_entity container;
+
+        /** @brief entities the merge added to the tree */
+        std::vector<pldm_entity> entities;
+
+        /** @brief PDRs the merge added to the repository */
+        std::vector<uint32_t> recordHandles;
+    };
+
+    /** @brief BMC's PDR repository */
+    pldm_pdr* repo;
+
+    /** @brief BMC's entity association tree */
+    responder::pdr_utils::EntityAssociationTree& tree;
+
+    /** @brief container nodes and the nodes merged under them */
+    pldm::utils::EntityAssociations& entityAssociations;
+
+    /** @brief object paths of the merged entities */
+    pldm::utils::ObjectPathMaps& objPathMap;
+
+    /** @brief merges keyed by the host record handle */
+    std::map<uint32_t, Merge> merges;
+};
+
+} // namespace hostbmc
+} // namespace pldm
@@ -9,6 +9,9 @@
 using namespace pldm::host_effecters;
 using namespace pldm::utils;
 
+using ::testing::_;
+using ::testing::Return;
+
 class MockHostEffecterParser : public HostEffecterParser
 {
   public:
@@ -87,3 +90,73 @@ TEST(HostEffecterParser, findNewStateValue)
     ASSERT_THROW(hostEffecterParser.findNewStateValue(0, 0, val2),
                  std::exception);
 }
+
+TEST(HostEffecterParser, coalesceEffecterStates)
+{
+    MockdBusHandler dbusHandler;
+    int sockfd{};
+    MockHostEffecterParser hostEffecterParser(sockfd, nullptr, &dbusHandler,
+                                              "./host_effecter_jsons/good");
+
+    DbusChgHostEffecterProps props{
+        {"BootMode",
+         PropertyValue{std::in_place_type<std::string>,
+                       "xyz.openbmc_project.Control.Boot.Mode.Modes.Regular"}}};
+    hostEffecterParser.processHostEffecterChangeNotification(props, 0, 0, 4);
+    hostEffecterParser.processHostEffecterChangeNotification(props, 0, 0, 4);
+
+    EXPECT_CALL(dbusHandler, getDbusPropertyVariant(_, _, _))
+        .WillOnce(Return(PropertyValue{
+            std::in_place_type<std::string>,
+            "xyz.openbmc_project.State.Boot.Progress.ProgressStages.OSRunning"}));
+    EXPECT_CALL(hostEffecterParser, setHostStateEffecter(0, _, 4))
+        .WillOnce(Return(PLDM_SUCCESS));
+    hostEffecterParser.flushPendingEffecterStates();
+
+    // Nothing left to send once the batch is flushed
+    hostEffecterParser.flushPendingEffecterStates();
+}
+
+static void addHostStateEffecterPDR(pldm_pdr* repo, uint16_t effecterId)
+{
+    std::vector<uint8_t> pdrBuf(sizeof(pldm_state_effecter_pdr) -
+                                sizeof(uint8_t) +
+                                sizeof(state_effecter_possible_states));
+    auto pdr = reinterpret_cast<pldm_state_effecter_pdr*>(pdrBuf.data());
+    pdr->hdr.type = PLDM_STATE_EFFECTER_PDR;
+    pdr->hdr.length = pdrBuf.size() - sizeof(pldm_pdr_hdr);
+    pdr->effecter_id = effecterId;
+    pdr->entity_type = 33;
+    pdr->entity_instance = 0;
+    pdr->container_id = 0;
+    pdr->composite_effecter_count = 1;
+    auto possibleStates =
+        reinterpret_cast<state_effecter_possible_states*>(pdr->possible_states);
+    possibleStates->state_set_id = 196;
+    possibleStates->possible_states_size = 1;
+
+    uint32_t recordHandle = 0;
+    ASSERT_EQ(pldm_pdr_add_check(repo, pdrBuf.data(), pdrBuf.size(), true, 1,
+                                 &recordHandle),
+              0);
+}
+
+TEST(HostEffecterParser, clearEffecterIdCache)
+{
+    auto repo = pldm_pdr_init();
+    MockdBusHandler dbusHandler;
+    int sockfd{};
+    MockHostEffecterParser hostEffecterParser(sockfd, repo, &dbusHandler,
+                                              "./host_effecter_jsons/good");
+
+    addHostStateEffecterPDR(repo, 4);
+    EXPECT_EQ(hostEffecterParser.findHostEffecterId(0, 0), 4);
+
+    // The host replaces its effecter PDR, the record count stays the same
+    pldm_pdr_remove_remote_pdrs(repo);
+    addHostStateEffecterPDR(repo, 5);
+    hostEffecterParser.clearEffecterIdCache();
+    EXPECT_EQ(hostEffecterParser.findHostEffecterId(0, 0), 5);
+
+    pldm_pdr_destroy(repo);
+}
@@ -0,0 +1,132 @@
+#include "common/utils.hpp"
+#include "host-bmc/merged_associations.hpp"
+#include "libpldmresponder/entity_association_tree.hpp"
+#include "libpldmresponder/pdr_utils.hpp"
+
+#include <libpldm/entity.h>
+#include <libpldm/pdr.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::hostbmc;
+using namespace pldm::utils;
+using pldm::responder::pdr_utils::EntityAssociationTree;
+using pldm::responder::pdr_utils::getRepoGeneration;
+using pldm::responder::pdr_utils::trackRepoGeneration;
+using pldm::responder::pdr_utils::untrackRepoGeneration;
+
+class MergedAssociationsTest : public testing::Test
+{
+  protected:
+    MergedAssociationsTest() :
+        repo(pldm_pdr_init()), entityTree(pldm_entity_association_tree_init()),
+        tree(entityTree),
+        merges(repo, tree, entityAssociations, objPathMap)
+    {
+        auto node = tree.addEntity(chassis, 1, nullptr,
+                                   PLDM_ENTITY_ASSOCIAION_PHYSICAL, false,
+                                   true, 0xFFFF);
+        chassis = pldm_entity_extract(node);
+        trackRepoGeneration(repo);
+    }
+
+    ~MergedAssociationsTest()
+    {
+        untrackRepoGeneration(repo);
+        pldm_entity_association_tree_destroy(entityTree);
+        pldm_pdr_destroy(repo);
+    }
+
+    /** @brief Merge a host PDR containing entities under a container, and
+     *         add the PDR the BMC would publish for it
+     */
+    Entities merge(uint32_t recordHandle, const pldm_entity& container,
+                   std::vector<pldm_entity> contained)
+    {
+        std::vector<pldm_entity> entities{container};
+        entities.insert(entities.end(), contained.begin(), contained.end());
+        auto merged = tree.mergeRemoteAssociation(
+            entities.data(), entities.size(), PLDM_ENTITY_ASSOCIAION_PHYSICAL,
+            false);
+        entityAssociations.emplace_back(merged);
+        for (auto it = merged.begin() + 1; it != merged.end(); ++it)
+        {
+            auto entity = pldm_entity_extract(*it);
+            objPathMap["/entity/" + std::to_string(entity.entity_type) + "_" +
+                       std::to_string(entity.entity_instance_num)] = entity;
+        }
+
+        std::vector<uint8_t> pdr(sizeof(pldm_pdr_hdr));
+        uint32_t bmcRecordHandle = 0;
+        EXPECT_EQ(pldm_pdr_add_check(repo, pdr.data(), pdr.size(), true, 1,
+                                     &bmcRecordHandle),
+                  0);
+        merges.add(recordHandle, merged, {bmcRecordHandle});
+        return merged;
+    }
+
+    pldm_pdr* repo;
+    pldm_entity_association_tree* entityTree;
+    EntityAssociationTree tree;
+    EntityAssociations entityAssociations;
+    ObjectPathMaps objPathMap;
+    MergedAssociations merges;
+    pldm_entity chassis{PLDM_ENTITY_SYSTEM_CHASSIS, 1, 0};
+};
+
+TEST_F(MergedAssociationsTest, removed)
+{
+    auto boardNode = merge(0x10, chassis, {{PLDM_ENTITY_SYS_BOARD, 1, 1}})[1];
+    auto board = pldm_entity_extract(boardNode);
+    auto dimm = pldm_entity_extract(
+        merge(0x11, board, {{PLDM_ENTITY_MEMORY_MODULE, 1, 1}})[1]);
+    ASSERT_EQ(pldm_pdr_get_record_count(repo), 2);
+    ASSERT_EQ(entityAssociations.size(), 2);
+
+    // Unknown host PDRs are left alone
+    EXPECT_TRUE(merges.remove(0x12).empty());
+    EXPECT_EQ(pldm_pdr_get_record_count(repo), 2);
+
+    // The merge of the board goes along with the merge under it, the
+    // snapshots of the repository are taken again
+    auto generation = getRepoGeneration(repo);
+    EXPECT_EQ(merges.remove(0x10), (std::vector<uint32_t>{0x10, 0x11}));
+    EXPECT_EQ(pldm_pdr_get_record_count(repo), 0);
+    EXPECT_GT(getRepoGeneration(repo), generation);
+    EXPECT_TRUE(entityAssociations.empty());
+    EXPECT_TRUE(objPathMap.empty());
+    EXPECT_EQ(tree.find(board, false), nullptr);
+    EXPECT_EQ(tree.find(dimm, false), nullptr);
+    EXPECT_NE(tree.find(chassis, false), nullptr);
+
+    EXPECT_TRUE(merges.remove(0x11).empty());
+}
+
+TEST_F(MergedAssociationsTest, changed)
+{
+    auto boardNode = merge(0x10, chassis, {{PLDM_ENTITY_SYS_BOARD, 1, 1}})[1];
+    auto board = pldm_entity_extract(boardNode);
+    merge(0x11, board, {{PLDM_ENTITY_MEMORY_MODULE, 1, 1}});
+    ASSERT_EQ(pldm_entity_get_num_children(boardNode,
+                                           PLDM_ENTITY_ASSOCIAION_PHYSICAL),
+              1);
+
+    // The changed PDR replaces what it was merged as
+    EXPECT_EQ(merges.remove(0x11), std::vector<uint32_t>{0x11});
+    auto dimms = merge(0x11, board,
+                       {{PLDM_ENTITY_MEMORY_MODULE, 1, 1},
+                        {PLDM_ENTITY_MEMORY_MODULE, 2, 1}});
+    EXPECT_EQ(pldm_entity_get_num_children(boardNode,
+                                           PLDM_ENTITY_ASSOCIAION_PHYSICAL),
+              2);
+    EXPECT_EQ(pldm_pdr_get_record_count(repo), 2);
+    ASSERT_EQ(entityAssociations.size(), 2);
+    EXPECT_EQ(entityAssociations.back(), dimms);
+    EXPECT_EQ(objPathMap.size(), 3);
+
+    // The board merge is untouched
+    EXPECT_EQ(tree.find(board, false), boardNode);
+    EXPECT_EQ(entityAssociations.front()[1], boardNode);
+}
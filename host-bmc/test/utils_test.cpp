@@ -114,3 +114,60 @@ TEST(EntityAssociation, addObjectPathEntityAssociations1)
     EXPECT_EQ(index, retObjectMaps.size());
     pldm_entity_association_tree_destroy(tree);
 }
+
+TEST(EntityAssociation, updateEntityAssociationIncremental)
+{
+    pldm_entity entities[5]{};
+
+    entities[0].entity_type = 45;
+    entities[1].entity_type = 64;
+    entities[2].entity_type = 67;
+    entities[3].entity_type = 135;
+    entities[4].entity_type = 135;
+
+    auto tree = pldm_entity_association_tree_init();
+
+    auto l1 = pldm_entity_association_tree_add_entity(
+        tree, &entities[0], 1, nullptr, PLDM_ENTITY_ASSOCIAION_PHYSICAL, true,
+        true, 0xFFFF);
+    auto l2 = pldm_entity_association_tree_add_entity(
+        tree, &entities[1], 1, l1, PLDM_ENTITY_ASSOCIAION_PHYSICAL, true, true,
+        0xFFFF);
+    auto l3 = pldm_entity_association_tree_add_entity(
+        tree, &entities[2], 0, l2, PLDM_ENTITY_ASSOCIAION_PHYSICAL, true, true,
+        0xFFFF);
+    auto l4a = pldm_entity_association_tree_add_entity(
+        tree, &entities[3], 0, l3, PLDM_ENTITY_ASSOCIAION_PHYSICAL, true, true,
+        0xFFFF);
+
+    EntityMaps entityMaps = parseEntityMap("./entitymap_test.json");
+    EntityPathResolver resolver;
+    ObjectPathMaps objPathMap;
+
+    // The first exchange only carries the association of the DCM
+    updateEntityAssociation({{l3, l4a}}, tree, objPathMap, entityMaps, nullptr,
+                            &resolver);
+    ASSERT_EQ(objPathMap.size(), 2u);
+    EXPECT_TRUE(objPathMap.contains(
+        "/xyz/openbmc_project/inventory/chassis1/motherboard1/dcm0/cpu0"));
+
+    // A later merge adds a CPU, resolved from the paths already known
+    auto l4b = pldm_entity_association_tree_add_entity(
+        tree, &entities[4], 1, l3, PLDM_ENTITY_ASSOCIAION_PHYSICAL, true, true,
+        0xFFFF);
+    updateEntityAssociation({{l3, l4a, l4b}}, tree, objPathMap, entityMaps,
+                            nullptr, &resolver);
+
+    ObjectPathMaps expected;
+    updateEntityAssociation({{l3, l4a, l4b}}, tree, expected, entityMaps,
+                            nullptr);
+    ASSERT_EQ(objPathMap.size(), 3u);
+    EXPECT_TRUE(objPathMap.contains(
+        "/xyz/openbmc_project/inventory/chassis1/motherboard1/dcm0/cpu1"));
+    for (const auto& [path, entity] : expected)
+    {
+        ASSERT_TRUE(objPathMap.contains(path));
+        EXPECT_EQ(objPathMap[path].entity_type, entity.entity_type);
+    }
+    pldm_entity_association_tree_destroy(tree);
+}
@@ -4,6 +4,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <unordered_set>
 
 using namespace pldm::utils;
 
@@ -13,43 +14,50 @@ namespace hostbmc
 {
 namespace utils
 {
+namespace
+{
+
+const fs::path inventoryPath{"/xyz/openbmc_project/inventory"};
+
+/** @brief associations keyed by their container entity */
+using AssociationIndex =
+    std::unordered_map<uint64_t, std::vector<const Entities*>>;
+
+uint64_t makeKey(uint16_t entityType, uint16_t entityInstanceNumber,
+                 uint16_t containerId)
+{
+    return (static_cast<uint64_t>(entityType) << 32) |
+           (static_cast<uint64_t>(entityInstanceNumber) << 16) | containerId;
+}
+
+uint64_t makeRemoteKey(pldm_entity_node* node)
+{
+    auto entity = pldm_entity_extract(node);
+    return makeKey(entity.entity_type, entity.entity_instance_num,
+                   pldm_entity_node_get_remote_container_id(node));
+}
+
+} // namespace
+
 Entities getParentEntites(const EntityAssociations& entityAssoc)
 {
-    Entities parents{};
-    for (const auto& et : entityAssoc)
+    std::unordered_set<uint64_t> children{};
+    for (const auto& evs : entityAssoc)
     {
-        parents.push_back(et[0]);
+        for (size_t i = 1; i < evs.size(); i++)
+        {
+            children.emplace(makeRemoteKey(evs[i]));
+        }
     }
 
-    bool found = false;
-    for (auto it = parents.begin(); it != parents.end();
-         it = found ? parents.erase(it) : std::next(it))
+    // A container of several associations is listed once, all of its
+    // associations are walked from it
+    Entities parents{};
+    for (const auto& et : entityAssoc)
     {
-        uint16_t parent_contained_id =
-            pldm_entity_node_get_remote_container_id(*it);
-        found = false;
-        for (const auto& evs : entityAssoc)
+        if (children.emplace(makeRemoteKey(et[0])).second)
         {
-            for (size_t i = 1; i < evs.size() && !found; i++)
-            {
-                uint16_t node_contained_id =
-                    pldm_entity_node_get_remote_container_id(evs[i]);
-
-                pldm_entity parent_entity = pldm_entity_extract(*it);
-                pldm_entity node_entity = pldm_entity_extract(evs[i]);
-
-                if (node_entity.entity_type == parent_entity.entity_type &&
-                    node_entity.entity_instance_num ==
-                        parent_entity.entity_instance_num &&
-                    node_contained_id == parent_contained_id)
-                {
-                    found = true;
-                }
-            }
-            if (found)
-            {
-                break;
-            }
+            parents.push_back(et[0]);
         }
     }
 
@@ -57,8 +65,9 @@ Entities getParentEntites(const EntityAssociations& entityAssoc)
 }
 
 void addObjectPathEntityAssociations(
-    const EntityAssociations& entityAssoc, pldm_entity_node* entity,
-    const fs::path& path, ObjectPathMaps& objPathMap, EntityMaps entityMaps,
+    const AssociationIndex& associationIndex, pldm_entity_node* entity,
+    const fs::path& path, ObjectPathMaps& objPathMap,
+    const EntityMaps& entityMaps,
     pldm::responder::oem_platform::Handler* oemPlatformHandler)
 {
     if (entity == nullptr)
@@ -66,9 +75,9 @@ void addObjectPathEntityAssociations(
         return;
     }
 
-    bool found = false;
     pldm_entity node_entity = pldm_entity_extract(entity);
-    if (!entityMaps.contains(node_entity.entity_type))
+    auto entityName = entityMaps.find(node_entity.entity_type);
+    if (entityName == entityMaps.end())
     {
         // entityMaps doesn't contain entity type which are not required to
         // build entity object path, so returning from here because this is a
@@ -76,96 +85,124 @@ void addObjectPathEntityAssociations(
         return;
     }
 
-    std::string entityName = entityMaps.at(node_entity.entity_type);
-    for (const auto& ev : entityAssoc)
+    fs::path p = path /
+                 fs::path{entityName->second +
+                          std::to_string(node_entity.entity_instance_num)};
+    std::string entity_path = p.string();
+    if (oemPlatformHandler)
+    {
+        oemPlatformHandler->updateOemDbusPaths(entity_path);
+    }
+    try
     {
-        pldm_entity ev_entity = pldm_entity_extract(ev[0]);
-        if (ev_entity.entity_instance_num == node_entity.entity_instance_num &&
-            ev_entity.entity_type == node_entity.entity_type)
+        pldm::utils::DBusHandler().getService(entity_path.c_str(), nullptr);
+        // If the entity obtained from the remote PLDM terminal is not in the
+        // MAP, or there is no auxiliary name PDR, add it directly. Otherwise,
+        // check whether the DBus service of entity_path exists, and overwrite
+        // the entity if it does not exist.
+        if (objPathMap.contains(entity_path))
         {
-            uint16_t node_contained_id =
-                pldm_entity_node_get_remote_container_id(ev[0]);
-            uint16_t entity_contained_id =
-                pldm_entity_node_get_remote_container_id(entity);
-
-            if (node_contained_id != entity_contained_id)
-            {
-                continue;
-            }
-
-            fs::path p = path / fs::path{entityName +
-                                         std::to_string(
-                                             node_entity.entity_instance_num)};
-            std::string entity_path = p.string();
-            if (oemPlatformHandler)
-            {
-                oemPlatformHandler->updateOemDbusPaths(entity_path);
-            }
-            try
-            {
-                pldm::utils::DBusHandler().getService(entity_path.c_str(),
-                                                      nullptr);
-                // If the entity obtained from the remote PLDM terminal is not
-                // in the MAP, or there is no auxiliary name PDR, add it
-                // directly. Otherwise, check whether the DBus service of
-                // entity_path exists, and overwrite the entity if it does not
-                // exist.
-                if (objPathMap.contains(entity_path))
-                {
-                    objPathMap[entity_path] = node_entity;
-                }
-            }
-            catch (const std::exception&)
-            {
-                objPathMap[entity_path] = node_entity;
-            }
-
-            for (size_t i = 1; i < ev.size(); i++)
-            {
-                addObjectPathEntityAssociations(entityAssoc, ev[i], p,
-                                                objPathMap, entityMaps,
-                                                oemPlatformHandler);
-            }
-            found = true;
+            objPathMap[entity_path] = node_entity;
         }
     }
+    catch (const std::exception&)
+    {
+        objPathMap[entity_path] = node_entity;
+    }
 
-    if (!found)
+    auto associations = associationIndex.find(makeRemoteKey(entity));
+    if (associations == associationIndex.end())
     {
-        std::string dbusPath =
-            path / fs::path{entityName +
-                            std::to_string(node_entity.entity_instance_num)};
-        if (oemPlatformHandler)
-        {
-            oemPlatformHandler->updateOemDbusPaths(dbusPath);
-        }
-        try
-        {
-            pldm::utils::DBusHandler().getService(dbusPath.c_str(), nullptr);
-            if (objPathMap.contains(dbusPath))
-            {
-                objPathMap[dbusPath] = node_entity;
-            }
-        }
-        catch (const std::exception&)
+        return;
+    }
+    for (const auto* ev : associations->second)
+    {
+        for (size_t i = 1; i < ev->size(); i++)
         {
-            objPathMap[dbusPath] = node_entity;
+            addObjectPathEntityAssociations(associationIndex, (*ev)[i], p,
+                                            objPathMap, entityMaps,
+                                            oemPlatformHandler);
         }
     }
 }
 
+std::optional<fs::path> EntityPathResolver::resolveParentPath(
+    pldm_entity_association_tree* entityTree, pldm_entity_node* node,
+    const EntityMaps& entityMaps)
+{
+    if (!pldm_entity_is_exist_parent(node))
+    {
+        return inventoryPath;
+    }
+
+    return resolvePath(entityTree, pldm_entity_get_parent(node), entityMaps);
+}
+
+std::optional<fs::path>
+    EntityPathResolver::resolvePath(pldm_entity_association_tree* entityTree,
+                                    const pldm_entity& entity,
+                                    const EntityMaps& entityMaps)
+{
+    auto key = makeKey(entity.entity_type, entity.entity_instance_num,
+                       entity.entity_container_id);
+    if (auto it = paths.find(key); it != paths.end())
+    {
+        return it->second;
+    }
+
+    auto entityName = entityMaps.find(entity.entity_type);
+    if (entityName == entityMaps.end())
+    {
+        lg2::error(
+            "Parent entity not found in the entityMaps, type: {ENTITY_TYPE}, num: {NUM}",
+            "ENTITY_TYPE", (int)entity.entity_type, "NUM",
+            (int)entity.entity_instance_num);
+        paths.emplace(key, std::nullopt);
+        return std::nullopt;
+    }
+
+    // An ancestor missing from the tree ends the walk, as the root does
+    std::optional<fs::path> path{inventoryPath};
+    pldm_entity lookup = entity;
+    auto node = pldm_entity_association_tree_find_with_locality(entityTree,
+                                                                &lookup, false);
+    if (node)
+    {
+        path = resolveParentPath(entityTree, node, entityMaps);
+    }
+    if (path)
+    {
+        *path /= entityName->second +
+                 std::to_string(entity.entity_instance_num);
+    }
+
+    paths.emplace(key, path);
+    return path;
+}
+
 void updateEntityAssociation(
     const EntityAssociations& entityAssoc,
     pldm_entity_association_tree* entityTree, ObjectPathMaps& objPathMap,
-    EntityMaps entityMaps,
-    pldm::responder::oem_platform::Handler* oemPlatformHandler)
+    const EntityMaps& entityMaps,
+    pldm::responder::oem_platform::Handler* oemPlatformHandler,
+    EntityPathResolver* resolver)
 {
+    EntityPathResolver transientResolver;
+    if (!resolver)
+    {
+        resolver = &transientResolver;
+    }
+
+    AssociationIndex associationIndex{};
+    for (const auto& ev : entityAssoc)
+    {
+        associationIndex[makeRemoteKey(ev[0])].push_back(&ev);
+    }
+
     std::vector<pldm_entity_node*> parentsEntity =
         getParentEntites(entityAssoc);
     for (const auto& entity : parentsEntity)
     {
-        fs::path path{"/xyz/openbmc_project/inventory"};
-        std::deque<std::string> paths{};
         pldm_entity node_entity = pldm_entity_extract(entity);
         uint16_t remoteContainerId =
             pldm_entity_node_get_remote_container_id(entity);
@@ -187,47 +224,15 @@ void updateEntityAssociation(
             continue;
         }
 
-        bool found = true;
-        while (node)
-        {
-            if (!pldm_entity_is_exist_parent(node))
-            {
-                break;
-            }
-
-            pldm_entity parent = pldm_entity_get_parent(node);
-            try
-            {
-                paths.push_back(entityMaps.at(parent.entity_type) +
-                                std::to_string(parent.entity_instance_num));
-            }
-            catch (const std::exception& e)
-            {
-                lg2::error(
-                    "Parent entity not found in the entityMaps, type: {ENTITY_TYPE}, num: {NUM}, e: {ERROR}",
-                    "ENTITY_TYPE", (int)parent.entity_type, "NUM",
-                    (int)parent.entity_instance_num, "ERROR", e);
-                found = false;
-                break;
-            }
-
-            node = pldm_entity_association_tree_find_with_locality(
-                entityTree, &parent, false);
-        }
-
-        if (!found)
+        auto path = resolver->resolveParentPath(entityTree, node, entityMaps);
+        if (!path)
         {
             continue;
         }
 
-        while (!paths.empty())
-        {
-            path = path / fs::path{paths.back()};
-            paths.pop_back();
-        }
-
-        addObjectPathEntityAssociations(entityAssoc, entity, path, objPathMap,
-                                        entityMaps, oemPlatformHandler);
+        addObjectPathEntityAssociations(associationIndex, entity, *path,
+                                        objPathMap, entityMaps,
+                                        oemPlatformHandler);
     }
 }
 
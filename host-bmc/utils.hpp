@@ -9,7 +9,9 @@
 #include <filesystem>
 #include <fstream>
 #include <map>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -22,18 +24,78 @@ namespace hostbmc
 namespace utils
 {
 
+/** @class EntityPathResolver
+ *
+ *  @brief Resolves the inventory object paths of the entities of an entity
+ *  association tree, memoizing the path computed for every ancestor so that
+ *  the walk towards the root stops at the first ancestor already resolved.
+ *
+ *  The paths are kept across PDR merges, entities merged later only resolve
+ *  their new ancestors. The resolver must be cleared whenever the remote
+ *  nodes of the tree are deleted.
+ */
+class EntityPathResolver
+{
+  public:
+    /** @brief Resolve the object path under which the object path of an
+     *         entity is built, that is the object path of its parent
+     *
+     *  @param[in] entityTree - entity association tree
+     *  @param[in] node - node of the entity
+     *  @param[in] entityMaps - entity type to DBus string mapping
+     *
+     *  @return the object path, std::nullopt if an ancestor has no entry in
+     *          the entity maps
+     */
+    std::optional<fs::path>
+        resolveParentPath(pldm_entity_association_tree* entityTree,
+                          pldm_entity_node* node,
+                          const pldm::utils::EntityMaps& entityMaps);
+
+    /** @brief Drop the resolved paths */
+    void clear()
+    {
+        paths.clear();
+    }
+
+  private:
+    /** @brief Resolve the object path of an entity, looked up by its
+     *         container ID
+     *
+     *  @param[in] entityTree - entity association tree
+     *  @param[in] entity - the entity
+     *  @param[in] entityMaps - entity type to DBus string mapping
+     *
+     *  @return the object path, std::nullopt if the entity or one of its
+     *          ancestors has no entry in the entity maps
+     */
+    std::optional<fs::path>
+        resolvePath(pldm_entity_association_tree* entityTree,
+                    const pldm_entity& entity,
+                    const pldm::utils::EntityMaps& entityMaps);
+
+    /** @brief object paths keyed by entity type, instance and container ID */
+    std::unordered_map<uint64_t, std::optional<fs::path>> paths;
+};
+
 /** @brief Vector a entity name to pldm_entity from entity association tree
  *  @param[in]  entityAssoc    - Vector of associated pldm entities
  *  @param[in]  entityTree     - entity association tree
  *  @param[out] objPathMap     - maps an object path to pldm_entity from the
  *                               BMC's entity association tree
+ *  @param[in]  entityMaps     - entity type to DBus string mapping
+ *  @param[in]  oemPlatformHandler - OEM platform handler
+ *  @param[in]  resolver       - resolver keeping the object paths across
+ *                               calls, a transient one is used if nullptr
  *  @return
  */
 void updateEntityAssociation(
     const pldm::utils::EntityAssociations& entityAssoc,
     pldm_entity_association_tree* entityTree,
-    pldm::utils::ObjectPathMaps& objPathMap, pldm::utils::EntityMaps entityMaps,
-    pldm::responder::oem_platform::Handler* oemPlatformHandler);
+    pldm::utils::ObjectPathMaps& objPathMap,
+    const pldm::utils::EntityMaps& entityMaps,
+    pldm::responder::oem_platform::Handler* oemPlatformHandler,
+    EntityPathResolver* resolver = nullptr);
 
 /** @brief Parsing entity to DBus string mapping from json file
  *
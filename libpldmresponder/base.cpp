@@ -9,7 +9,6 @@
 #include <libpldm/platform.h>
 
 #include <array>
-#include <cstring>
 #include <map>
 #include <stdexcept>
 #include <vector>
@@ -65,8 +64,7 @@ static const std::map<Type, ver32_t> versions{
 
 namespace base
 {
-Response Handler::getPLDMTypes(const pldm_msg* request,
-                               size_t /*payloadLength*/)
+void Handler::encodeResponses()
 {
     // DSP0240 has this as a bitfield8[N], where N = 0 to 7
     std::array<bitfield8_t, 8> types{};
@@ -78,26 +76,77 @@ Response Handler::getPLDMTypes(const pldm_msg* request,
         types[index].byte |= 1 << bit;
     }
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_TYPES_RESP_BYTES, 0);
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-    auto rc = encode_get_types_resp(request->hdr.instance_id, PLDM_SUCCESS,
-                                    types.data(), responsePtr);
+    typesResponse.resize(sizeof(pldm_msg_hdr) + PLDM_GET_TYPES_RESP_BYTES);
+    auto rc = encode_get_types_resp(
+        0, PLDM_SUCCESS, types.data(),
+        reinterpret_cast<pldm_msg*>(typesResponse.data()));
     if (rc != PLDM_SUCCESS)
     {
-        return CmdHandler::ccOnlyResponse(request, rc);
+        throw std::runtime_error("Failed to encode GetPLDMTypes response");
+    }
+
+    for (const auto& [type, commands] : capabilities)
+    {
+        // DSP0240 has this as a bitfield8[N], where N = 0 to 31
+        std::array<bitfield8_t, 32> cmds{};
+        for (const auto& cmd : commands)
+        {
+            auto index = cmd / 8;
+            // <Type Number> = <Array Index> * 8 + <bit position>
+            auto bit = cmd - (index * 8);
+            cmds[index].byte |= 1 << bit;
+        }
+
+        Response response(sizeof(pldm_msg_hdr) + PLDM_GET_COMMANDS_RESP_BYTES,
+                          0);
+        rc = encode_get_commands_resp(
+            0, PLDM_SUCCESS, cmds.data(),
+            reinterpret_cast<pldm_msg*>(response.data()));
+        if (rc != PLDM_SUCCESS)
+        {
+            throw std::runtime_error(
+                "Failed to encode GetPLDMCommands response");
+        }
+        commandsResponses.emplace(type, std::move(response));
+    }
+
+    for (const auto& [type, version] : versions)
+    {
+        ver32_t versionData = version;
+        Response response(sizeof(pldm_msg_hdr) + PLDM_GET_VERSION_RESP_BYTES,
+                          0);
+        rc = encode_get_version_resp(
+            0, PLDM_SUCCESS, 0, PLDM_START_AND_END, &versionData,
+            sizeof(pldm_version), reinterpret_cast<pldm_msg*>(response.data()));
+        if (rc != PLDM_SUCCESS)
+        {
+            throw std::runtime_error(
+                "Failed to encode GetPLDMVersion response");
+        }
+        versionResponses.emplace(type, std::move(response));
     }
+}
 
+Response Handler::copyResponse(const pldm_msg* request,
+                               const Response& encoded)
+{
+    Response response(encoded);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    responsePtr->hdr.instance_id = request->hdr.instance_id;
     return response;
 }
 
+Response Handler::getPLDMTypes(const pldm_msg* request,
+                               size_t /*payloadLength*/)
+{
+    return copyResponse(request, typesResponse);
+}
+
 Response Handler::getPLDMCommands(const pldm_msg* request, size_t payloadLength)
 {
     ver32_t version{};
     Type type;
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_COMMANDS_RESP_BYTES, 0);
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-
     auto rc = decode_get_commands_req(request, payloadLength, &type, &version);
 
     if (rc != PLDM_SUCCESS)
@@ -105,30 +154,14 @@ Response Handler::getPLDMCommands(const pldm_msg* request, size_t payloadLength)
         return CmdHandler::ccOnlyResponse(request, rc);
     }
 
-    // DSP0240 has this as a bitfield8[N], where N = 0 to 31
-    std::array<bitfield8_t, 32> cmds{};
-    if (!capabilities.contains(type))
+    auto search = commandsResponses.find(type);
+    if (search == commandsResponses.end())
     {
         return CmdHandler::ccOnlyResponse(request,
                                           PLDM_ERROR_INVALID_PLDM_TYPE);
     }
 
-    for (const auto& cmd : capabilities.at(type))
-    {
-        auto index = cmd / 8;
-        // <Type Number> = <Array Index> * 8 + <bit position>
-        auto bit = cmd - (index * 8);
-        cmds[index].byte |= 1 << bit;
-    }
-
-    rc = encode_get_commands_resp(request->hdr.instance_id, PLDM_SUCCESS,
-                                  cmds.data(), responsePtr);
-    if (rc != PLDM_SUCCESS)
-    {
-        return ccOnlyResponse(request, rc);
-    }
-
-    return response;
+    return copyResponse(request, search->second);
 }
 
 Response Handler::getPLDMVersion(const pldm_msg* request, size_t payloadLength)
@@ -137,9 +170,6 @@ Response Handler::getPLDMVersion(const pldm_msg* request, size_t payloadLength)
     Type type;
     uint8_t transferFlag;
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_VERSION_RESP_BYTES, 0);
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-
     uint8_t rc = decode_get_version_req(request, payloadLength, &transferHandle,
                                         &transferFlag, &type);
 
@@ -148,25 +178,14 @@ Response Handler::getPLDMVersion(const pldm_msg* request, size_t payloadLength)
         return CmdHandler::ccOnlyResponse(request, rc);
     }
 
-    ver32_t version{};
-    auto search = versions.find(type);
-
-    if (search == versions.end())
+    auto search = versionResponses.find(type);
+    if (search == versionResponses.end())
     {
         return CmdHandler::ccOnlyResponse(request,
                                           PLDM_ERROR_INVALID_PLDM_TYPE);
     }
 
-    memcpy(&version, &(search->second), sizeof(version));
-    rc = encode_get_version_resp(request->hdr.instance_id, PLDM_SUCCESS, 0,
-                                 PLDM_START_AND_END, &version,
-                                 sizeof(pldm_version), responsePtr);
-    if (rc != PLDM_SUCCESS)
-    {
-        return ccOnlyResponse(request, rc);
-    }
-
-    return response;
+    return copyResponse(request, search->second);
 }
 
 void Handler::_processSetEventReceiver(sdeventplus::source::EventBase&
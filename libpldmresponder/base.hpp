@@ -7,6 +7,7 @@
 
 #include <sdeventplus/source/event.hpp>
 
+#include <map>
 #include <vector>
 
 using namespace pldm::responder;
@@ -45,6 +46,8 @@ class Handler : public CmdHandler
             [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
             return this->getTID(request, payloadLength);
         });
+
+        encodeResponses();
     }
 
     /** @brief Handler for getPLDMTypes
@@ -88,6 +91,20 @@ class Handler : public CmdHandler
     Response getTID(const pldm_msg* request, size_t payloadLength);
 
   private:
+    /** @brief Encode the GetPLDMTypes, GetPLDMCommands and GetPLDMVersion
+     *  responses once, they only depend on the capabilities of the BMC
+     */
+    void encodeResponses();
+
+    /** @brief Copy an encoded response and set the instance ID of the request
+     *
+     *  @param[in] request - Request message
+     *  @param[in] encoded - Response encoded with instance ID 0
+     *  @param[return] Response - PLDM Response message
+     */
+    static Response copyResponse(const pldm_msg* request,
+                                 const Response& encoded);
+
     /** @brief reference of main event loop of pldmd, primarily used to schedule
      *  work
      */
@@ -98,6 +115,15 @@ class Handler : public CmdHandler
 
     /** @brief sdeventplus event source */
     std::unique_ptr<sdeventplus::source::Defer> survEvent;
+
+    /** @brief GetPLDMTypes response */
+    Response typesResponse;
+
+    /** @brief GetPLDMCommands responses keyed by PLDM type */
+    std::map<uint8_t, Response> commandsResponses;
+
+    /** @brief GetPLDMVersion responses keyed by PLDM type */
+    std::map<uint8_t, Response> versionResponses;
 };
 
 } // namespace base
@@ -0,0 +1,157 @@
+#include "entity_association_tree.hpp"
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace pdr_utils
+{
+
+namespace
+{
+
+uint64_t makeKey(uint16_t entityType, uint16_t entityInstanceNumber,
+                 uint16_t containerId)
+{
+    return (static_cast<uint64_t>(entityType) << 32) |
+           (static_cast<uint64_t>(entityInstanceNumber) << 16) | containerId;
+}
+
+} // namespace
+
+EntityAssociationTree::EntityAssociationTree(
+    pldm_entity_association_tree* tree) :
+    tree(tree),
+    index(getIndex(tree))
+{}
+
+std::shared_ptr<EntityAssociationTree::Index>
+    EntityAssociationTree::getIndex(pldm_entity_association_tree* tree)
+{
+    static std::unordered_map<const pldm_entity_association_tree*,
+                              std::weak_ptr<Index>>
+        indexes;
+
+    auto& shared = indexes[tree];
+    auto index = shared.lock();
+    if (!index)
+    {
+        index = std::make_shared<Index>();
+        shared = index;
+    }
+
+    return index;
+}
+
+void EntityAssociationTree::forget(pldm_entity_node* node)
+{
+    auto entity = pldm_entity_extract(node);
+    for (auto containerId : {entity.entity_container_id,
+                             pldm_entity_node_get_remote_container_id(node)})
+    {
+        auto key = makeKey(entity.entity_type, entity.entity_instance_num,
+                           containerId);
+        index->local.erase(key);
+        index->remote.erase(key);
+    }
+}
+
+pldm_entity_node* EntityAssociationTree::find(const pldm_entity& entity,
+                                              bool isRemote)
+{
+    if (!tree)
+    {
+        return nullptr;
+    }
+
+    auto& lookups = isRemote ? index->remote : index->local;
+    auto key = makeKey(entity.entity_type, entity.entity_instance_num,
+                       entity.entity_container_id);
+    if (auto it = lookups.find(key); it != lookups.end())
+    {
+        return it->second;
+    }
+
+    pldm_entity lookup = entity;
+    auto node = pldm_entity_association_tree_find_with_locality(tree, &lookup,
+                                                                isRemote);
+    if (node)
+    {
+        lookups.emplace(key, node);
+    }
+
+    return node;
+}
+
+pldm_entity_node* EntityAssociationTree::addEntity(
+    pldm_entity entity, uint16_t entityInstanceNumber, pldm_entity_node* parent,
+    uint8_t associationType, bool isRemote, bool isUpdateContainerId,
+    uint16_t containerId)
+{
+    auto node = pldm_entity_association_tree_add_entity(
+        tree, &entity, entityInstanceNumber, parent, associationType, isRemote,
+        isUpdateContainerId, containerId);
+    if (node)
+    {
+        // The node may precede an indexed node of the same entity in the
+        // tree order, the next lookup of the entity walks the tree again.
+        forget(node);
+    }
+
+    return node;
+}
+
+pldm::utils::Entities EntityAssociationTree::mergeRemoteAssociation(
+    const pldm_entity* entities, size_t numEntities, uint8_t associationType,
+    bool isRemoteParent)
+{
+    pldm::utils::Entities merged;
+    if (!numEntities)
+    {
+        return merged;
+    }
+
+    auto parent = find(entities[0], isRemoteParent);
+    if (!parent)
+    {
+        return merged;
+    }
+
+    merged.reserve(numEntities);
+    merged.push_back(parent);
+    for (size_t i = 1; i < numEntities; ++i)
+    {
+        // A container ID with the logical bit set is owned by the remote
+        // terminus, keep it as is.
+        auto node = addEntity(entities[i], entities[i].entity_instance_num,
+                              parent, associationType, true,
+                              !(entities[i].entity_container_id & 0x8000),
+                              0xFFFF);
+        if (node)
+        {
+            merged.push_back(node);
+        }
+    }
+
+    return merged;
+}
+
+void EntityAssociationTree::deleteEntity(const pldm_entity& entity)
+{
+    // The deleted nodes may be indexed under any of their lookups
+    clear();
+    pldm_entity_association_tree_delete_node(tree, &entity);
+}
+
+void EntityAssociationTree::reset(pldm_entity_association_tree* source)
+{
+    clear();
+    pldm_entity_association_tree_destroy_root(tree);
+    pldm_entity_association_tree_copy_root(source, tree);
+}
+
+} // namespace pdr_utils
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "common/utils.hpp"
+
+#include <libpldm/pdr.h>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace pdr_utils
+{
+
+/**
+ *  @class EntityAssociationTree
+ *
+ *  Wrapper class to handle the entity association tree APIs
+ *
+ *  The libpldm lookups walk the whole tree for every entity, this class keeps
+ *  a hash index of the nodes keyed by entity type, instance number and
+ *  container ID so that merging large association PDRs stays near-linear.
+ *  The index caches the result of the tree traversal, so a lookup returns
+ *  the first match in the tree order like libpldm does. It is shared by all
+ *  the wrappers of the same tree, the entries an insertion may shadow are
+ *  dropped on every insertion made through a wrapper, and the whole index is
+ *  dropped when the tree is reset or modified directly through libpldm.
+ */
+class EntityAssociationTree
+{
+  public:
+    EntityAssociationTree() = delete;
+    EntityAssociationTree(const EntityAssociationTree&) = delete;
+    EntityAssociationTree& operator=(const EntityAssociationTree&) = delete;
+
+    explicit EntityAssociationTree(pldm_entity_association_tree* tree);
+
+    /** @brief Get the opaque pointer to the entity association tree
+     *
+     *  @return pointer to the entity association tree
+     */
+    pldm_entity_association_tree* get() const
+    {
+        return tree;
+    }
+
+    /** @brief Find an entity in the entity association tree, the tree is
+     *         walked if the entity is not indexed
+     *
+     *  @param[in] entity - entity to look up
+     *  @param[in] isRemote - look up by the remote container ID
+     *
+     *  @return pointer to the node, nullptr if not found
+     */
+    pldm_entity_node* find(const pldm_entity& entity, bool isRemote);
+
+    /** @brief Add an entity into the entity association tree
+     *
+     *  @param[in] entity - entity to add
+     *  @param[in] entityInstanceNumber - entity instance number, 0xFFFF to
+     *                                    have it assigned
+     *  @param[in] parent - parent node, nullptr for a top level entity
+     *  @param[in] associationType - physical or logical association
+     *  @param[in] isRemote - the entity belongs to a remote terminus
+     *  @param[in] isUpdateContainerId - assign a new container ID
+     *  @param[in] containerId - container ID to use when not updating it
+     *
+     *  @return pointer to the added node, nullptr on failure
+     */
+    pldm_entity_node* addEntity(pldm_entity entity,
+                                uint16_t entityInstanceNumber,
+                                pldm_entity_node* parent,
+                                uint8_t associationType, bool isRemote,
+                                bool isUpdateContainerId, uint16_t containerId);
+
+    /** @brief Merge the entities of a remote entity association PDR, the
+     *         first entity being the container of the rest
+     *
+     *  @param[in] entities - entities extracted from the PDR
+     *  @param[in] numEntities - number of entities
+     *  @param[in] associationType - physical or logical association
+     *  @param[in] isRemoteParent - look up the container by its remote
+     *                              container ID
+     *
+     *  @return the container node followed by the merged child nodes, empty
+     *          if the container is not part of the tree
+     */
+    pldm::utils::Entities mergeRemoteAssociation(const pldm_entity* entities,
+                                                 size_t numEntities,
+                                                 uint8_t associationType,
+                                                 bool isRemoteParent);
+
+    /** @brief Delete an entity and the entities under it from the entity
+     *         association tree
+     *
+     *  @param[in] entity - entity to delete
+     */
+    void deleteEntity(const pldm_entity& entity);
+
+    /** @brief Replace the content of the tree with a copy of another tree
+     *
+     *  @param[in] source - entity association tree to copy from
+     */
+    void reset(pldm_entity_association_tree* source);
+
+    /** @brief Drop the index, to be called after the tree is modified
+     *         outside of this class
+     */
+    void clear()
+    {
+        index->local.clear();
+        index->remote.clear();
+    }
+
+  private:
+    struct Index
+    {
+        /** @brief first match of the local lookups keyed by entity type,
+         *         instance and container ID
+         */
+        std::unordered_map<uint64_t, pldm_entity_node*> local;
+
+        /** @brief first match of the remote lookups keyed by entity type,
+         *         instance and container ID
+         */
+        std::unordered_map<uint64_t, pldm_entity_node*> remote;
+    };
+
+    /** @brief Get the index shared by the wrappers of a tree
+     *
+     *  @param[in] tree - entity association tree
+     *
+     *  @return the index, created if the tree has no other wrapper
+     */
+    static std::shared_ptr<Index> getIndex(pldm_entity_association_tree* tree);
+
+    /** @brief Drop the lookups a newly inserted node may be the first match
+     *         of
+     *
+     *  @param[in] node - inserted node
+     */
+    void forget(pldm_entity_node* node);
+
+    /** @brief opaque pointer to the entity association tree */
+    pldm_entity_association_tree* tree;
+
+    /** @brief index shared by the wrappers of the tree */
+    std::shared_ptr<Index> index;
+};
+
+} // namespace pdr_utils
+} // namespace responder
+} // namespace pldm
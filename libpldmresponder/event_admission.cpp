@@ -0,0 +1,142 @@
+#include "event_admission.hpp"
+
+#include <algorithm>
+
+namespace pldm
+{
+namespace responder
+{
+namespace events
+{
+
+EventAdmission::EventAdmission(size_t burst, Clock::duration refillInterval,
+                               Clock::duration dedupWindow) :
+    burst(burst),
+    refillInterval(refillInterval), dedupWindow(dedupWindow)
+{}
+
+EventAdmission::Bucket& EventAdmission::refill(uint8_t tid,
+                                               Clock::time_point now)
+{
+    auto [it, inserted] = buckets.try_emplace(tid, Bucket{burst, now});
+    auto& bucket = it->second;
+    if (inserted || refillInterval <= Clock::duration::zero())
+    {
+        return bucket;
+    }
+
+    auto added = (now - bucket.refilled) / refillInterval;
+    if (added <= 0)
+    {
+        return bucket;
+    }
+    if (static_cast<size_t>(added) >= burst - bucket.tokens)
+    {
+        bucket.tokens = burst;
+        bucket.refilled = now;
+    }
+    else
+    {
+        bucket.tokens += added;
+        bucket.refilled += added * refillInterval;
+    }
+    return bucket;
+}
+
+EventAdmission::Verdict EventAdmission::admit(
+    const SensorKey& key, std::span<const uint8_t> eventData,
+    const Event& event, Clock::time_point now)
+{
+    auto& bucket = refill(key.tid, now);
+
+    // A deferred event of the sensor is superseded, the events of a sensor
+    // are kept in order by deferring the later ones as well
+    if (auto it = deferred.find(key); it != deferred.end())
+    {
+        it->second = DeferredEvent{
+            sequence++, {eventData.begin(), eventData.end()}, event};
+        counters.merged++;
+        return Verdict::Defer;
+    }
+
+    if (auto last = lastEvents.find(key);
+        last != lastEvents.end() && now - last->second.time < dedupWindow &&
+        std::ranges::equal(last->second.eventData, eventData))
+    {
+        counters.merged++;
+        return Verdict::Merge;
+    }
+
+    if (!bucket.tokens || hasDeferred(key.tid))
+    {
+        deferred.emplace(
+            key, DeferredEvent{
+                     sequence++, {eventData.begin(), eventData.end()}, event});
+        counters.deferred++;
+        return Verdict::Defer;
+    }
+
+    bucket.tokens--;
+    counters.admitted++;
+    return Verdict::Admit;
+}
+
+void EventAdmission::handled(const SensorKey& key,
+                             std::span<const uint8_t> eventData,
+                             Clock::time_point now)
+{
+    lastEvents.insert_or_assign(
+        key, LastEvent{{eventData.begin(), eventData.end()}, now});
+}
+
+bool EventAdmission::hasDeferred(uint8_t tid) const
+{
+    auto it = deferred.lower_bound(SensorKey{tid, 0, 0, 0});
+    return it != deferred.end() && it->first.tid == tid;
+}
+
+std::vector<EventAdmission::Event>
+    EventAdmission::release(Clock::time_point now)
+{
+    std::vector<decltype(deferred)::iterator> pending;
+    pending.reserve(deferred.size());
+    for (auto it = deferred.begin(); it != deferred.end(); ++it)
+    {
+        pending.emplace_back(it);
+    }
+    std::ranges::sort(pending, {}, [](const auto& it) {
+        return it->second.sequence;
+    });
+
+    std::vector<Event> released;
+    for (auto it : pending)
+    {
+        const auto& key = it->first;
+        auto& bucket = refill(key.tid, now);
+        if (!bucket.tokens)
+        {
+            continue;
+        }
+
+        auto& [seq, eventData, event] = it->second;
+        if (auto last = lastEvents.find(key);
+            last != lastEvents.end() &&
+            now - last->second.time < dedupWindow &&
+            last->second.eventData == eventData)
+        {
+            counters.merged++;
+        }
+        else
+        {
+            bucket.tokens--;
+            released.emplace_back(std::move(event));
+            counters.admitted++;
+        }
+        deferred.erase(it);
+    }
+    return released;
+}
+
+} // namespace events
+} // namespace responder
+} // namespace pldm
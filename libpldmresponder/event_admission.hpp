@@ -0,0 +1,194 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+namespace events
+{
+
+/** @class EventAdmission
+ *
+ *  @brief Admission stage for the sensor events received in
+ *         PlatformEventMessage, ahead of the event handlers.
+ *
+ *  A sensor event repeating the last event successfully handled for the
+ *  same sensor within the deduplication window is merged into it, an event
+ *  the handlers failed on is not recorded so that the retry of the terminus
+ *  is handled. Each terminus has a token bucket, a sensor event coming in
+ *  while the bucket of its terminus is empty is deferred and replaced by any
+ *  later event of the same sensor, so that only the final state of a sensor
+ *  is handled once tokens are available again. The events of a terminus
+ *  coming in while some of its events are deferred are deferred as well,
+ *  the events of a terminus are handled in their arrival order. Events are
+ *  never dropped otherwise.
+ */
+class EventAdmission
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Sensor the event is about */
+    struct SensorKey
+    {
+        uint8_t tid;
+        uint16_t sensorId;
+        uint8_t sensorEventClass;
+        uint8_t sensorOffset; //!< 0 but for state sensor events
+
+        auto operator<=>(const SensorKey&) const = default;
+    };
+
+    /** @brief Sensor event deferred for lack of tokens */
+    struct Event
+    {
+        std::vector<uint8_t> request; //!< PlatformEventMessage request
+        uint8_t tid;
+        uint8_t formatVersion;
+        size_t eventDataOffset;
+    };
+
+    enum class Verdict
+    {
+        Admit, //!< handle the event now
+        Merge, //!< the event is a repeat, drop it
+        Defer, //!< the event is held until released
+    };
+
+    struct Counters
+    {
+        uint64_t admitted = 0; //!< events handled on arrival or on release
+        uint64_t merged = 0;   //!< repeats and superseded deferred events
+        uint64_t deferred = 0; //!< events held for lack of tokens
+    };
+
+    /** @brief Constructor
+     *
+     *  @param[in] burst - size of the token bucket of a terminus
+     *  @param[in] refillInterval - interval a token is added to the bucket at
+     *  @param[in] dedupWindow - window repeated sensor events are merged in
+     */
+    EventAdmission(size_t burst, Clock::duration refillInterval,
+                   Clock::duration dedupWindow);
+
+    /** @brief Admit a sensor event
+     *
+     *  @param[in] key - sensor the event is about
+     *  @param[in] eventData - sensor event data
+     *  @param[in] event - the event, stored if it gets deferred
+     *  @param[in] now - arrival time
+     *
+     *  @return verdict on the event
+     */
+    Verdict admit(const SensorKey& key, std::span<const uint8_t> eventData,
+                  const Event& event, Clock::time_point now);
+
+    /** @brief Record a sensor event the handlers succeeded on, its repeats
+     *         are merged into it within the deduplication window
+     *
+     *  @param[in] key - sensor the event is about
+     *  @param[in] eventData - sensor event data
+     *  @param[in] now - time the event was handled at
+     */
+    void handled(const SensorKey& key, std::span<const uint8_t> eventData,
+                 Clock::time_point now);
+
+    /** @brief Release the deferred events whose terminus has tokens again
+     *
+     *  @param[in] now - release time
+     *
+     *  @return the events to handle, in their arrival order
+     */
+    std::vector<Event> release(Clock::time_point now);
+
+    /** @brief Check if events are deferred
+     *
+     *  @return true if events are waiting to be released
+     */
+    bool hasDeferred() const
+    {
+        return !deferred.empty();
+    }
+
+    /** @brief Get the interval the tokens are added at
+     *
+     *  @return the refill interval
+     */
+    Clock::duration getRefillInterval() const
+    {
+        return refillInterval;
+    }
+
+    /** @brief Get the admission counters
+     *
+     *  @return the counters
+     */
+    const Counters& getCounters() const
+    {
+        return counters;
+    }
+
+  private:
+    struct Bucket
+    {
+        size_t tokens;
+        Clock::time_point refilled;
+    };
+
+    struct LastEvent
+    {
+        std::vector<uint8_t> eventData;
+        Clock::time_point time;
+    };
+
+    struct DeferredEvent
+    {
+        uint64_t sequence; //!< arrival order
+        std::vector<uint8_t> eventData;
+        Event event;
+    };
+
+    /** @brief Check if events of a terminus are deferred
+     *
+     *  @param[in] tid - terminus ID
+     *
+     *  @return true if events of the terminus are waiting to be released
+     */
+    bool hasDeferred(uint8_t tid) const;
+
+    /** @brief Refill the bucket of a terminus
+     *
+     *  @param[in] tid - terminus ID
+     *  @param[in] now - current time
+     *
+     *  @return the bucket of the terminus
+     */
+    Bucket& refill(uint8_t tid, Clock::time_point now);
+
+    size_t burst;
+    Clock::duration refillInterval;
+    Clock::duration dedupWindow;
+
+    /** @brief token buckets keyed by TID */
+    std::map<uint8_t, Bucket> buckets;
+
+    /** @brief last event successfully handled for each sensor */
+    std::map<SensorKey, LastEvent> lastEvents;
+
+    /** @brief deferred events, the latest for each sensor */
+    std::map<SensorKey, DeferredEvent> deferred;
+
+    uint64_t sequence = 0;
+    Counters counters;
+};
+
+} // namespace events
+} // namespace responder
+} // namespace pldm
@@ -1,10 +1,12 @@
 #include "event_parser.hpp"
 
 #include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/event.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <set>
 
 PHOSPHOR_LOG2_USING;
@@ -22,6 +24,13 @@ const std::set<std::string_view> supportedDbusPropertyTypes = {
     "bool",     "uint8_t", "int16_t",  "uint16_t", "int32_t",
     "uint32_t", "int64_t", "uint64_t", "double",   "string"};
 
+static uint64_t eventActionKey(const StateSensorEntry& entry)
+{
+    return (static_cast<uint64_t>(entry.entityType) << 40) |
+           (static_cast<uint64_t>(entry.entityInstance) << 24) |
+           (static_cast<uint64_t>(entry.stateSetid) << 8) | entry.sensorOffset;
+}
+
 StateSensorHandler::StateSensorHandler(const std::string& dirPath)
 {
     fs::path dir(dirPath);
@@ -100,6 +109,22 @@ StateSensorHandler::StateSensorHandler(const std::string& dirPath)
                 std::make_tuple(std::move(dbusInfo), std::move(eventStateMap)));
         }
     }
+
+    for (const auto& [entry, eventDBusInfo] : eventMap)
+    {
+        auto& actions = eventActions[eventActionKey(entry)];
+        if (entry.skipContainerId)
+        {
+            if (!actions.anyContainer)
+            {
+                actions.anyContainer = eventDBusInfo;
+            }
+        }
+        else
+        {
+            actions.byContainer.emplace(entry.containerId, eventDBusInfo);
+        }
+    }
 }
 
 StateToDBusValue StateSensorHandler::mapStateToDBusVal(
@@ -118,39 +143,79 @@ StateToDBusValue StateSensorHandler::mapStateToDBusVal(
     return eventStateMap;
 }
 
-int StateSensorHandler::eventAction(StateSensorEntry entry,
+int StateSensorHandler::eventAction(const StateSensorEntry& entry,
                                     pdr::EventState state)
 {
-    for (const auto& kv : eventMap)
+    // An entry configured without the container ID matches the sensor in
+    // any container and takes precedence over the container specific ones
+    auto actions = eventActions.find(eventActionKey(entry));
+    if (actions == eventActions.end())
     {
-        if (kv.first.skipContainerId &&
-            kv.first.entityType == entry.entityType &&
-            kv.first.entityInstance == entry.entityInstance &&
-            kv.first.stateSetid == entry.stateSetid &&
-            kv.first.sensorOffset == entry.sensorOffset)
-        {
-            entry.skipContainerId = true;
-            break;
-        }
+        // There is no BMC action for this PLDM event
+        return PLDM_SUCCESS;
     }
-    try
+
+    const EventDBusInfo* eventDBusInfo = nullptr;
+    if (actions->second.anyContainer)
     {
-        const auto& [dbusMapping, eventStateMap] = eventMap.at(entry);
-        utils::PropertyValue propValue{};
-        try
-        {
-            propValue = eventStateMap.at(state);
-        }
-        catch (const std::out_of_range& e)
-        {
-            error("Invalid event state '{EVENT_STATE}', error - {ERROR}",
-                  "EVENT_STATE", state, "ERROR", e);
-            return PLDM_ERROR_INVALID_DATA;
-        }
+        eventDBusInfo = &actions->second.anyContainer.value();
+    }
+    else if (auto it = actions->second.byContainer.find(entry.containerId);
+             it != actions->second.byContainer.end())
+    {
+        eventDBusInfo = &it->second;
+    }
+    if (!eventDBusInfo)
+    {
+        return PLDM_SUCCESS;
+    }
+
+    const auto& [dbusMapping, eventStateMap] = *eventDBusInfo;
+    auto propValue = eventStateMap.find(state);
+    if (propValue == eventStateMap.end())
+    {
+        error("Invalid event state '{EVENT_STATE}'", "EVENT_STATE", state);
+        return PLDM_ERROR_INVALID_DATA;
+    }
+
+    // A write to a property already pending replaces the value of that
+    // write, in its slot
+    auto key = std::make_tuple(dbusMapping.objectPath, dbusMapping.interface,
+                               dbusMapping.propertyName);
+    if (auto it = pendingWriteIndex.find(key); it != pendingWriteIndex.end())
+    {
+        pendingWrites[it->second].second = propValue->second;
+    }
+    else
+    {
+        pendingWriteIndex.emplace(std::move(key), pendingWrites.size());
+        pendingWrites.emplace_back(dbusMapping, propValue->second);
+    }
+
+    if (!writeEvent)
+    {
+        writeEvent = std::make_unique<sdeventplus::source::Defer>(
+            sdeventplus::Event::get_default(),
+            std::bind(std::mem_fn(&StateSensorHandler::processPendingWrites),
+                      this, std::placeholders::_1));
+    }
+
+    return PLDM_SUCCESS;
+}
+
+void StateSensorHandler::processPendingWrites(
+    sdeventplus::source::EventBase& /*source */)
+{
+    writeEvent.reset();
+    auto writes = std::move(pendingWrites);
+    pendingWrites.clear();
+    pendingWriteIndex.clear();
 
+    for (const auto& [dbusMapping, propValue] : writes)
+    {
         try
         {
-            pldm::utils::DBusHandler().setDbusProperty(dbusMapping, propValue);
+            writeProperty(dbusMapping, propValue);
         }
         catch (const std::exception& e)
         {
@@ -159,15 +224,15 @@ int StateSensorHandler::eventAction(StateSensorEntry entry,
                 "PROPERTY", dbusMapping.propertyName, "INTERFACE",
                 dbusMapping.interface, "PATH", dbusMapping.objectPath, "ERROR",
                 e);
-            return PLDM_ERROR;
         }
     }
-    catch (const std::out_of_range&)
-    {
-        // There is no BMC action for this PLDM event
-        return PLDM_SUCCESS;
-    }
-    return PLDM_SUCCESS;
+}
+
+void StateSensorHandler::writeProperty(
+    const pldm::utils::DBusMapping& dbusMapping,
+    const pldm::utils::PropertyValue& value)
+{
+    pldm::utils::DBusHandler().setDbusProperty(dbusMapping, value);
 }
 
 } // namespace pldm::responder::events
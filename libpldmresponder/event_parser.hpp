@@ -4,11 +4,15 @@
 #include "common/utils.hpp"
 
 #include <nlohmann/json.hpp>
+#include <sdeventplus/source/event.hpp>
 
 #include <filesystem>
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace pldm::responder::events
@@ -73,6 +77,23 @@ using EventDBusInfo = std::tuple<pldm::utils::DBusMapping, StateToDBusValue>;
 using EventMap = std::map<StateSensorEntry, EventDBusInfo>;
 using Json = nlohmann::json;
 
+/** @struct EventActions
+ *
+ *  Second level of the event action table, the D-Bus information of a state
+ *  sensor with and without the container ID.
+ */
+struct EventActions
+{
+    std::optional<EventDBusInfo> anyContainer; //!< entry without container ID
+    std::unordered_map<pdr::ContainerID, EventDBusInfo>
+        byContainer;                           //!< entries by container ID
+};
+
+/** @brief First level of the event action table, keyed by entity type,
+ *         entity instance, state set ID and sensor offset
+ */
+using EventActionTable = std::unordered_map<uint64_t, EventActions>;
+
 /** @class StateSensorHandler
  *
  *  @brief Parses the event state sensor configuration JSON file and build
@@ -92,21 +113,26 @@ class StateSensorHandler
      */
     explicit StateSensorHandler(const std::string& dirPath);
     virtual ~StateSensorHandler() = default;
-    StateSensorHandler(const StateSensorHandler&) = default;
-    StateSensorHandler& operator=(const StateSensorHandler&) = default;
-    StateSensorHandler(StateSensorHandler&&) = default;
-    StateSensorHandler& operator=(StateSensorHandler&&) = default;
+    StateSensorHandler(const StateSensorHandler&) = delete;
+    StateSensorHandler& operator=(const StateSensorHandler&) = delete;
+    StateSensorHandler(StateSensorHandler&&) = delete;
+    StateSensorHandler& operator=(StateSensorHandler&&) = delete;
 
     /** @brief If the StateSensorEntry and EventState is valid, the D-Bus
-     *         property corresponding to the StateSensorEntry is set based on
-     *         the EventState
+     *         property corresponding to the StateSensorEntry is queued to be
+     *         set based on the EventState. The queued writes are sent from
+     *         the event loop in arrival order, the writes to a property still
+     *         pending are coalesced into the latest value. The coalesced
+     *         write keeps the slot of the first pending write to the
+     *         property, it is sent ahead of the writes to other properties
+     *         queued in between.
      *
      *  @param[in] entry - state sensor entry
      *  @param[in] state - event state
      *
      *  @return PLDM completion code
      */
-    int eventAction(StateSensorEntry entry, pdr::EventState state);
+    int eventAction(const StateSensorEntry& entry, pdr::EventState state);
 
     /** @brief Helper API to get D-Bus information for a StateSensorEntry
      *
@@ -119,9 +145,44 @@ class StateSensorHandler
         return eventMap.at(entry);
     }
 
+  protected:
+    /** @brief Set a D-Bus property
+     *
+     *  @param[in] dbusMapping - the D-Bus property
+     *  @param[in] value - the value to set
+     *
+     *  @throw std::exception if the property can't be set
+     */
+    virtual void writeProperty(const pldm::utils::DBusMapping& dbusMapping,
+                               const pldm::utils::PropertyValue& value);
+
   private:
     EventMap eventMap; //!< a map of StateSensorEntry to D-Bus information
 
+    /** @brief event action table built from eventMap */
+    EventActionTable eventActions;
+
+    /** @brief D-Bus property writes waiting to be sent, in the arrival order
+     *         of the first write to each property
+     */
+    std::vector<std::pair<pldm::utils::DBusMapping, pldm::utils::PropertyValue>>
+        pendingWrites;
+
+    /** @brief index of the pending write of a D-Bus property, keyed by the
+     *         object path, interface and property name
+     */
+    std::map<std::tuple<std::string, std::string, std::string>, size_t>
+        pendingWriteIndex;
+
+    /** @brief event source sending the pending writes */
+    std::unique_ptr<sdeventplus::source::Defer> writeEvent;
+
+    /** @brief Send the pending D-Bus property writes
+     *
+     *  @param[in] source - sdeventplus event source
+     */
+    void processPendingWrites(sdeventplus::source::EventBase& source);
+
     /** @brief Create a map of EventState to D-Bus property values from
      *         the information provided in the event state configuration
      *         JSON
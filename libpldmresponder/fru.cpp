@@ -79,8 +79,7 @@ void FruImpl::updateAssociationTree(const dbus::ObjectValueTree& objects,
             {
                 pldm_entity node =
                     pldm_entity_extract(objToEntityNode.at(currPath));
-                if (pldm_entity_association_tree_find_with_locality(
-                        entityTree, &node, false))
+                if (entityTreeIndex.find(node, false))
                 {
                     break;
                 }
@@ -113,8 +112,8 @@ void FruImpl::updateAssociationTree(const dbus::ObjectValueTree& objects,
 
                 if (currPath == prePath)
                 {
-                    auto node = pldm_entity_association_tree_add_entity(
-                        entityTree, &entity, 0xFFFF, nullptr,
+                    auto node = entityTreeIndex.addEntity(
+                        entity, 0xFFFF, nullptr,
                         PLDM_ENTITY_ASSOCIAION_PHYSICAL, false, true, 0xFFFF);
                     objToEntityNode[currPath] = node;
                 }
@@ -122,9 +121,8 @@ void FruImpl::updateAssociationTree(const dbus::ObjectValueTree& objects,
                 {
                     if (objToEntityNode.contains(prePath))
                     {
-                        auto node = pldm_entity_association_tree_add_entity(
-                            entityTree, &entity, 0xFFFF,
-                            objToEntityNode[prePath],
+                        auto node = entityTreeIndex.addEntity(
+                            entity, 0xFFFF, objToEntityNode[prePath],
                             PLDM_ENTITY_ASSOCIAION_PHYSICAL, false, true,
                             0xFFFF);
                         objToEntityNode[currPath] = node;
@@ -144,13 +142,36 @@ void FruImpl::buildFRUTable()
         return;
     }
 
+    dbus::ObjectValueTree inventory;
+
+    try
+    {
+        inventory = pldm::utils::DBusHandler::getInventoryObjects<
+            pldm::utils::DBusHandler>();
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to build FRU table due to inventory lookup, error - {ERROR}",
+            "ERROR", e);
+        return;
+    }
+
+    buildFRUTable(std::move(inventory));
+}
+
+void FruImpl::buildFRUTable(dbus::ObjectValueTree inventory)
+{
+    if (isBuilt)
+    {
+        return;
+    }
+
     fru_parser::DBusLookupInfo dbusInfo;
 
     try
     {
         dbusInfo = parser.inventoryLookup();
-        objects = pldm::utils::DBusHandler::getInventoryObjects<
-            pldm::utils::DBusHandler>();
     }
     catch (const std::exception& e)
     {
@@ -159,6 +180,7 @@ void FruImpl::buildFRUTable()
             "ERROR", e);
         return;
     }
+    objects = std::move(inventory);
 
     auto itemIntfsLookup = std::get<2>(dbusInfo);
 
@@ -169,8 +191,15 @@ void FruImpl::buildFRUTable()
         {
             if (itemIntfsLookup.contains(interface.first))
             {
-                // checking fru present property is available or not.
-                if (!pldm::utils::checkForFruPresence(object.first.str))
+                // The Present property comes along with the inventory
+                // objects, it is read from D-Bus only if they don't carry it
+                auto present = pldm::utils::getFruPresence(interfaces);
+                if (!present)
+                {
+                    present =
+                        pldm::utils::checkForFruPresence(object.first.str);
+                }
+                if (!*present)
                 {
                     continue;
                 }
@@ -216,6 +245,7 @@ void FruImpl::buildFRUTable()
               "RC", rc);
         throw std::runtime_error("Failed to add PLDM entity association PDR");
     }
+    pdr_utils::repoModified(pdrRepo);
 
     // save a copy of bmc's entity association tree
     pldm_entity_association_tree_copy_root(entityTree, bmcEntityTree);
@@ -332,12 +362,16 @@ void FruImpl::populateRecords(
                     throw std::runtime_error(
                         "Failed to add PDR FRU record set");
                 }
+                pdr_utils::repoModified(pdrRepo);
             }
             auto curSize = table.size();
+            auto recordOffset = curSize;
             table.resize(curSize + recHeaderSize + tlvs.size());
             encode_fru_record(table.data(), table.size(), &curSize,
                               recordSetIdentifier, recType, numFRUFields,
                               encType, tlvs.data(), tlvs.size());
+            recordIndex.add(recordSetIdentifier, recType, recordOffset,
+                            curSize - recordOffset);
             numRecs++;
         }
     }
@@ -395,30 +429,20 @@ int FruImpl::getFRURecordByOption(std::vector<uint8_t>& fruData,
     // FRU table is built lazily, build if not done.
     buildFRUTable();
 
-    /* 7 is sizeof(checksum,4) + padBytesMax(3)
-     * We can not know size of the record table got by options in advance, but
-     * it must be less than the source table. So it's safe to use sizeof the
-     * source table + 7 as the buffer length
-     */
-    size_t recordTableSize = table.size() - padBytes + 7;
-    fruData.resize(recordTableSize, 0);
-
-    int rc = get_fru_record_by_option_check(
-        table.data(), table.size(), fruData.data(), &recordTableSize,
-        recordSetIdentifer, recordType, fieldType);
-
-    if (rc != PLDM_SUCCESS || recordTableSize == 0)
+    fruData.clear();
+    if (!recordIndex.copyRecords(table, recordSetIdentifer, recordType,
+                                 fieldType, fruData))
     {
         return PLDM_FRU_DATA_STRUCTURE_TABLE_UNAVAILABLE;
     }
 
+    auto recordTableSize = fruData.size();
     auto pads = pldm::utils::getNumPadBytes(recordTableSize);
-    crc32(fruData.data(), recordTableSize + pads);
+    fruData.resize(recordTableSize + pads, 0);
+    sum recordChecksum = crc32(fruData.data(), fruData.size());
 
-    auto iter = fruData.begin() + recordTableSize + pads;
-    std::copy_n(reinterpret_cast<const uint8_t*>(&checksum), sizeof(checksum),
-                iter);
-    fruData.resize(recordTableSize + pads + sizeof(sum));
+    std::copy_n(reinterpret_cast<const uint8_t*>(&recordChecksum),
+                sizeof(recordChecksum), std::back_inserter(fruData));
 
     return PLDM_SUCCESS;
 }
@@ -534,14 +558,44 @@ Response Handler::getFRURecordByOption(const pldm_msg* request,
         return ccOnlyResponse(request, rc);
     }
 
+    // The record data is sent in parts of up to maxPartSize bytes, the data
+    // transfer handle of a part is its offset in the data
+    size_t offset = 0;
+    if (retTransferOpFlag == PLDM_GET_NEXTPART)
+    {
+        offset = retDataTransferHandle;
+    }
+    if (offset >= fruData.size())
+    {
+        return ccOnlyResponse(request, PLDM_FRU_INVALID_DATA_TRANSFER_HANDLE);
+    }
+
+    auto partSize = fruData.size() - offset;
+    if (maxPartSize && partSize > maxPartSize)
+    {
+        partSize = maxPartSize;
+    }
+    bool lastPart = offset + partSize == fruData.size();
+    uint32_t nextDataTransferHandle = lastPart ? 0 : offset + partSize;
+    uint8_t transferFlag = PLDM_START_AND_END;
+    if (!offset && !lastPart)
+    {
+        transferFlag = PLDM_START;
+    }
+    else if (offset)
+    {
+        transferFlag = lastPart ? PLDM_END : PLDM_MIDDLE;
+    }
+
     auto respPayloadLength = PLDM_GET_FRU_RECORD_BY_OPTION_MIN_RESP_BYTES +
-                             fruData.size();
+                             partSize;
     Response response(sizeof(pldm_msg_hdr) + respPayloadLength, 0);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_get_fru_record_by_option_resp(
-        request->hdr.instance_id, PLDM_SUCCESS, 0, PLDM_START_AND_END,
-        fruData.data(), fruData.size(), responsePtr, respPayloadLength);
+        request->hdr.instance_id, PLDM_SUCCESS, nextDataTransferHandle,
+        transferFlag, fruData.data() + offset, partSize, responsePtr,
+        respPayloadLength);
 
     if (rc != PLDM_SUCCESS)
     {
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "entity_association_tree.hpp"
 #include "fru_parser.hpp"
+#include "fru_record_index.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
 #include "oem_handler.hpp"
 #include "pldmd/handler.hpp"
@@ -70,7 +72,7 @@ class FruImpl
             pldm::responder::oem_fru::Handler* oemFruHandler) :
         parser(configPath, fruMasterJsonPath),
         pdrRepo(pdrRepo), entityTree(entityTree), bmcEntityTree(bmcEntityTree),
-        oemFruHandler(oemFruHandler)
+        entityTreeIndex(entityTree), oemFruHandler(oemFruHandler)
     {}
 
     /** @brief Total length of the FRU table in bytes, this includes the pad
@@ -123,7 +125,8 @@ class FruImpl
 
     /** @brief Get FRU Record Table By Option
      *  @param[out] response - Populate response with the FRU table got by
-     *                         options
+     *                         options, copied out of the table through the
+     *                         record index
      *  @param[in] fruTableHandle - The fru table handle
      *  @param[in] recordSetIdentifer - The record set identifier
      *  @param[in] recordType - The record type
@@ -139,6 +142,14 @@ class FruImpl
      */
     void buildFRUTable();
 
+    /** @brief Build the FRU table from the objects of the inventory namespace
+     *         already looked up, based on the config files for FRU. The table
+     *         is populated based on the isBuilt flag.
+     *
+     *  @param[in] inventory - the objects of the D-Bus inventory namespace
+     */
+    void buildFRUTable(dbus::ObjectValueTree inventory);
+
     /** @brief Get std::map associated with the entity
      *         key: object path
      *         value: pldm_entity
@@ -217,6 +228,7 @@ class FruImpl
     uint16_t numRecs = 0;
     uint8_t padBytes = 0;
     std::vector<uint8_t> table;
+    FruRecordIndex recordIndex;
     uint32_t checksum = 0;
     bool isBuilt = false;
 
@@ -224,6 +236,7 @@ class FruImpl
     pldm_pdr* pdrRepo;
     pldm_entity_association_tree* entityTree;
     pldm_entity_association_tree* bmcEntityTree;
+    pdr_utils::EntityAssociationTree entityTreeIndex;
     pldm::responder::oem_fru::Handler* oemFruHandler;
     dbus::ObjectValueTree objects;
 
@@ -256,9 +269,11 @@ class Handler : public CmdHandler
             const std::filesystem::path& fruMasterJsonPath, pldm_pdr* pdrRepo,
             pldm_entity_association_tree* entityTree,
             pldm_entity_association_tree* bmcEntityTree,
-            pldm::responder::oem_fru::Handler* oemFruHandler) :
+            pldm::responder::oem_fru::Handler* oemFruHandler,
+            size_t maxPartSize = FRU_RECORD_BY_OPTION_PART_SIZE) :
         impl(configPath, fruMasterJsonPath, pdrRepo, entityTree, bmcEntityTree,
-             oemFruHandler)
+             oemFruHandler),
+        maxPartSize(maxPartSize)
     {
         handlers.emplace(
             PLDM_GET_FRU_RECORD_TABLE_METADATA,
@@ -309,6 +324,15 @@ class Handler : public CmdHandler
         impl.buildFRUTable();
     }
 
+    /** @brief Build FRU table from the inventory objects if not already built
+     *
+     *  @param[in] inventory - the objects of the D-Bus inventory namespace
+     */
+    void buildFRUTable(dbus::ObjectValueTree inventory)
+    {
+        impl.buildFRUTable(std::move(inventory));
+    }
+
     /** @brief Get std::map associated with the entity
      *         key: object path
      *         value: pldm_entity
@@ -344,6 +368,11 @@ class Handler : public CmdHandler
 
   private:
     FruImpl impl;
+
+    /** @brief size of the parts GetFRURecordByOption sends the record data
+     *         in, 0 to send it in a single part
+     */
+    size_t maxPartSize;
 };
 
 } // namespace fru
@@ -0,0 +1,96 @@
+#include "fru_record_index.hpp"
+
+#include <libpldm/fru.h>
+
+#include <cstddef>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+void FruRecordIndex::add(uint16_t recordSetId, uint8_t recordType,
+                         size_t offset, size_t length)
+{
+    recordSets[recordSetId].emplace_back(records.size());
+    records.emplace_back(Record{recordSetId, recordType, offset, length});
+}
+
+size_t FruRecordIndex::copyRecords(std::span<const uint8_t> table,
+                                   uint16_t recordSetId, uint8_t recordType,
+                                   uint8_t fieldType,
+                                   std::vector<uint8_t>& recordData) const
+{
+    size_t count = 0;
+    auto copy = [&](const Record& record) {
+        if (recordType && record.recordType != recordType)
+        {
+            return;
+        }
+        copyRecord(table.subspan(record.offset, record.length), fieldType,
+                   recordData);
+        count++;
+    };
+
+    if (!recordSetId)
+    {
+        for (const auto& record : records)
+        {
+            copy(record);
+        }
+        return count;
+    }
+
+    auto it = recordSets.find(recordSetId);
+    if (it == recordSets.end())
+    {
+        return count;
+    }
+    for (auto pos : it->second)
+    {
+        copy(records[pos]);
+    }
+    return count;
+}
+
+void FruRecordIndex::copyRecord(std::span<const uint8_t> record,
+                                uint8_t fieldType,
+                                std::vector<uint8_t>& recordData)
+{
+    constexpr size_t headerSize = offsetof(pldm_fru_record_data_format, tlvs);
+    constexpr size_t tlvHeaderSize = offsetof(pldm_fru_record_tlv, value);
+
+    if (!fieldType)
+    {
+        recordData.insert(recordData.end(), record.begin(), record.end());
+        return;
+    }
+
+    auto header = recordData.size();
+    recordData.insert(recordData.end(), record.begin(),
+                      record.begin() + headerSize);
+    uint8_t numFields = 0;
+    for (size_t pos = headerSize; pos + tlvHeaderSize <= record.size();)
+    {
+        auto fieldLength = tlvHeaderSize +
+                           record[pos + offsetof(pldm_fru_record_tlv, length)];
+        if (pos + fieldLength > record.size())
+        {
+            break;
+        }
+        if (record[pos + offsetof(pldm_fru_record_tlv, type)] == fieldType)
+        {
+            recordData.insert(recordData.end(), record.begin() + pos,
+                              record.begin() + pos + fieldLength);
+            numFields++;
+        }
+        pos += fieldLength;
+    }
+    recordData[header + offsetof(pldm_fru_record_data_format, num_fru_fields)] =
+        numFields;
+}
+
+} // namespace responder
+
+} // namespace pldm
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <vector>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+/** @class FruRecordIndex
+ *
+ *  @brief Index of the records of the FRU table, keyed by FRU record set
+ *         identifier. It is maintained as records are appended to the FRU
+ *         table, so that GetFRURecordByOption copies the byte ranges of the
+ *         matching records instead of walking the whole table.
+ */
+class FruRecordIndex
+{
+  public:
+    /** @brief Index a record appended to the FRU table
+     *
+     *  @param[in] recordSetId - FRU record set identifier of the record
+     *  @param[in] recordType - FRU record type of the record
+     *  @param[in] offset - offset of the record in the FRU table
+     *  @param[in] length - length of the record in bytes
+     */
+    void add(uint16_t recordSetId, uint8_t recordType, size_t offset,
+             size_t length);
+
+    /** @brief Copy the records matching the options out of the FRU table, in
+     *         the layout of the FRU record table data of GetFRURecordByOption
+     *
+     *  @param[in] table - FRU table the index was maintained along
+     *  @param[in] recordSetId - FRU record set identifier, 0 for any
+     *  @param[in] recordType - FRU record type, 0 for any
+     *  @param[in] fieldType - FRU field type, 0 for any
+     *  @param[out] recordData - the matching records are appended to it,
+     *                           along with the matching fields only if a
+     *                           field type is given
+     *
+     *  @return number of records copied
+     */
+    size_t copyRecords(std::span<const uint8_t> table, uint16_t recordSetId,
+                       uint8_t recordType, uint8_t fieldType,
+                       std::vector<uint8_t>& recordData) const;
+
+  private:
+    struct Record
+    {
+        uint16_t recordSetId;
+        uint8_t recordType;
+        size_t offset;
+        size_t length;
+    };
+
+    /** @brief Copy a record, with the fields of a type only if one is given
+     *
+     *  @param[in] record - the record in the FRU table
+     *  @param[in] fieldType - FRU field type, 0 for any
+     *  @param[out] recordData - the record is appended to it
+     */
+    static void copyRecord(std::span<const uint8_t> record, uint8_t fieldType,
+                           std::vector<uint8_t>& recordData);
+
+    /** @brief records of the FRU table, in the order of the table */
+    std::vector<Record> records;
+
+    /** @brief positions in records of the records of a FRU record set */
+    std::map<uint16_t, std::vector<size_t>> recordSets;
+};
+
+} // namespace responder
+
+} // namespace pldm
@@ -0,0 +1,138 @@
+#include "numeric_effecter_cache.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+namespace platform_numeric_effecter
+{
+
+const NumericEffecterValueCache::Entry*
+    NumericEffecterValueCache::find(uint16_t effecterId) const
+{
+    auto it = entries.find(effecterId);
+    if (it == entries.end() || !it->second.value)
+    {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+bool NumericEffecterValueCache::subscribe(
+    uint16_t effecterId, const pldm::utils::DBusMapping& dbusMapping,
+    const std::string& service)
+{
+    if (matches.contains(effecterId))
+    {
+        return true;
+    }
+
+    try
+    {
+        matches.emplace(effecterId, watch(effecterId, dbusMapping, service));
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to watch property '{PROPERTY}' of numeric effecter ID '{EFFECTERID}' at path '{PATH}', error - {ERROR}",
+            "PROPERTY", dbusMapping.propertyName, "EFFECTERID", effecterId,
+            "PATH", dbusMapping.objectPath, "ERROR", e);
+        return false;
+    }
+    return true;
+}
+
+void NumericEffecterValueCache::update(uint16_t effecterId,
+                                       uint8_t effecterDataSize,
+                                       const std::string& propertyType,
+                                       const pldm::utils::PropertyValue& value)
+{
+    if (!matches.contains(effecterId))
+    {
+        return;
+    }
+
+    entries.insert_or_assign(effecterId,
+                             Entry{effecterDataSize, propertyType, value});
+}
+
+void NumericEffecterValueCache::invalidate(uint16_t effecterId)
+{
+    if (auto it = entries.find(effecterId); it != entries.end())
+    {
+        it->second.value.reset();
+    }
+}
+
+std::vector<std::unique_ptr<sdbusplus::bus::match_t>>
+    NumericEffecterValueCache::watch(
+        uint16_t effecterId, const pldm::utils::DBusMapping& dbusMapping,
+        const std::string& service)
+{
+    using namespace sdbusplus::bus::match::rules;
+
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> effecterMatches;
+    effecterMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, propertiesChanged(dbusMapping.objectPath, dbusMapping.interface),
+        [this, effecterId, propertyName = dbusMapping.propertyName](
+            sdbusplus::message_t& msg) {
+        pldm::utils::DbusChangedProps props{};
+        std::string intf;
+        msg.read(intf, props);
+        onPropertiesChanged(effecterId, propertyName, props);
+    }));
+    effecterMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, interfacesRemovedAtPath(dbusMapping.objectPath),
+        [this, effecterId,
+         interface = dbusMapping.interface](sdbusplus::message_t& msg) {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        msg.read(path, interfaces);
+        onInterfacesRemoved(effecterId, interface, interfaces);
+    }));
+    if (!service.empty())
+    {
+        // The value is unknown while the service restarts, it is read
+        // from D-Bus again once it is back
+        effecterMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            bus, nameOwnerChanged(service),
+            [this, effecterId](sdbusplus::message_t& /*msg*/) {
+            invalidate(effecterId);
+        }));
+    }
+    return effecterMatches;
+}
+
+void NumericEffecterValueCache::onPropertiesChanged(
+    uint16_t effecterId, const std::string& propertyName,
+    const pldm::utils::DbusChangedProps& props)
+{
+    auto prop = props.find(propertyName);
+    auto entry = entries.find(effecterId);
+    if (prop != props.end() && entry != entries.end())
+    {
+        entry->second.value = prop->second;
+    }
+}
+
+void NumericEffecterValueCache::onInterfacesRemoved(
+    uint16_t effecterId, const std::string& interface,
+    const std::vector<std::string>& interfaces)
+{
+    if (std::ranges::find(interfaces, interface) != interfaces.end())
+    {
+        invalidate(effecterId);
+    }
+}
+
+} // namespace platform_numeric_effecter
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "common/utils.hpp"
+
+#include <sdbusplus/bus/match.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+namespace platform_numeric_effecter
+{
+
+/** @class NumericEffecterValueCache
+ *
+ *  @brief Caches the D-Bus values backing the numeric effecters so that
+ *         GetNumericEffecterValue is served from memory. The D-Bus property
+ *         of an effecter is subscribed to ahead of its first read, the cached
+ *         value is then kept up to date from the PropertiesChanged signals. The
+ *         value is dropped when the interface is removed or the owner of the
+ *         object changes, the next read then goes to D-Bus.
+ */
+class NumericEffecterValueCache
+{
+  public:
+    struct Entry
+    {
+        uint8_t effecterDataSize;                        //!< effecter data size
+        std::string propertyType;                        //!< D-Bus type
+        std::optional<pldm::utils::PropertyValue> value; //!< present value
+    };
+
+    NumericEffecterValueCache() = default;
+    NumericEffecterValueCache(const NumericEffecterValueCache&) = delete;
+    NumericEffecterValueCache&
+        operator=(const NumericEffecterValueCache&) = delete;
+    virtual ~NumericEffecterValueCache() = default;
+
+    /** @brief Find the cached value of an effecter
+     *
+     *  @param[in] effecterId - effecter ID
+     *
+     *  @return pointer to the entry, nullptr if the cache is cold
+     */
+    const Entry* find(uint16_t effecterId) const;
+
+    /** @brief Subscribe to the changes of the D-Bus property backing an
+     *         effecter, to be done ahead of reading it so that no change is
+     *         missed in between
+     *
+     *  @param[in] effecterId - effecter ID
+     *  @param[in] dbusMapping - D-Bus property backing the effecter
+     *  @param[in] service - D-Bus service hosting the property
+     *
+     *  @return true if the subscription is in place
+     */
+    bool subscribe(uint16_t effecterId,
+                   const pldm::utils::DBusMapping& dbusMapping,
+                   const std::string& service);
+
+    /** @brief Store the value read from D-Bus, the value is only kept if the
+     *         effecter is subscribed to
+     *
+     *  @param[in] effecterId - effecter ID
+     *  @param[in] effecterDataSize - effecter data size from the PDR
+     *  @param[in] propertyType - D-Bus type of the property
+     *  @param[in] value - value read from D-Bus
+     */
+    void update(uint16_t effecterId, uint8_t effecterDataSize,
+                const std::string& propertyType,
+                const pldm::utils::PropertyValue& value);
+
+    /** @brief Drop the cached value of an effecter, the next read goes to
+     *         D-Bus
+     *
+     *  @param[in] effecterId - effecter ID
+     */
+    void invalidate(uint16_t effecterId);
+
+  protected:
+    /** @brief Subscribe to the PropertiesChanged and InterfacesRemoved
+     *         signals of the effecter's object and to the owner changes of
+     *         its service
+     *
+     *  @param[in] effecterId - effecter ID
+     *  @param[in] dbusMapping - D-Bus property backing the effecter
+     *  @param[in] service - D-Bus service hosting the property
+     *
+     *  @return the matches of the signals
+     *
+     *  @throw std::exception if the subscription fails
+     */
+    virtual std::vector<std::unique_ptr<sdbusplus::bus::match_t>>
+        watch(uint16_t effecterId, const pldm::utils::DBusMapping& dbusMapping,
+              const std::string& service);
+
+    /** @brief Update the cached value from a PropertiesChanged signal
+     *
+     *  @param[in] effecterId - effecter ID
+     *  @param[in] propertyName - D-Bus property backing the effecter
+     *  @param[in] props - the changed properties
+     */
+    void onPropertiesChanged(uint16_t effecterId,
+                             const std::string& propertyName,
+                             const pldm::utils::DbusChangedProps& props);
+
+    /** @brief Drop the cached value if an InterfacesRemoved signal removes
+     *         the interface backing the effecter
+     *
+     *  @param[in] effecterId - effecter ID
+     *  @param[in] interface - D-Bus interface backing the effecter
+     *  @param[in] interfaces - the removed interfaces
+     */
+    void onInterfacesRemoved(uint16_t effecterId, const std::string& interface,
+                             const std::vector<std::string>& interfaces);
+
+  private:
+    /** @brief cached values keyed by effecter ID */
+    std::unordered_map<uint16_t, Entry> entries;
+
+    /** @brief signal matches keyed by effecter ID */
+    std::unordered_map<uint16_t,
+                       std::vector<std::unique_ptr<sdbusplus::bus::match_t>>>
+        matches;
+};
+
+} // namespace platform_numeric_effecter
+} // namespace responder
+} // namespace pldm
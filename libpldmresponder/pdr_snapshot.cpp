@@ -0,0 +1,113 @@
+#include "pdr_snapshot.hpp"
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace pdr
+{
+using namespace pldm::responder::pdr_utils;
+
+RepoSnapshot::RepoSnapshot(const pldm_pdr* repo, uint64_t generation) :
+    generation(generation)
+{
+    records.reserve(pldm_pdr_get_record_count(repo));
+
+    uint8_t* pdrData = nullptr;
+    uint32_t pdrSize{};
+    uint32_t nextRecordHandle{};
+    auto record = pldm_pdr_find_record(repo, 0, &pdrData, &pdrSize,
+                                       &nextRecordHandle);
+    while (record)
+    {
+        auto recordHandle = pldm_pdr_get_record_handle(repo, record);
+        index.emplace(recordHandle, records.size());
+        records.emplace_back(
+            recordHandle, nextRecordHandle,
+            std::vector<uint8_t>(pdrData, pdrData + pdrSize));
+
+        pdrData = nullptr;
+        pdrSize = 0;
+        record = pldm_pdr_get_next_record(repo, record, &pdrData, &pdrSize,
+                                          &nextRecordHandle);
+    }
+}
+
+const RepoSnapshot::Record* RepoSnapshot::find(RecordHandle recordHandle) const
+{
+    if (!recordHandle)
+    {
+        return records.empty() ? nullptr : &records.front();
+    }
+
+    auto it = index.find(recordHandle);
+    if (it == index.end())
+    {
+        return nullptr;
+    }
+
+    return &records[it->second];
+}
+
+std::shared_ptr<const RepoSnapshot> RepoSnapshots::current()
+{
+    auto generation = getGeneration();
+    if (!latest || latest->getGeneration() != generation)
+    {
+        latest = std::make_shared<const RepoSnapshot>(repo, generation);
+    }
+
+    return latest;
+}
+
+std::shared_ptr<const RepoSnapshot::Record>
+    RepoSnapshots::getRecord(pldm_tid_t tid, RecordHandle recordHandle)
+{
+    std::shared_ptr<const RepoSnapshot> snapshot{};
+    const RepoSnapshot::Record* record = nullptr;
+
+    if (!recordHandle)
+    {
+        // Start of a walk, pin the latest generation for this requester
+        snapshot = current();
+        walks.insert_or_assign(tid, snapshot);
+        record = snapshot->find(recordHandle);
+    }
+    else if (auto it = walks.find(tid); it != walks.end())
+    {
+        snapshot = it->second;
+        record = snapshot->find(recordHandle);
+        if (!record)
+        {
+            // The requester jumped to a handle that is not part of the
+            // pinned generation, serve it from the latest one instead.
+            walks.erase(it);
+        }
+    }
+
+    if (!record)
+    {
+        snapshot = current();
+        record = snapshot->find(recordHandle);
+    }
+
+    if (record && !record->nextRecordHandle)
+    {
+        // End of the walk, the generation is reclaimed once no other walk
+        // or lookup holds a reference to it.
+        walks.erase(tid);
+    }
+
+    if (!record)
+    {
+        return nullptr;
+    }
+
+    return std::shared_ptr<const RepoSnapshot::Record>(snapshot, record);
+}
+
+} // namespace pdr
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "libpldmresponder/pdr_utils.hpp"
+
+#include <libpldm/base.h>
+#include <libpldm/pdr.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace pdr
+{
+
+/** @class RepoSnapshot
+ *
+ *  @brief Immutable copy of the PDR repository taken at one generation. A
+ *         GetPDR walk pins a snapshot so that the records and the
+ *         nextRecordHandle chain it observes stay consistent while the live
+ *         repository is being modified.
+ */
+class RepoSnapshot
+{
+  public:
+    struct Record
+    {
+        pldm::responder::pdr_utils::RecordHandle recordHandle;
+        pldm::responder::pdr_utils::RecordHandle nextRecordHandle;
+        std::vector<uint8_t> data;
+    };
+
+    /** @brief Copy all the records of a PDR repository
+     *
+     *  @param[in] repo - the live PDR repository
+     *  @param[in] generation - generation number of the snapshot
+     */
+    RepoSnapshot(const pldm_pdr* repo, uint64_t generation);
+
+    /** @brief Find a record by record handle, 0 being the first record
+     *
+     *  @param[in] recordHandle - record handle to look up
+     *
+     *  @return pointer to the record, nullptr if not found
+     */
+    const Record*
+        find(pldm::responder::pdr_utils::RecordHandle recordHandle) const;
+
+    /** @brief Get the generation this snapshot was taken at
+     */
+    uint64_t getGeneration() const
+    {
+        return generation;
+    }
+
+    /** @brief Get the number of records in the snapshot
+     */
+    uint32_t getRecordCount() const
+    {
+        return records.size();
+    }
+
+  private:
+    uint64_t generation;
+    std::vector<Record> records;
+    std::unordered_map<pldm::responder::pdr_utils::RecordHandle, size_t>
+        index;
+};
+
+/** @class RepoSnapshots
+ *
+ *  @brief Copy-on-write generations of the BMC PDR repository. Writers
+ *         bump the generation of the repository through
+ *         pdr_utils::repoModified() after mutating it and the next reader
+ *         materialises it, while walks still holding an older generation
+ *         keep it alive until they drop their reference.
+ */
+class RepoSnapshots
+{
+  public:
+    RepoSnapshots() = delete;
+    RepoSnapshots(const RepoSnapshots&) = delete;
+    RepoSnapshots& operator=(const RepoSnapshots&) = delete;
+
+    /** @brief Track the generation of the repository
+     *
+     *  @param[in] repo - the live PDR repository
+     */
+    explicit RepoSnapshots(const pldm_pdr* repo) : repo(repo)
+    {
+        pldm::responder::pdr_utils::trackRepoGeneration(repo);
+    }
+
+    ~RepoSnapshots()
+    {
+        pldm::responder::pdr_utils::untrackRepoGeneration(repo);
+    }
+
+    /** @brief Mark the live repository as modified, the next lookup will
+     *         copy it into a new generation
+     */
+    void publish()
+    {
+        pldm::responder::pdr_utils::repoModified(repo);
+    }
+
+    /** @brief Get the snapshot of the latest generation, materialising it if
+     *         the repository changed since the last copy
+     *
+     *  @return shared snapshot of the repository
+     */
+    std::shared_ptr<const RepoSnapshot> current();
+
+    /** @brief Look up a record on behalf of a GetPDR requester. A walk
+     *         starting at record handle 0 pins the current generation for
+     *         the terminus, follow-up requests are served from the pinned
+     *         generation and the pin is dropped once the walk ends.
+     *
+     *  @param[in] tid - terminus ID of the requester
+     *  @param[in] recordHandle - requested record handle
+     *
+     *  @return the record, sharing ownership of the snapshot it belongs to;
+     *          nullptr if not found
+     */
+    std::shared_ptr<const RepoSnapshot::Record>
+        getRecord(pldm_tid_t tid,
+                  pldm::responder::pdr_utils::RecordHandle recordHandle);
+
+    /** @brief Get the latest published generation number
+     */
+    uint64_t getGeneration() const
+    {
+        return pldm::responder::pdr_utils::getRepoGeneration(repo);
+    }
+
+  private:
+    /** @brief the live PDR repository */
+    const pldm_pdr* repo;
+
+    /** @brief snapshot of the latest materialised generation */
+    std::shared_ptr<const RepoSnapshot> latest;
+
+    /** @brief generations pinned by in-progress GetPDR walks */
+    std::map<pldm_tid_t, std::shared_ptr<const RepoSnapshot>> walks;
+};
+
+} // namespace pdr
+} // namespace responder
+} // namespace pldm
@@ -7,6 +7,7 @@
 
 #include <bitset>
 #include <climits>
+#include <unordered_map>
 
 PHOSPHOR_LOG2_USING;
 
@@ -42,6 +43,7 @@ RecordHandle Repo::addRecord(const PdrEntry& pdrEntry)
         // pldm_pdr_add() assert()ed on failure to add PDR
         throw std::runtime_error("Failed to add PDR");
     }
+    repoModified(repo);
     return handle;
 }
 
@@ -319,6 +321,114 @@ std::vector<uint8_t> fetchBitMap(const std::vector<std::vector<uint8_t>>& pdrs)
     return bitMap;
 }
 
+std::vector<std::vector<uint8_t>> removeRemotePDRs(
+    pldm_pdr* repo,
+    const std::function<bool(RecordHandle, pldm::pdr::TerminusHandle)>&
+        remove)
+{
+    struct RemoteRecord
+    {
+        RecordHandle recordHandle;
+        pldm::pdr::TerminusHandle terminusHandle;
+        std::vector<uint8_t> data;
+    };
+
+    std::vector<RemoteRecord> kept;
+    std::vector<std::vector<uint8_t>> removed;
+    uint8_t* pdrData = nullptr;
+    uint32_t pdrSize{};
+    uint32_t nextRecordHandle{};
+    auto record = pldm_pdr_find_record(repo, 0, &pdrData, &pdrSize,
+                                       &nextRecordHandle);
+    while (record)
+    {
+        if (pldm_pdr_record_is_remote(record))
+        {
+            auto recordHandle = pldm_pdr_get_record_handle(repo, record);
+            auto terminusHandle = pldm_pdr_get_terminus_handle(repo, record);
+            std::vector<uint8_t> data(pdrData, pdrData + pdrSize);
+            if (remove(recordHandle, terminusHandle))
+            {
+                removed.emplace_back(std::move(data));
+            }
+            else
+            {
+                kept.emplace_back(recordHandle, terminusHandle,
+                                  std::move(data));
+            }
+        }
+
+        pdrData = nullptr;
+        pdrSize = 0;
+        record = pldm_pdr_get_next_record(repo, record, &pdrData, &pdrSize,
+                                          &nextRecordHandle);
+    }
+
+    if (removed.empty())
+    {
+        return removed;
+    }
+
+    pldm_pdr_remove_remote_pdrs(repo);
+    repoModified(repo);
+    for (auto& [recordHandle, terminusHandle, data] : kept)
+    {
+        auto rc = pldm_pdr_add_check(repo, data.data(), data.size(), true,
+                                     terminusHandle, &recordHandle);
+        if (rc)
+        {
+            error(
+                "Failed to add back remote PDR with record handle '{RECORD_HANDLE}', response code '{RC}'",
+                "RECORD_HANDLE", recordHandle, "RC", rc);
+        }
+    }
+
+    return removed;
+}
+
+namespace
+{
+
+struct RepoGeneration
+{
+    uint64_t generation; //!< number of modifications
+    size_t trackers;     //!< number of trackers of the repository
+};
+
+/** @brief modification generations of the tracked PDR repositories */
+std::unordered_map<const pldm_pdr*, RepoGeneration> repoGenerations;
+
+} // namespace
+
+void trackRepoGeneration(const pldm_pdr* repo)
+{
+    ++repoGenerations.try_emplace(repo, RepoGeneration{0, 0})
+          .first->second.trackers;
+}
+
+void untrackRepoGeneration(const pldm_pdr* repo)
+{
+    auto it = repoGenerations.find(repo);
+    if (it != repoGenerations.end() && --it->second.trackers == 0)
+    {
+        repoGenerations.erase(it);
+    }
+}
+
+void repoModified(const pldm_pdr* repo)
+{
+    if (auto it = repoGenerations.find(repo); it != repoGenerations.end())
+    {
+        ++it->second.generation;
+    }
+}
+
+uint64_t getRepoGeneration(const pldm_pdr* repo)
+{
+    auto it = repoGenerations.find(repo);
+    return it == repoGenerations.end() ? 0 : it->second.generation;
+}
+
 } // namespace pdr_utils
 } // namespace responder
 } // namespace pldm
@@ -258,6 +258,57 @@ size_t getEffecterDataSize(uint8_t effecterDataSize);
  *  */
 std::vector<uint8_t> fetchBitMap(const std::vector<std::vector<uint8_t>>& pdrs);
 
+/** @brief Remove a batch of remote records from a PDR repository
+ *
+ *  The remote records are taken out of the repository in a single pass and
+ *  the ones to keep are added back with their record and terminus handles,
+ *  in their original order, rather than searching the repository once per
+ *  record to remove. The remote records kept end up after the local records.
+ *
+ *  @param[in] repo - PDR repository
+ *  @param[in] remove - predicate taking the record handle and the terminus
+ *                      handle of a remote record, true to remove the record
+ *
+ *  @return the removed records
+ */
+std::vector<std::vector<uint8_t>> removeRemotePDRs(
+    pldm_pdr* repo,
+    const std::function<bool(RecordHandle, pldm::pdr::TerminusHandle)>&
+        remove);
+
+/** @brief Start counting the modifications of a PDR repository, only the
+ *         repositories served through snapshots are tracked. Each call is
+ *         paired with a call to untrackRepoGeneration().
+ *
+ *  @param[in] repo - the PDR repository
+ */
+void trackRepoGeneration(const pldm_pdr* repo);
+
+/** @brief Stop counting the modifications of a PDR repository, its
+ *         generation is dropped once its last tracker is gone
+ *
+ *  @param[in] repo - the PDR repository
+ */
+void untrackRepoGeneration(const pldm_pdr* repo);
+
+/** @brief Record that a PDR repository was modified, every writer calls it
+ *         after adding, removing or editing records in place so that the
+ *         snapshots served to GetPDR are taken again. The modifications of
+ *         an untracked repository are not counted.
+ *
+ *  @param[in] repo - the modified PDR repository
+ */
+void repoModified(const pldm_pdr* repo);
+
+/** @brief Get the modification generation of a PDR repository
+ *
+ *  @param[in] repo - the PDR repository
+ *
+ *  @return number of modifications recorded for the repository since it is
+ *          tracked, 0 if it is not tracked
+ */
+uint64_t getRepoGeneration(const pldm_pdr* repo);
+
 } // namespace pdr_utils
 } // namespace responder
 } // namespace pldm
@@ -13,6 +13,7 @@
 #include "platform_numeric_effecter.hpp"
 #include "platform_state_effecter.hpp"
 #include "platform_state_sensor.hpp"
+#include "sensor_event_emitter.hpp"
 #include "pldmd/dbus_impl_requester.hpp"
 #include "pldmd/handler.hpp"
 #include "requester/handler.hpp"
@@ -162,7 +163,8 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
     }
 }
 
-Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
+Response Handler::getPDR(const pldm_msg* request, size_t payloadLength,
+                         pldm_tid_t tid)
 {
     if (oemPlatformHandler != nullptr)
     {
@@ -204,6 +206,7 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
         generate(*dBusIntf, pdrJsonsDir, pdrRepo);
 
         pdrCreated = true;
+        pdrSnapshots.publish();
 
         if (dbusToPLDMEventHandler)
         {
@@ -272,12 +275,14 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
     }
 
     uint16_t respSizeBytes{};
-    uint8_t* recordData = nullptr;
+    const uint8_t* recordData = nullptr;
     try
     {
-        pdr_utils::PdrEntry e;
-        auto record = pdr::getRecordByHandle(pdrRepo, recordHandle, e);
-        if (record == NULL)
+        // Serve the walk from a pinned generation of the repository, so that
+        // host PDR merges and deletions happening in between the requests do
+        // not tear the nextRecordHandle chain seen by the requester.
+        auto record = pdrSnapshots.getRecord(tid, recordHandle);
+        if (!record)
         {
             return CmdHandler::ccOnlyResponse(
                 request, PLDM_PLATFORM_INVALID_RECORD_HANDLE);
@@ -285,20 +290,20 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
 
         if (reqSizeBytes)
         {
-            respSizeBytes = e.size;
+            respSizeBytes = record->data.size();
             if (respSizeBytes > reqSizeBytes)
             {
                 respSizeBytes = reqSizeBytes;
             }
-            recordData = e.data;
+            recordData = record->data.data();
         }
         response.resize(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_MIN_RESP_BYTES +
                             respSizeBytes,
                         0);
         auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
         rc = encode_get_pdr_resp(
-            request->hdr.instance_id, PLDM_SUCCESS, e.handle.nextRecordHandle,
-            0, PLDM_START_AND_END, respSizeBytes, recordData, 0, responsePtr);
+            request->hdr.instance_id, PLDM_SUCCESS, record->nextRecordHandle, 0,
+            PLDM_START_AND_END, respSizeBytes, recordData, 0, responsePtr);
         if (rc != PLDM_SUCCESS)
         {
             return ccOnlyResponse(request, rc);
@@ -408,6 +413,12 @@ Response Handler::platformEventMessage(const pldm_msg* request,
             }
         }
     }
+    else if (eventClass == PLDM_SENSOR_EVENT &&
+             !admitSensorEvent(request, payloadLength, formatVersion, tid,
+                               offset))
+    {
+        rc = PLDM_SUCCESS;
+    }
     else
     {
         try
@@ -422,6 +433,10 @@ Response Handler::platformEventMessage(const pldm_msg* request,
                     return CmdHandler::ccOnlyResponse(request, rc);
                 }
             }
+            if (eventClass == PLDM_SENSOR_EVENT)
+            {
+                sensorEventHandled(request, payloadLength, tid, offset);
+            }
         }
         catch (const std::out_of_range& e)
         {
@@ -444,6 +459,128 @@ Response Handler::platformEventMessage(const pldm_msg* request,
     return response;
 }
 
+std::optional<events::EventAdmission::SensorKey>
+    Handler::getSensorKey(const pldm_msg* request, size_t payloadLength,
+                          uint8_t tid, size_t eventDataOffset)
+{
+    uint16_t sensorId{};
+    uint8_t sensorEventClass{};
+    size_t eventClassDataOffset{};
+    auto eventData = reinterpret_cast<const uint8_t*>(request->payload) +
+                     eventDataOffset;
+    auto eventDataSize = payloadLength - eventDataOffset;
+
+    auto rc = decode_sensor_event_data(eventData, eventDataSize, &sensorId,
+                                       &sensorEventClass,
+                                       &eventClassDataOffset);
+    if (rc != PLDM_SUCCESS)
+    {
+        return std::nullopt;
+    }
+
+    uint8_t sensorOffset = 0;
+    if (sensorEventClass == PLDM_STATE_SENSOR_STATE &&
+        eventDataSize > eventClassDataOffset)
+    {
+        sensorOffset = eventData[eventClassDataOffset];
+    }
+
+    return events::EventAdmission::SensorKey{tid, sensorId, sensorEventClass,
+                                             sensorOffset};
+}
+
+bool Handler::admitSensorEvent(const pldm_msg* request, size_t payloadLength,
+                               uint8_t formatVersion, uint8_t tid,
+                               size_t eventDataOffset)
+{
+    auto key = getSensorKey(request, payloadLength, tid, eventDataOffset);
+    if (!key)
+    {
+        // Left to the event handlers to reject
+        return true;
+    }
+
+    auto eventData = reinterpret_cast<const uint8_t*>(request->payload) +
+                     eventDataOffset;
+    auto message = reinterpret_cast<const uint8_t*>(request);
+    auto verdict = eventAdmission.admit(
+        *key, {eventData, payloadLength - eventDataOffset},
+        {{message, message + sizeof(pldm_msg_hdr) + payloadLength},
+         tid,
+         formatVersion,
+         eventDataOffset},
+        events::EventAdmission::Clock::now());
+    if (verdict == events::EventAdmission::Verdict::Defer &&
+        !eventReleaseTimer.isEnabled())
+    {
+        const auto& counters = eventAdmission.getCounters();
+        info(
+            "Deferring sensor events from TID '{TID}', admitted {ADMITTED}, merged {MERGED}, deferred {DEFERRED}",
+            "TID", tid, "ADMITTED", counters.admitted, "MERGED",
+            counters.merged, "DEFERRED", counters.deferred);
+        eventReleaseTimer.restartOnce(eventAdmission.getRefillInterval());
+    }
+
+    return verdict == events::EventAdmission::Verdict::Admit;
+}
+
+void Handler::sensorEventHandled(const pldm_msg* request,
+                                 size_t payloadLength, uint8_t tid,
+                                 size_t eventDataOffset)
+{
+    auto key = getSensorKey(request, payloadLength, tid, eventDataOffset);
+    if (!key)
+    {
+        return;
+    }
+
+    auto eventData = reinterpret_cast<const uint8_t*>(request->payload) +
+                     eventDataOffset;
+    eventAdmission.handled(*key, {eventData, payloadLength - eventDataOffset},
+                           events::EventAdmission::Clock::now());
+}
+
+void Handler::releaseEvents()
+{
+    for (const auto& event :
+         eventAdmission.release(events::EventAdmission::Clock::now()))
+    {
+        auto request = reinterpret_cast<const pldm_msg*>(event.request.data());
+        auto payloadLength = event.request.size() - sizeof(pldm_msg_hdr);
+        int rc = PLDM_SUCCESS;
+        for (const auto& handler : eventHandlers.at(PLDM_SENSOR_EVENT))
+        {
+            rc = handler(request, payloadLength, event.formatVersion,
+                         event.tid, event.eventDataOffset);
+            if (rc != PLDM_SUCCESS)
+            {
+                error(
+                    "Failed to handle deferred sensor event from TID '{TID}', response code '{RC}'",
+                    "TID", event.tid, "RC", rc);
+                break;
+            }
+        }
+        if (rc == PLDM_SUCCESS)
+        {
+            sensorEventHandled(request, payloadLength, event.tid,
+                               event.eventDataOffset);
+        }
+    }
+
+    if (eventAdmission.hasDeferred())
+    {
+        eventReleaseTimer.restartOnce(eventAdmission.getRefillInterval());
+    }
+    else
+    {
+        const auto& counters = eventAdmission.getCounters();
+        info(
+            "Released the deferred sensor events, admitted {ADMITTED}, merged {MERGED}, deferred {DEFERRED}",
+            "ADMITTED", counters.admitted, "MERGED", counters.merged,
+            "DEFERRED", counters.deferred);
+    }
+}
+
 int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
                          uint8_t /*formatVersion*/, uint8_t tid,
                          size_t eventDataOffset)
@@ -482,8 +619,8 @@ int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
         }
 
         // Emitting state sensor event signal
-        emitStateSensorEventSignal(tid, sensorId, sensorOffset, eventState,
-                                   previousEventState);
+        StateSensorEventEmitter::GetInstance().emit(
+            {tid, sensorId, sensorOffset, eventState, previousEventState});
 
         // If there are no HOST PDR's, there is no further action
         if (hostPDRHandler == NULL)
@@ -629,24 +766,14 @@ int Handler::pldmPDRRepositoryChgEvent(const pldm_msg* request,
     if (hostPDRHandler)
     {
         // if we get a Repository change event with the eventDataFormat
-        // as REFRESH_ENTIRE_REPOSITORY, then delete all the PDR's that
-        // have the matched Terminus handle
+        // as REFRESH_ENTIRE_REPOSITORY, walk the host repository and apply
+        // only the differences to the remote PDRs of the BMC repository
         if (eventDataFormat == REFRESH_ENTIRE_REPOSITORY)
         {
             info("Got a refresh entire repo event from {TID}", "TID", tid);
-            // We cannot get the Repo change event from the Terminus
-            // that is not already added to the BMC repository
-            for (const auto& [terminusHandle, terminusInfo] :
-                 hostPDRHandler->tlPDRInfo)
-            {
-                if (std::get<0>(terminusInfo) == tid)
-                {
-                    pldm_pdr_remove_pdrs_by_terminus_handle(pdrRepo.getPdr(),
-                                                            terminusHandle);
-                }
-            }
+            hostPDRHandler->refreshPDR(tid);
         }
-        if (eventDataOperation == PLDM_RECORDS_DELETED)
+        else if (eventDataOperation == PLDM_RECORDS_DELETED)
         {
             info(
                 "Got a records deleted event, '{TID}' and eventDataOperation is {ED}",
@@ -838,9 +965,12 @@ Response Handler::getStateSensorReadings(const pldm_msg* request,
     uint16_t entityInstance{};
     uint16_t stateSetId{};
 
-    if (isOemStateSensor(*this, sensorId, sensorRearmCount, comSensorCnt,
-                         entityType, entityInstance, stateSetId) &&
-        oemPlatformHandler != nullptr && !sensorDbusObjMaps.contains(sensorId))
+    // The sensors mapped to D-Bus skip the lookup of the OEM sensors, for
+    // their readings to be served from the state sensor mirror
+    if (oemPlatformHandler != nullptr &&
+        !sensorDbusObjMaps.contains(sensorId) &&
+        isOemStateSensor(*this, sensorId, sensorRearmCount, comSensorCnt,
+                         entityType, entityInstance, stateSetId))
     {
         rc = oemPlatformHandler->getOemStateSensorReadingsHandler(
             entityType, entityInstance, stateSetId, comSensorCnt, stateField);
@@ -1,15 +1,19 @@
 #pragma once
 
 #include "common/utils.hpp"
+#include "event_admission.hpp"
 #include "event_parser.hpp"
 #include "fru.hpp"
 #include "host-bmc/dbus_to_event_handler.hpp"
 #include "host-bmc/host_pdr_handler.hpp"
 #include "libpldmresponder/pdr.hpp"
+#include "libpldmresponder/pdr_snapshot.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
 #include "libpldmresponder/platform_config.hpp"
+#include "numeric_effecter_cache.hpp"
 #include "oem_handler.hpp"
 #include "pldmd/handler.hpp"
+#include "state_sensor_mirror.hpp"
 
 #include <libpldm/pdr.h>
 #include <libpldm/platform.h>
@@ -17,8 +21,11 @@
 #include <stdint.h>
 
 #include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/utility/timer.hpp>
 
+#include <chrono>
 #include <map>
+#include <optional>
 
 PHOSPHOR_LOG2_USING;
 
@@ -45,6 +52,13 @@ using EventHandler = std::function<int(
 using EventHandlers = std::vector<EventHandler>;
 using EventMap = std::map<EventType, EventHandlers>;
 using AssociatedEntityMap = std::map<DbusPath, pldm_entity>;
+
+/** @brief Sensor events a terminus can send in a burst */
+constexpr size_t sensorEventBurst = 64;
+/** @brief Interval a terminus regains a sensor event token at */
+constexpr auto sensorEventRefillInterval = std::chrono::milliseconds(20);
+/** @brief Window identical consecutive sensor events are merged in */
+constexpr auto sensorEventDedupWindow = std::chrono::seconds(1);
 using namespace sdbusplus::bus::match::rules;
 
 class Handler : public CmdHandler
@@ -62,14 +76,18 @@ class Handler : public CmdHandler
             sdeventplus::Event& event, bool buildPDRLazily = false,
             const std::optional<EventMap>& addOnHandlersMap = std::nullopt) :
         eid(eid),
-        instanceIdDb(instanceIdDb), pdrRepo(repo),
+        instanceIdDb(instanceIdDb), pdrRepo(repo), pdrSnapshots(repo),
         hostPDRHandler(hostPDRHandler),
         dbusToPLDMEventHandler(dbusToPLDMEventHandler), fruHandler(fruHandler),
         bmcEntityTree(bmcEntityTree), dBusIntf(dBusIntf),
         oemPlatformHandler(oemPlatformHandler),
         platformConfigHandler(platformConfigHandler), handler(handler),
         event(event), pdrJsonDir(pdrJsonDir), pdrCreated(false),
-        pdrJsonsDir({pdrJsonDir})
+        pdrJsonsDir({pdrJsonDir}),
+        eventAdmission(sensorEventBurst, sensorEventRefillInterval,
+                       sensorEventDedupWindow),
+        eventReleaseTimer(event,
+                          std::bind(std::mem_fn(&Handler::releaseEvents), this))
     {
         if (!buildPDRLazily)
         {
@@ -78,10 +96,10 @@ class Handler : public CmdHandler
             pdrCreated = true;
         }
 
-        handlers.emplace(
-            PLDM_GET_PDR,
-            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
-            return this->getPDR(request, payloadLength);
+        handlers.emplace(PLDM_GET_PDR, [this](pldm_tid_t tid,
+                                              const pldm_msg* request,
+                                              size_t payloadLength) {
+            return this->getPDR(request, payloadLength, tid);
         });
         handlers.emplace(
             PLDM_SET_NUMERIC_EFFECTER_VALUE,
@@ -200,6 +218,25 @@ class Handler : public CmdHandler
             pldm::responder::pdr_utils::TypeId typeId =
                 pldm::responder::pdr_utils::TypeId::PLDM_EFFECTER_ID) const;
 
+    /** @brief Get the cache of the numeric effecter values
+     *
+     *  @return reference to the numeric effecter value cache
+     */
+    platform_numeric_effecter::NumericEffecterValueCache&
+        getNumericEffecterValueCache()
+    {
+        return numericEffecterValueCache;
+    }
+
+    /** @brief Get the mirror of the state sensor readings
+     *
+     *  @return reference to the state sensor mirror
+     */
+    platform_state_sensor::StateSensorMirror& getStateSensorMirror()
+    {
+        return stateSensorMirror;
+    }
+
     uint16_t getNextEffecterId()
     {
         return ++nextEffecterId;
@@ -237,9 +274,12 @@ class Handler : public CmdHandler
      *
      *  @param[in] request - Request message payload
      *  @param[in] payloadLength - Request payload length
+     *  @param[in] tid - terminus ID of the requester, a multipart walk is
+     *                   served from the repository generation pinned for it
      *  @param[out] Response - Response message written here
      */
-    Response getPDR(const pldm_msg* request, size_t payloadLength);
+    Response getPDR(const pldm_msg* request, size_t payloadLength,
+                    pldm_tid_t tid = PLDM_TID_RESERVED);
 
     /** @brief Handler for setNumericEffecterValue
      *
@@ -299,6 +339,50 @@ class Handler : public CmdHandler
     int sensorEvent(const pldm_msg* request, size_t payloadLength,
                     uint8_t formatVersion, uint8_t tid, size_t eventDataOffset);
 
+    /** @brief Pass a sensor event through the event admission stage
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request payload length
+     *  @param[in] formatVersion - Version of the event format
+     *  @param[in] tid - Terminus ID of the event's originator
+     *  @param[in] eventDataOffset - Offset of the event data in the request
+     *                               message
+     *  @return true if the event is to be handled now, false if it is merged
+     *          into an event already handled or deferred
+     */
+    bool admitSensorEvent(const pldm_msg* request, size_t payloadLength,
+                          uint8_t formatVersion, uint8_t tid,
+                          size_t eventDataOffset);
+
+    /** @brief Record a sensor event the event handlers succeeded on, for
+     *         its repeats to be merged into it
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request payload length
+     *  @param[in] tid - Terminus ID of the event's originator
+     *  @param[in] eventDataOffset - Offset of the event data in the request
+     *                               message
+     */
+    void sensorEventHandled(const pldm_msg* request, size_t payloadLength,
+                            uint8_t tid, size_t eventDataOffset);
+
+    /** @brief Decode the sensor a sensor event is about
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request payload length
+     *  @param[in] tid - Terminus ID of the event's originator
+     *  @param[in] eventDataOffset - Offset of the event data in the request
+     *                               message
+     *  @return the sensor, std::nullopt if the sensor event data is invalid
+     */
+    static std::optional<events::EventAdmission::SensorKey>
+        getSensorKey(const pldm_msg* request, size_t payloadLength,
+                     uint8_t tid, size_t eventDataOffset);
+
+    /** @brief Handle the deferred sensor events the terminus has tokens for
+     */
+    void releaseEvents();
+
     /** @brief Handler for pldmPDRRepositoryChgEvent
      *
      *  @param[in] request - Request message
@@ -514,10 +598,17 @@ class Handler : public CmdHandler
     uint8_t eid;
     InstanceIdDb* instanceIdDb;
     pdr_utils::Repo pdrRepo;
+    /** @brief copy-on-write generations of pdrRepo served to GetPDR */
+    pdr::RepoSnapshots pdrSnapshots;
     uint16_t nextEffecterId{};
     uint16_t nextSensorId{};
     DbusObjMaps effecterDbusObjMaps{};
     DbusObjMaps sensorDbusObjMaps{};
+    /** @brief D-Bus values of the numeric effecters */
+    platform_numeric_effecter::NumericEffecterValueCache
+        numericEffecterValueCache;
+    /** @brief encoded states of the state sensors */
+    platform_state_sensor::StateSensorMirror stateSensorMirror;
     HostPDRHandler* hostPDRHandler;
     pldm::state_sensor::DbusToPLDMEvent* dbusToPLDMEventHandler;
     fru::Handler* fruHandler;
@@ -537,6 +628,11 @@ class Handler : public CmdHandler
     /** @brief Flag used to delete the cached Mex details and Mex Dbus Objects
      */
     bool clearMexObj = true;
+    /** @brief admission stage of the sensor events */
+    events::EventAdmission eventAdmission;
+    /** @brief timer releasing the deferred sensor events */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>
+        eventReleaseTimer;
 };
 
 /** @brief Function to check if a sensor falls in OEM range
@@ -317,6 +317,9 @@ int setNumericEffecterValueHandler(const DBusInterface& dBusIntf,
         }
         try
         {
+            // The cached value is stale until the PropertiesChanged signal
+            // of the write comes back
+            handler.getNumericEffecterValueCache().invalidate(effecterId);
             dBusIntf.setDbusProperty(dbusMapping, dbusValue.value());
         }
         catch (const std::exception& e)
@@ -495,6 +498,15 @@ int getNumericEffecterData(const DBusInterface& dBusIntf, Handler& handler,
                            std::string& propertyType,
                            pldm::utils::PropertyValue& propertyValue)
 {
+    auto& valueCache = handler.getNumericEffecterValueCache();
+    if (auto entry = valueCache.find(effecterId))
+    {
+        effecterDataSize = entry->effecterDataSize;
+        propertyType = entry->propertyType;
+        propertyValue = entry->value.value();
+        return PLDM_SUCCESS;
+    }
+
     pldm_numeric_effecter_value_pdr* pdr = nullptr;
 
     std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)>
@@ -545,11 +557,34 @@ int getNumericEffecterData(const DBusInterface& dBusIntf, Handler& handler,
                 dbusMappings[0].objectPath, dbusMappings[0].interface,
                 dbusMappings[0].propertyName, dbusMappings[0].propertyType};
 
+            // Subscribe ahead of the read, so that no change is missed in
+            // between. The value is just not cached if that fails.
+            bool cached = false;
+            try
+            {
+                cached = valueCache.subscribe(
+                    effecterId, dbusMapping,
+                    dBusIntf.getService(dbusMapping.objectPath.c_str(),
+                                        dbusMapping.interface.c_str()));
+            }
+            catch (const std::exception& e)
+            {
+                error(
+                    "Failed to get the service of numeric effecter ID '{EFFECTERID}' at path '{PATH}', error - {ERROR}",
+                    "EFFECTERID", effecterId, "PATH", dbusMapping.objectPath,
+                    "ERROR", e);
+            }
+
             propertyValue = dBusIntf.getDbusPropertyVariant(
                 dbusMapping.objectPath.c_str(),
                 dbusMapping.propertyName.c_str(),
                 dbusMapping.interface.c_str());
             propertyType = dbusMappings[0].propertyType;
+            if (cached)
+            {
+                valueCache.update(effecterId, effecterDataSize, propertyType,
+                                  propertyValue);
+            }
         }
     }
     catch (const std::exception& e)
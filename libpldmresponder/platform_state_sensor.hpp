@@ -4,14 +4,18 @@
 #include "libpldmresponder/pdr.hpp"
 #include "pdr_utils.hpp"
 #include "pldmd/handler.hpp"
+#include "state_sensor_mirror.hpp"
 
 #include <libpldm/platform.h>
 #include <libpldm/states.h>
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <map>
+#include <span>
+#include <vector>
 
 PHOSPHOR_LOG2_USING;
 
@@ -43,13 +47,7 @@ uint8_t getStateSensorEventState(
             dbusMapping.objectPath.c_str(), dbusMapping.propertyName.c_str(),
             dbusMapping.interface.c_str());
 
-        for (const auto& stateValue : stateToDbusValue)
-        {
-            if (stateValue.second == propertyValue)
-            {
-                return stateValue.first;
-            }
-        }
+        return getSensorState(stateToDbusValue, propertyValue);
     }
     catch (const std::exception& e)
     {
@@ -61,7 +59,60 @@ uint8_t getStateSensorEventState(
     return PLDM_SENSOR_UNKNOWN;
 }
 
+/** @brief Function to fill in the state fields of a sensor reading, from the
+ *         encoded state fields of its composite sensors and their previous
+ *         states kept in the sensor cache
+ *
+ *  @tparam[in] Handler - pldm::responder::platform::Handler
+ *  @param[in] handler - The interface object of
+ *             pldm::responder::platform::Handler
+ *  @param[in] sensorId - Sensor ID sent by the requester to act on
+ *  @param[in] sensorRearmCnt - number of composite sensors to report
+ *  @param[in] stateFields - encoded state fields of the composite sensors
+ *  @param[in] sensorCache - previous states of the sensors
+ *  @param[out] stateField - The state field data for each of the states
+ */
+template <class Handler>
+void copyStateFields(Handler& handler, uint16_t sensorId,
+                     uint8_t sensorRearmCnt,
+                     std::span<const get_sensor_state_field> stateFields,
+                     const stateSensorCacheMaps& sensorCache,
+                     std::vector<get_sensor_state_field>& stateField)
+{
+    pldm::responder::pdr_utils::EventStates sensorCacheforSensor{};
+    if (sensorCache.contains(sensorId))
+    {
+        sensorCacheforSensor = sensorCache.at(sensorId);
+    }
+
+    auto count = std::min<size_t>(sensorRearmCnt, stateFields.size());
+    stateField.assign(stateFields.begin(), stateFields.begin() + count);
+    for (std::size_t offset{0}; offset < count; offset++)
+    {
+        auto& field = stateField[offset];
+
+        // if sensor cache is empty, then its the first
+        // get_state_sensor_reading on this sensor, set the previous state
+        // as the current state
+        if (sensorCacheforSensor.at(offset) == PLDM_SENSOR_UNKNOWN)
+        {
+            field.previous_state = field.event_state;
+            handler.updateSensorCache(sensorId, offset, field.previous_state);
+        }
+        else
+        {
+            // sensor cache is not empty, so get the previous state from
+            // the sensor cache
+            field.previous_state = sensorCacheforSensor[offset];
+        }
+    }
+}
+
 /** @brief Function to get the state sensor readings requested by pldm requester
+ *
+ *  The readings are served from the state sensor mirror of the handler once
+ *  the sensor has been read from D-Bus through dBusIntf, the D-Bus properties
+ *  of the sensor are then tracked by the mirror.
  *
  *  @tparam[in] DBusInterface - DBus interface type
  *  @tparam[in] Handler - pldm::responder::platform::Handler
@@ -87,6 +138,36 @@ int getStateSensorReadingsHandler(
     using namespace pldm::responder::pdr;
     using namespace pldm::utils;
 
+    auto& mirror = handler.getStateSensorMirror();
+    if (auto entry = mirror.find(sensorId))
+    {
+        compSensorCnt = entry->compositeSensorCount;
+        if (sensorRearmCnt > compSensorCnt)
+        {
+            error(
+                "The requester sent wrong sensor rearm count '{SENSOR_REARM_COUNT}' for the sensor ID '{SENSORID}'",
+                "SENSORID", sensorId, "SENSOR_REARM_COUNT", sensorRearmCnt);
+            return PLDM_PLATFORM_REARM_UNAVAILABLE_IN_PRESENT_STATE;
+        }
+        if (sensorRearmCnt == 0)
+        {
+            sensorRearmCnt = compSensorCnt;
+        }
+
+        try
+        {
+            copyStateFields(handler, sensorId, sensorRearmCnt,
+                            entry->stateFields, sensorCache, stateField);
+        }
+        catch (const std::out_of_range& e)
+        {
+            error("The sensor ID '{SENSORID}' does not exist, error - {ERROR}",
+                  "SENSORID", sensorId, "ERROR", e);
+            return PLDM_ERROR;
+        }
+        return PLDM_SUCCESS;
+    }
+
     pldm_state_sensor_pdr* pdr = nullptr;
 
     std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> stateSensorPdrRepo(
@@ -152,48 +233,13 @@ int getStateSensorReadingsHandler(
                   "SENSOR_ID", sensorId);
             return PLDM_ERROR;
         }
-        pldm::responder::pdr_utils::EventStates sensorCacheforSensor{};
-        if (sensorCache.contains(sensorId))
-        {
-            sensorCacheforSensor = sensorCache.at(sensorId);
-        }
-        stateField.clear();
-        for (std::size_t offset{0};
-             offset < sensorRearmCnt && offset < dbusMappings.size() &&
-             offset < dbusValMaps.size();
-             offset++)
-        {
-            auto& dbusMapping = dbusMappings[offset];
-
-            uint8_t sensorEvent = getStateSensorEventState<DBusInterface>(
-                dBusIntf, dbusValMaps[offset], dbusMapping);
-
-            uint8_t previousState = PLDM_SENSOR_UNKNOWN;
-
-            // if sensor cache is empty, then its the first
-            // get_state_sensor_reading on this sensor, set the previous state
-            // as the current state
-
-            if (sensorCacheforSensor.at(offset) == PLDM_SENSOR_UNKNOWN)
-            {
-                previousState = sensorEvent;
-                handler.updateSensorCache(sensorId, offset, previousState);
-            }
-            else
-            {
-                // sensor cache is not empty, so get the previous state from
-                // the sensor cache
-                previousState = sensorCacheforSensor[offset];
-            }
-            uint8_t opState = PLDM_SENSOR_ENABLED;
-            if (sensorEvent == PLDM_SENSOR_UNKNOWN)
-            {
-                opState = PLDM_SENSOR_UNAVAILABLE;
-            }
-
-            stateField.push_back(
-                {opState, PLDM_SENSOR_NORMAL, previousState, sensorEvent});
-        }
+
+        // All the mapped composite sensors are read, for the mirror to
+        // serve the later readings of any of them
+        auto stateFields = mirror.read(dBusIntf, sensorId, compSensorCnt,
+                                       dbusMappings, dbusValMaps);
+        copyStateFields(handler, sensorId, sensorRearmCnt, stateFields,
+                        sensorCache, stateField);
     }
     catch (const std::out_of_range& e)
     {
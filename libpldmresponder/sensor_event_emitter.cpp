@@ -0,0 +1,148 @@
+#include "sensor_event_emitter.hpp"
+
+#include "common/utils.hpp"
+
+#include <libpldm/base.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <functional>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+
+namespace
+{
+
+constexpr auto eventPath = "/xyz/openbmc_project/pldm";
+constexpr auto eventInterface = "xyz.openbmc_project.PLDM.Event";
+
+/** @brief events emitted at once when the window has not expired yet */
+constexpr size_t sensorEventQueueLimit = 256;
+
+} // namespace
+
+StateSensorEventEmitter::StateSensorEventEmitter(bool perEventSignal,
+                                                 size_t queueLimit) :
+    perEventSignal(perEventSignal),
+    queueLimit(queueLimit)
+{}
+
+StateSensorEventEmitter& StateSensorEventEmitter::GetInstance()
+{
+#ifdef SENSOR_EVENT_PER_EVENT_SIGNAL
+    static StateSensorEventEmitter emitter(true, sensorEventQueueLimit);
+#else
+    static StateSensorEventEmitter emitter(false, sensorEventQueueLimit);
+#endif
+    return emitter;
+}
+
+void StateSensorEventEmitter::start(const sdeventplus::Event& event,
+                                    std::chrono::milliseconds window)
+{
+    flush();
+    this->window = window;
+    if (window == std::chrono::milliseconds::zero())
+    {
+        timer.reset();
+        return;
+    }
+    timer = std::make_unique<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
+        event, std::bind(std::mem_fn(&StateSensorEventEmitter::flush), this));
+}
+
+int StateSensorEventEmitter::emit(const StateSensorEvent& event)
+{
+    if (!timer)
+    {
+        try
+        {
+            send({event}, false);
+        }
+        catch (const std::exception& e)
+        {
+            error("Failed to emit pldm event signal, error - {ERROR}", "ERROR",
+                  e);
+            counters.dropped++;
+            return PLDM_ERROR;
+        }
+        counters.emitted++;
+        return PLDM_SUCCESS;
+    }
+
+    queue.emplace_back(event);
+    counters.queueDepth = queue.size();
+    counters.maxQueueDepth = std::max(counters.maxQueueDepth, queue.size());
+    if (queue.size() >= queueLimit)
+    {
+        flush();
+    }
+    else if (!timer->isEnabled())
+    {
+        timer->restartOnce(window);
+    }
+    return PLDM_SUCCESS;
+}
+
+void StateSensorEventEmitter::flush()
+{
+    if (timer)
+    {
+        timer->setEnabled(false);
+    }
+    if (queue.empty())
+    {
+        return;
+    }
+
+    std::vector<StateSensorEvent> events;
+    events.swap(queue);
+    counters.queueDepth = 0;
+    try
+    {
+        send(events, true);
+        counters.batches++;
+        counters.emitted += events.size();
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to emit {COUNT} pldm event signals, error - {ERROR}",
+              "COUNT", events.size(), "ERROR", e);
+        counters.dropped += events.size();
+    }
+}
+
+void StateSensorEventEmitter::send(const std::vector<StateSensorEvent>& events,
+                                   bool batched)
+{
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    if (perEventSignal || !batched)
+    {
+        for (const auto& [tid, sensorId, sensorOffset, eventState,
+                          previousEventState] : events)
+        {
+            auto msg = bus.new_signal(eventPath, eventInterface,
+                                      "StateSensorEvent");
+            msg.append(tid, sensorId, sensorOffset, eventState,
+                       previousEventState);
+            msg.signal_send();
+        }
+    }
+    if (batched)
+    {
+        auto msg = bus.new_signal(eventPath, eventInterface,
+                                  "StateSensorEvents");
+        msg.append(events);
+        msg.signal_send();
+    }
+}
+
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+
+/** @class StateSensorEventEmitter
+ *
+ *  @brief Emits the state sensor events as D-Bus signals.
+ *
+ *  Once started on an event loop with a non-zero window, the events are
+ *  queued and emitted together when the window expires, as one
+ *  StateSensorEvents signal carrying the array of the events. The
+ *  StateSensorEvent signal is still emitted for each of them unless the
+ *  per-event signal is disabled. A full queue is emitted right away, events
+ *  are only dropped when emitting their signals fails.
+ *
+ *  Until started, or with a zero window, every event is emitted on its own
+ *  as a StateSensorEvent signal.
+ */
+class StateSensorEventEmitter
+{
+  public:
+    /** @brief TID, sensor ID, sensor offset, event state and previous event
+     *         state of a state sensor event
+     */
+    using StateSensorEvent =
+        std::tuple<uint8_t, uint16_t, uint8_t, uint8_t, uint8_t>;
+
+    struct Counters
+    {
+        size_t queueDepth = 0;    //!< events waiting for the window to expire
+        size_t maxQueueDepth = 0; //!< highest queue depth seen
+        uint64_t batches = 0;     //!< StateSensorEvents signals emitted
+        uint64_t emitted = 0;     //!< events emitted
+        uint64_t dropped = 0;     //!< events whose signals failed
+    };
+
+    /** @brief Constructor
+     *
+     *  @param[in] perEventSignal - emit a StateSensorEvent signal for each
+     *                              batched event
+     *  @param[in] queueLimit - number of queued events emitted without
+     *                          waiting for the window to expire
+     */
+    StateSensorEventEmitter(bool perEventSignal, size_t queueLimit);
+
+    StateSensorEventEmitter(const StateSensorEventEmitter&) = delete;
+    StateSensorEventEmitter& operator=(const StateSensorEventEmitter&) =
+        delete;
+    virtual ~StateSensorEventEmitter() = default;
+
+    /** @brief Get the emitter the state sensor events of pldmd go through */
+    static StateSensorEventEmitter& GetInstance();
+
+    /** @brief Start batching the events
+     *
+     *  @param[in] event - event loop the window timer runs on
+     *  @param[in] window - window the events are batched over, batching is
+     *                      disabled if zero
+     */
+    void start(const sdeventplus::Event& event,
+               std::chrono::milliseconds window);
+
+    /** @brief Emit a state sensor event
+     *
+     *  @param[in] event - the state sensor event
+     *
+     *  @return PLDM_SUCCESS if the signal is sent or the event is queued,
+     *          PLDM_ERROR if the signal of an unbatched event failed. A
+     *          queued event whose signals fail once the window expires is
+     *          logged and counted as dropped, it is not reported to the
+     *          caller.
+     */
+    int emit(const StateSensorEvent& event);
+
+    /** @brief Emit the queued events without waiting for the window to
+     *         expire
+     */
+    void flush();
+
+    /** @brief Get the emitter counters
+     *
+     *  @return the counters
+     */
+    const Counters& getCounters() const
+    {
+        return counters;
+    }
+
+  protected:
+    /** @brief Send the signals of the events, throws on failure
+     *
+     *  @param[in] events - the events
+     *  @param[in] batched - the events were queued, emit the
+     *                       StateSensorEvents signal
+     */
+    virtual void send(const std::vector<StateSensorEvent>& events,
+                      bool batched);
+
+  private:
+    bool perEventSignal;
+    size_t queueLimit;
+    std::chrono::milliseconds window{};
+
+    /** @brief timer emitting the queue when the window expires */
+    std::unique_ptr<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        timer;
+
+    std::vector<StateSensorEvent> queue;
+    Counters counters;
+};
+
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,205 @@
+#include "state_sensor_mirror.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+namespace platform_state_sensor
+{
+
+uint8_t getSensorState(
+    const pldm::responder::pdr_utils::StatestoDbusVal& stateToDbusValue,
+    const pldm::utils::PropertyValue& propertyValue)
+{
+    for (const auto& [state, value] : stateToDbusValue)
+    {
+        if (value == propertyValue)
+        {
+            return state;
+        }
+    }
+
+    return PLDM_SENSOR_UNKNOWN;
+}
+
+get_sensor_state_field makeStateField(uint8_t sensorState)
+{
+    uint8_t opState = PLDM_SENSOR_ENABLED;
+    if (sensorState == PLDM_SENSOR_UNKNOWN)
+    {
+        opState = PLDM_SENSOR_UNAVAILABLE;
+    }
+
+    return {opState, PLDM_SENSOR_NORMAL, PLDM_SENSOR_UNKNOWN, sensorState};
+}
+
+const StateSensorMirror::Entry* StateSensorMirror::find(uint16_t sensorId) const
+{
+    auto it = entries.find(sensorId);
+    if (it == entries.end())
+    {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+std::vector<get_sensor_state_field> StateSensorMirror::read(
+    const pldm::utils::DBusHandlerInterface& dBusIntf, uint16_t sensorId,
+    uint8_t compositeSensorCount,
+    const pldm::responder::pdr_utils::DbusMappings& dbusMappings,
+    const pldm::responder::pdr_utils::DbusValMaps& dbusValMaps)
+{
+    auto count = std::min<size_t>(
+        {compositeSensorCount, dbusMappings.size(), dbusValMaps.size()});
+
+    // Subscribe ahead of the read, so that no change is missed in between
+    bool mirrored = matches.contains(sensorId);
+    if (!mirrored && toSubscribe(sensorId))
+    {
+        try
+        {
+            subscribe(dBusIntf, sensorId, dbusMappings, dbusValMaps, count);
+            failedSubscriptions.erase(sensorId);
+            mirrored = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to watch the D-Bus properties of state sensor ID '{SENSORID}', error - {ERROR}",
+                "SENSORID", sensorId, "ERROR", e);
+            matches.erase(sensorId);
+            failedSubscriptions.insert_or_assign(
+                sensorId, std::chrono::steady_clock::now());
+        }
+    }
+
+    Entry entry{compositeSensorCount, {}};
+    entry.stateFields.reserve(count);
+    for (size_t offset = 0; offset < count; ++offset)
+    {
+        const auto& dbusMapping = dbusMappings[offset];
+        try
+        {
+            auto propertyValue = dBusIntf.getDbusPropertyVariant(
+                dbusMapping.objectPath.c_str(),
+                dbusMapping.propertyName.c_str(),
+                dbusMapping.interface.c_str());
+            entry.stateFields.emplace_back(makeStateField(
+                getSensorState(dbusValMaps[offset], propertyValue)));
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to get state sensor event state from dbus interface '{PATH}', error - {ERROR}.",
+                "PATH", dbusMapping.objectPath, "ERROR", e);
+            entry.stateFields.emplace_back(
+                makeStateField(PLDM_SENSOR_UNKNOWN));
+            mirrored = false;
+        }
+    }
+
+    if (!mirrored)
+    {
+        entries.erase(sensorId);
+        return std::move(entry.stateFields);
+    }
+    return entries.insert_or_assign(sensorId, std::move(entry))
+        .first->second.stateFields;
+}
+
+void StateSensorMirror::invalidate(uint16_t sensorId)
+{
+    entries.erase(sensorId);
+}
+
+bool StateSensorMirror::toSubscribe(uint16_t sensorId) const
+{
+    auto it = failedSubscriptions.find(sensorId);
+    return it == failedSubscriptions.end() ||
+           std::chrono::steady_clock::now() - it->second >= retryInterval;
+}
+
+void StateSensorMirror::subscribe(
+    const pldm::utils::DBusHandlerInterface& dBusIntf, uint16_t sensorId,
+    const pldm::responder::pdr_utils::DbusMappings& dbusMappings,
+    const pldm::responder::pdr_utils::DbusValMaps& dbusValMaps, size_t count)
+{
+    using namespace sdbusplus::bus::match::rules;
+
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    auto& sensorMatches = matches[sensorId];
+    for (size_t offset = 0; offset < count; ++offset)
+    {
+        const auto& dbusMapping = dbusMappings[offset];
+        auto service = dBusIntf.getService(dbusMapping.objectPath.c_str(),
+                                           dbusMapping.interface.c_str());
+        sensorMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            bus,
+            propertiesChanged(dbusMapping.objectPath, dbusMapping.interface),
+            [this, sensorId, offset, propertyName = dbusMapping.propertyName,
+             stateToDbusValue = dbusValMaps[offset]](
+                sdbusplus::message_t& msg) {
+            pldm::utils::DbusChangedProps props{};
+            std::string intf;
+            msg.read(intf, props);
+            if (auto prop = props.find(propertyName); prop != props.end())
+            {
+                setState(sensorId, offset,
+                         getSensorState(stateToDbusValue, prop->second));
+            }
+        }));
+        sensorMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            bus, interfacesRemovedAtPath(dbusMapping.objectPath),
+            [this, sensorId,
+             interface = dbusMapping.interface](sdbusplus::message_t& msg) {
+            sdbusplus::message::object_path path;
+            std::vector<std::string> interfaces;
+            msg.read(path, interfaces);
+            if (std::ranges::find(interfaces, interface) != interfaces.end())
+            {
+                invalidate(sensorId);
+            }
+        }));
+        sensorMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            bus, interfacesAddedAtPath(dbusMapping.objectPath),
+            [this, sensorId,
+             interface = dbusMapping.interface](sdbusplus::message_t& msg) {
+            sdbusplus::message::object_path path;
+            pldm::utils::InterfaceMap interfaces;
+            msg.read(path, interfaces);
+            if (interfaces.contains(interface))
+            {
+                invalidate(sensorId);
+            }
+        }));
+        // The states of a service that went away or restarted are unknown
+        sensorMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            bus, nameOwnerChanged(service),
+            [this, sensorId](sdbusplus::message_t&) {
+            invalidate(sensorId);
+        }));
+    }
+}
+
+void StateSensorMirror::setState(uint16_t sensorId, size_t offset,
+                                 uint8_t sensorState)
+{
+    auto it = entries.find(sensorId);
+    if (it == entries.end() || offset >= it->second.stateFields.size())
+    {
+        return;
+    }
+
+    it->second.stateFields[offset] = makeStateField(sensorState);
+}
+
+} // namespace platform_state_sensor
+} // namespace responder
+} // namespace pldm
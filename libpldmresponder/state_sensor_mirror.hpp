@@ -0,0 +1,174 @@
+#pragma once
+
+#include "common/utils.hpp"
+#include "pdr_utils.hpp"
+
+#include <libpldm/platform.h>
+
+#include <sdbusplus/bus/match.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+namespace platform_state_sensor
+{
+
+/** @brief Get the PLDM state a D-Bus property value maps to
+ *
+ *  @param[in] stateToDbusValue - Map of DBus property State to attribute value
+ *  @param[in] propertyValue - D-Bus property value
+ *
+ *  @return the state, PLDM_SENSOR_UNKNOWN if the value maps to none
+ */
+uint8_t getSensorState(
+    const pldm::responder::pdr_utils::StatestoDbusVal& stateToDbusValue,
+    const pldm::utils::PropertyValue& propertyValue);
+
+/** @brief Encode the state field of a composite sensor, the previous state
+ *         is left to the caller
+ *
+ *  @param[in] sensorState - PLDM state of the composite sensor
+ *
+ *  @return the state field
+ */
+get_sensor_state_field makeStateField(uint8_t sensorState);
+
+/** @class StateSensorMirror
+ *
+ *  @brief Mirrors the D-Bus properties backing the state sensors so that
+ *         GetStateSensorReadings is served from memory. The D-Bus properties
+ *         of a sensor are subscribed to on its first read, the encoded state
+ *         fields of its composite sensors are then kept up to date from the
+ *         PropertiesChanged signals. A sensor is dropped from the mirror once
+ *         one of its D-Bus objects is removed or added again, or the service
+ *         owning it loses or changes its bus name, its next read goes to
+ *         D-Bus. A read that fails is not mirrored. A sensor whose
+ *         subscriptions failed is read from D-Bus without being mirrored,
+ *         its subscriptions are retried once the retry interval elapsed.
+ */
+class StateSensorMirror
+{
+  public:
+    struct Entry
+    {
+        uint8_t compositeSensorCount; //!< composite sensor count of the PDR
+        /** @brief state fields of the composite sensors mapped to D-Bus, the
+         *         previous states are not kept
+         */
+        std::vector<get_sensor_state_field> stateFields;
+    };
+
+    /** @brief Constructor
+     *
+     *  @param[in] retryInterval - interval the failed subscriptions of a
+     *                             sensor are retried at
+     */
+    explicit StateSensorMirror(
+        std::chrono::milliseconds retryInterval = std::chrono::seconds(30)) :
+        retryInterval(retryInterval)
+    {}
+
+    StateSensorMirror(const StateSensorMirror&) = delete;
+    StateSensorMirror& operator=(const StateSensorMirror&) = delete;
+    virtual ~StateSensorMirror() = default;
+
+    /** @brief Find the mirrored states of a sensor
+     *
+     *  @param[in] sensorId - sensor ID
+     *
+     *  @return pointer to the entry, nullptr if the sensor is not mirrored
+     */
+    const Entry* find(uint16_t sensorId) const;
+
+    /** @brief Read the states of a sensor from D-Bus and mirror them, the
+     *         D-Bus properties are subscribed to ahead of the read. The
+     *         states are only mirrored if they were all read and the
+     *         subscriptions are in place.
+     *
+     *  @param[in] dBusIntf - interface the D-Bus properties are read with
+     *  @param[in] sensorId - sensor ID
+     *  @param[in] compositeSensorCount - composite sensor count from the PDR
+     *  @param[in] dbusMappings - D-Bus properties backing the sensor
+     *  @param[in] dbusValMaps - D-Bus property values to states, per
+     *                           composite sensor
+     *
+     *  @return the state fields read, per composite sensor mapped to D-Bus.
+     *          A property that can't be read is reported unavailable.
+     */
+    std::vector<get_sensor_state_field>
+        read(const pldm::utils::DBusHandlerInterface& dBusIntf,
+             uint16_t sensorId, uint8_t compositeSensorCount,
+             const pldm::responder::pdr_utils::DbusMappings& dbusMappings,
+             const pldm::responder::pdr_utils::DbusValMaps& dbusValMaps);
+
+    /** @brief Drop the states of a sensor, the next read goes to D-Bus
+     *
+     *  @param[in] sensorId - sensor ID
+     */
+    void invalidate(uint16_t sensorId);
+
+  protected:
+    /** @brief Subscribe to the D-Bus properties of a sensor, and to the
+     *         D-Bus objects and services backing them
+     *
+     *  @param[in] dBusIntf - interface the owning services are looked up with
+     *  @param[in] sensorId - sensor ID
+     *  @param[in] dbusMappings - D-Bus properties backing the sensor
+     *  @param[in] dbusValMaps - D-Bus property values to states
+     *  @param[in] count - number of composite sensors to subscribe for
+     *
+     *  @throw std::exception if a subscription can't be set up
+     */
+    virtual void
+        subscribe(const pldm::utils::DBusHandlerInterface& dBusIntf,
+                  uint16_t sensorId,
+                  const pldm::responder::pdr_utils::DbusMappings& dbusMappings,
+                  const pldm::responder::pdr_utils::DbusValMaps& dbusValMaps,
+                  size_t count);
+
+    /** @brief Set the state of a composite sensor
+     *
+     *  @param[in] sensorId - sensor ID
+     *  @param[in] offset - composite sensor offset
+     *  @param[in] sensorState - PLDM state
+     */
+    void setState(uint16_t sensorId, size_t offset, uint8_t sensorState);
+
+  private:
+    /** @brief Check if the subscriptions of a sensor are to be set up,
+     *         the sensors whose subscriptions failed are retried once the
+     *         retry interval elapsed
+     *
+     *  @param[in] sensorId - sensor ID
+     *
+     *  @return true if the subscriptions are to be set up
+     */
+    bool toSubscribe(uint16_t sensorId) const;
+
+    std::chrono::milliseconds retryInterval;
+
+    /** @brief mirrored states keyed by sensor ID */
+    std::unordered_map<uint16_t, Entry> entries;
+
+    /** @brief time the subscriptions last failed, keyed by sensor ID */
+    std::unordered_map<uint16_t, std::chrono::steady_clock::time_point>
+        failedSubscriptions;
+
+    /** @brief PropertiesChanged, InterfacesAdded, InterfacesRemoved and
+     *         NameOwnerChanged matches keyed by sensor ID
+     */
+    std::unordered_map<uint16_t,
+                       std::vector<std::unique_ptr<sdbusplus::bus::match_t>>>
+        matches;
+};
+
+} // namespace platform_state_sensor
+} // namespace responder
+} // namespace pldm
@@ -102,6 +102,29 @@ TEST_F(TestBaseCommands, testGetPLDMVersionGoodRequest)
                         &version, sizeof(version)));
 }
 
+TEST_F(TestBaseCommands, testPrecomputedResponseInstanceId)
+{
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_VERSION_REQ_BYTES>
+        requestPayload{};
+    auto request = reinterpret_cast<pldm_msg*>(requestPayload.data());
+    size_t requestPayloadLength = requestPayload.size() - sizeof(pldm_msg_hdr);
+
+    base::Handler handler(event, nullptr);
+    for (uint8_t instanceId : {0x05, 0x1a})
+    {
+        auto rc = encode_get_version_req(instanceId, 0, PLDM_GET_FIRSTPART,
+                                         PLDM_BASE, request);
+        ASSERT_EQ(0, rc);
+
+        auto response = handler.getPLDMVersion(request, requestPayloadLength);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        EXPECT_EQ(responsePtr->hdr.instance_id, instanceId);
+        EXPECT_EQ(responsePtr->hdr.request, 0);
+        EXPECT_EQ(responsePtr->hdr.command, PLDM_GET_PLDM_VERSION);
+        EXPECT_EQ(responsePtr->payload[0], PLDM_SUCCESS);
+    }
+}
+
 TEST_F(TestBaseCommands, testGetPLDMVersionBadRequest)
 {
     std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_VERSION_REQ_BYTES>
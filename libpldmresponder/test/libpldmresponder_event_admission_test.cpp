@@ -0,0 +1,156 @@
+#include "libpldmresponder/event_admission.hpp"
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder::events;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+EventAdmission::Event makeEvent(uint8_t tid, uint8_t marker)
+{
+    return {{marker}, tid, 1, 0};
+}
+
+} // namespace
+
+TEST(EventAdmission, mergeRepeats)
+{
+    EventAdmission admission(4, 100ms, 1s);
+    auto now = EventAdmission::Clock::now();
+    EventAdmission::SensorKey key{1, 10, 0, 0};
+    std::array<uint8_t, 3> data{0x01, 0x02, 0x03};
+
+    EXPECT_EQ(admission.admit(key, data, makeEvent(1, 0), now),
+              EventAdmission::Verdict::Admit);
+    admission.handled(key, data, now);
+    EXPECT_EQ(admission.admit(key, data, makeEvent(1, 1), now + 10ms),
+              EventAdmission::Verdict::Merge);
+
+    // A different state is admitted, as is a repeat outside of the window
+    std::array<uint8_t, 3> other{0x01, 0x03, 0x02};
+    EXPECT_EQ(admission.admit(key, other, makeEvent(1, 2), now + 20ms),
+              EventAdmission::Verdict::Admit);
+    admission.handled(key, other, now + 20ms);
+    EXPECT_EQ(admission.admit(key, other, makeEvent(1, 3), now + 2s),
+              EventAdmission::Verdict::Admit);
+
+    // Another sensor is tracked on its own
+    EXPECT_EQ(admission.admit({1, 11, 0, 0}, data, makeEvent(1, 4), now + 2s),
+              EventAdmission::Verdict::Admit);
+
+    const auto& counters = admission.getCounters();
+    EXPECT_EQ(counters.admitted, 4u);
+    EXPECT_EQ(counters.merged, 1u);
+    EXPECT_EQ(counters.deferred, 0u);
+}
+
+TEST(EventAdmission, deferOverLimit)
+{
+    EventAdmission admission(2, 100ms, 1s);
+    auto now = EventAdmission::Clock::now();
+    std::array<uint8_t, 1> data{};
+
+    for (uint8_t state = 0; state < 2; ++state)
+    {
+        data[0] = state;
+        EXPECT_EQ(
+            admission.admit({1, 10, 0, 0}, data, makeEvent(1, state), now),
+            EventAdmission::Verdict::Admit);
+    }
+
+    // The bucket of TID 1 is empty, the later events of a sensor replace
+    // the deferred one
+    for (uint8_t state = 2; state < 5; ++state)
+    {
+        data[0] = state;
+        EXPECT_EQ(
+            admission.admit({1, 10, 0, 0}, data, makeEvent(1, state), now),
+            EventAdmission::Verdict::Defer);
+    }
+    data[0] = 5;
+    EXPECT_EQ(admission.admit({1, 12, 0, 0}, data, makeEvent(1, 5), now),
+              EventAdmission::Verdict::Defer);
+
+    // Other termini have their own bucket
+    EXPECT_EQ(admission.admit({2, 10, 0, 0}, data, makeEvent(2, 6), now),
+              EventAdmission::Verdict::Admit);
+
+    EXPECT_TRUE(admission.release(now + 50ms).empty());
+    EXPECT_TRUE(admission.hasDeferred());
+
+    // One token back, the earliest deferred event goes first
+    auto released = admission.release(now + 100ms);
+    ASSERT_EQ(released.size(), 1u);
+    EXPECT_EQ(released[0].request, std::vector<uint8_t>{4});
+    EXPECT_TRUE(admission.hasDeferred());
+
+    released = admission.release(now + 1s);
+    ASSERT_EQ(released.size(), 1u);
+    EXPECT_EQ(released[0].request, std::vector<uint8_t>{5});
+    EXPECT_FALSE(admission.hasDeferred());
+
+    const auto& counters = admission.getCounters();
+    EXPECT_EQ(counters.admitted, 5u);
+    EXPECT_EQ(counters.merged, 2u);
+    EXPECT_EQ(counters.deferred, 2u);
+}
+
+TEST(EventAdmission, retryAfterFailure)
+{
+    EventAdmission admission(4, 100ms, 1s);
+    auto now = EventAdmission::Clock::now();
+    EventAdmission::SensorKey key{1, 10, 0, 0};
+    std::array<uint8_t, 1> data{0x01};
+
+    // The handlers failed on the event, the retry of the terminus is handled
+    EXPECT_EQ(admission.admit(key, data, makeEvent(1, 0), now),
+              EventAdmission::Verdict::Admit);
+    EXPECT_EQ(admission.admit(key, data, makeEvent(1, 1), now + 10ms),
+              EventAdmission::Verdict::Admit);
+
+    // Once handled, the repeats are merged
+    admission.handled(key, data, now + 10ms);
+    EXPECT_EQ(admission.admit(key, data, makeEvent(1, 2), now + 20ms),
+              EventAdmission::Verdict::Merge);
+
+    // A deferred event the handlers failed on is released on its retry too
+    data[0] = 0x02;
+    EXPECT_EQ(admission.admit(key, data, makeEvent(1, 3), now + 20ms),
+              EventAdmission::Verdict::Admit);
+    EXPECT_EQ(admission.admit(key, data, makeEvent(1, 4), now + 20ms),
+              EventAdmission::Verdict::Admit);
+    EXPECT_EQ(admission.admit(key, data, makeEvent(1, 5), now + 20ms),
+              EventAdmission::Verdict::Defer);
+    ASSERT_EQ(admission.release(now + 200ms).size(), 1u);
+    EXPECT_EQ(admission.admit(key, data, makeEvent(1, 6), now + 210ms),
+              EventAdmission::Verdict::Admit);
+}
+
+TEST(EventAdmission, terminusOrder)
+{
+    EventAdmission admission(1, 100ms, 1s);
+    auto now = EventAdmission::Clock::now();
+    std::array<uint8_t, 1> data{};
+
+    EXPECT_EQ(admission.admit({1, 10, 0, 0}, data, makeEvent(1, 0), now),
+              EventAdmission::Verdict::Admit);
+    EXPECT_EQ(admission.admit({1, 11, 0, 0}, data, makeEvent(1, 1), now),
+              EventAdmission::Verdict::Defer);
+
+    // The bucket has a token again, but the event of sensor 11 came in first
+    EXPECT_EQ(admission.admit({1, 12, 0, 0}, data, makeEvent(1, 2),
+                              now + 100ms),
+              EventAdmission::Verdict::Defer);
+    auto released = admission.release(now + 100ms);
+    ASSERT_EQ(released.size(), 1u);
+    EXPECT_EQ(released[0].request, std::vector<uint8_t>{1});
+
+    released = admission.release(now + 200ms);
+    ASSERT_EQ(released.size(), 1u);
+    EXPECT_EQ(released[0].request, std::vector<uint8_t>{2});
+    EXPECT_FALSE(admission.hasDeferred());
+}
@@ -4,9 +4,17 @@
 
 #include <config.h>
 #include <libpldm/pdr.h>
+#include <libpldm/utils.h>
 
 #include <sdbusplus/message.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 TEST(FruParser, allScenarios)
@@ -153,6 +161,112 @@ TEST(FruImpl, updateAssociationTreeTest)
     EXPECT_TRUE(node == NULL);
 }
 
+TEST(EntityAssociationTree, findAndMerge)
+{
+    using namespace pldm::responder::pdr_utils;
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        tree(pldm_entity_association_tree_init(),
+             pldm_entity_association_tree_destroy);
+    EntityAssociationTree entityTree(tree.get());
+
+    pldm_entity systemEntity{0x2d01, 1, 0};
+    auto systemNode = entityTree.addEntity(systemEntity, 0xFFFF, nullptr,
+                                           PLDM_ENTITY_ASSOCIAION_PHYSICAL,
+                                           false, true, 0xFFFF);
+    ASSERT_NE(systemNode, nullptr);
+    EXPECT_EQ(entityTree.find(systemEntity, false), systemNode);
+    EXPECT_EQ(entityTree.find(systemEntity, false),
+              pldm_entity_association_tree_find_with_locality(
+                  tree.get(), &systemEntity, false));
+
+    std::array<pldm_entity, 3> entities{{{0x2d01, 1, 0},
+                                         {0x40, 1, 0x8001},
+                                         {0x40, 2, 0x8001}}};
+    auto merged = entityTree.mergeRemoteAssociation(
+        entities.data(), entities.size(), PLDM_ENTITY_ASSOCIAION_PHYSICAL,
+        false);
+    ASSERT_EQ(merged.size(), 3);
+    EXPECT_EQ(merged[0], systemNode);
+    EXPECT_EQ(pldm_entity_get_num_children(systemNode,
+                                           PLDM_ENTITY_ASSOCIAION_PHYSICAL),
+              2);
+    EXPECT_EQ(entityTree.find(entities[2], true), merged[2]);
+
+    // The container of the association is not part of the tree
+    pldm_entity unknownEntity{0x2d, 5, 0};
+    entities[0] = unknownEntity;
+    EXPECT_TRUE(entityTree
+                    .mergeRemoteAssociation(entities.data(), entities.size(),
+                                            PLDM_ENTITY_ASSOCIAION_PHYSICAL,
+                                            false)
+                    .empty());
+    EXPECT_EQ(entityTree.find(unknownEntity, false), nullptr);
+}
+
+TEST(EntityAssociationTree, firstMatchAndSharedIndex)
+{
+    using namespace pldm::responder::pdr_utils;
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        tree(pldm_entity_association_tree_init(),
+             pldm_entity_association_tree_destroy);
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        bmcTree(pldm_entity_association_tree_init(),
+                pldm_entity_association_tree_destroy);
+
+    pldm_entity systemEntity{0x2d01, 1, 0};
+    auto systemNode = pldm_entity_association_tree_add_entity(
+        tree.get(), &systemEntity, 0xFFFF, nullptr,
+        PLDM_ENTITY_ASSOCIAION_PHYSICAL, false, true, 0xFFFF);
+    ASSERT_NE(systemNode, nullptr);
+    pldm_entity_association_tree_copy_root(tree.get(), bmcTree.get());
+
+    // Two slots holding the same entity under the same container ID, the
+    // first one is added directly through libpldm
+    pldm_entity slotEntity{0x40, 1, 0};
+    std::array<pldm_entity, 2> cards{{{0x41, 1, 0}, {0x41, 2, 0}}};
+    std::array<pldm_entity_node*, 2> cardNodes{};
+    for (size_t i = 0; i < cards.size(); ++i)
+    {
+        cardNodes[i] = pldm_entity_association_tree_add_entity(
+            tree.get(), &cards[i], cards[i].entity_instance_num, systemNode,
+            PLDM_ENTITY_ASSOCIAION_PHYSICAL, false, true, 0xFFFF);
+        ASSERT_NE(cardNodes[i], nullptr);
+    }
+    ASSERT_NE(pldm_entity_association_tree_add_entity(
+                  tree.get(), &slotEntity, 1, cardNodes[0],
+                  PLDM_ENTITY_ASSOCIAION_PHYSICAL, false, false, 0x10),
+              nullptr);
+
+    EntityAssociationTree fruTree(tree.get());
+    EntityAssociationTree hostTree(tree.get());
+    slotEntity.entity_container_id = 0x10;
+    auto firstMatch = pldm_entity_association_tree_find_with_locality(
+        tree.get(), &slotEntity, false);
+    ASSERT_NE(firstMatch, nullptr);
+    EXPECT_EQ(hostTree.find(slotEntity, false), firstMatch);
+
+    // The duplicate added through a wrapper does not shadow the first match
+    // in the tree order, for any wrapper of the tree
+    ASSERT_NE(fruTree.addEntity(slotEntity, 1, cardNodes[1],
+                                PLDM_ENTITY_ASSOCIAION_PHYSICAL, false, false,
+                                0x10),
+              nullptr);
+    firstMatch = pldm_entity_association_tree_find_with_locality(
+        tree.get(), &slotEntity, false);
+    EXPECT_EQ(hostTree.find(slotEntity, false), firstMatch);
+    EXPECT_EQ(fruTree.find(slotEntity, false), firstMatch);
+
+    // Resetting the tree through one wrapper drops the index of the others
+    hostTree.reset(bmcTree.get());
+    EXPECT_EQ(fruTree.find(slotEntity, false), nullptr);
+    EXPECT_EQ(fruTree.find(systemEntity, false),
+              pldm_entity_association_tree_find_with_locality(
+                  tree.get(), &systemEntity, false));
+}
+
 TEST(FruImpl, entityByObjectPath)
 {
     using namespace pldm::responder::dbus;
@@ -182,3 +296,211 @@ TEST(FruImpl, entityByObjectPath)
     entityPtr = mockedFruHandler.getEntityByObjectPath(invalidIface);
     ASSERT_TRUE(!entityPtr);
 }
+
+TEST(FruRecordIndex, copyRecords)
+{
+    using namespace pldm::responder;
+
+    // Two records of FRU record set 1, the second an OEM one, and a record of
+    // FRU record set 2
+    std::vector<uint8_t> table{
+        0x01, 0x00, 0x01, 0x02, 0x01, 0x02, 0x03, 'a', 'b', 'c', 0x03, 0x02,
+        'd',  'e',  0x01, 0x00, 0xfe, 0x01, 0x01, 0x02, 0x01, 'x', 0x02, 0x00,
+        0x01, 0x01, 0x01, 0x03, 0x01, 'y'};
+    FruRecordIndex index;
+    index.add(1, 0x01, 0, 14);
+    index.add(1, 0xfe, 14, 8);
+    index.add(2, 0x01, 22, 8);
+
+    std::vector<uint8_t> records;
+    EXPECT_EQ(index.copyRecords(table, 0, 0, 0, records), 3u);
+    EXPECT_EQ(records, table);
+
+    records.clear();
+    EXPECT_EQ(index.copyRecords(table, 1, 0, 0, records), 2u);
+    EXPECT_EQ(records, std::vector<uint8_t>(table.begin(), table.begin() + 22));
+
+    records.clear();
+    EXPECT_EQ(index.copyRecords(table, 0, 0x01, 0, records), 2u);
+    std::vector<uint8_t> generalRecords(table.begin(), table.begin() + 14);
+    generalRecords.insert(generalRecords.end(), table.begin() + 22,
+                          table.end());
+    EXPECT_EQ(records, generalRecords);
+
+    // Only the fields of the type are kept, a record having none of them is
+    // copied without fields
+    records.clear();
+    EXPECT_EQ(index.copyRecords(table, 0, 0x01, 0x02, records), 2u);
+    EXPECT_EQ(records,
+              (std::vector<uint8_t>{0x01, 0x00, 0x01, 0x01, 0x01, 0x02, 0x03,
+                                    'a', 'b', 'c', 0x02, 0x00, 0x01, 0x00,
+                                    0x01}));
+
+    records.clear();
+    EXPECT_EQ(index.copyRecords(table, 3, 0, 0, records), 0u);
+    EXPECT_EQ(index.copyRecords(table, 2, 0xfe, 0, records), 0u);
+    EXPECT_TRUE(records.empty());
+}
+
+namespace
+{
+
+/** @brief The general record of the motherboard, padded to 4 bytes */
+const std::vector<uint8_t> motherboardRecords{
+    0x01, 0x00, 0x01, 0x02, 0x01, 0x03, 0x07, 'P', 'N', '-', '0', '1',
+    '2',  '3',  0x04, 0x07, 'S',  'N',  '-',  '4', '5', '6', '7', 0x00};
+
+/** @brief FRU handler over a FRU table built from a motherboard carrying a
+ *         part number and a serial number
+ */
+class FruRecordByOptionTest : public testing::Test
+{
+  protected:
+    /** @brief A part of the record data sent by GetFRURecordByOption */
+    struct Part
+    {
+        uint8_t completionCode;
+        uint32_t nextDataTransferHandle;
+        uint8_t transferFlag;
+        std::vector<uint8_t> data;
+    };
+
+    FruRecordByOptionTest() :
+        pdrRepo(pldm_pdr_init(), pldm_pdr_destroy),
+        entityTree(pldm_entity_association_tree_init(),
+                   pldm_entity_association_tree_destroy),
+        bmcEntityTree(pldm_entity_association_tree_init(),
+                      pldm_entity_association_tree_destroy)
+    {}
+
+    /** @brief Build the FRU handler
+     *
+     *  @param[in] maxPartSize - size of the parts the record data is sent in
+     */
+    pldm::responder::fru::Handler& build(size_t maxPartSize)
+    {
+        using namespace pldm::responder::dbus;
+
+        handler = std::make_unique<pldm::responder::fru::Handler>(
+            "./fru_jsons/good", "./fru_jsons/fru_master/fru_master.json",
+            pdrRepo.get(), entityTree.get(), bmcEntityTree.get(), nullptr,
+            maxPartSize);
+        ObjectValueTree inventory{
+            {sdbusplus::message::object_path(
+                 "/xyz/openbmc_project/inventory/system/chassis/motherboard"),
+             {{"xyz.openbmc_project.Inventory.Item.Board", {}},
+              {"xyz.openbmc_project.Inventory.Item", {{"Present", true}}},
+              {"xyz.openbmc_project.Inventory.Decorator.Asset",
+               {{"PartNumber", std::string("PN-0123")},
+                {"SerialNumber", std::string("SN-4567")}}}}}};
+        handler->buildFRUTable(std::move(inventory));
+        return *handler;
+    }
+
+    /** @brief Request a part of the records of FRU record set 1 */
+    Part getPart(uint32_t dataTransferHandle, uint8_t transferOpFlag)
+    {
+        std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                                sizeof(pldm_get_fru_record_by_option_req)>
+            requestMsg{};
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+        EXPECT_EQ(encode_get_fru_record_by_option_req(
+                      0, dataTransferHandle, 0, 1, 0, 0, transferOpFlag,
+                      request, sizeof(pldm_get_fru_record_by_option_req)),
+                  PLDM_SUCCESS);
+
+        auto response = handler->getFRURecordByOption(
+            request, sizeof(pldm_get_fru_record_by_option_req));
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        Part part{};
+        part.completionCode = responsePtr->payload[0];
+        if (part.completionCode != PLDM_SUCCESS)
+        {
+            return part;
+        }
+
+        variable_field fruData{};
+        uint8_t completionCode = 0;
+        EXPECT_EQ(decode_get_fru_record_by_option_resp(
+                      responsePtr, response.size() - sizeof(pldm_msg_hdr),
+                      &completionCode, &part.nextDataTransferHandle,
+                      &part.transferFlag, &fruData),
+                  PLDM_SUCCESS);
+        part.data.assign(fruData.ptr, fruData.ptr + fruData.length);
+        return part;
+    }
+
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo;
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        entityTree;
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        bmcEntityTree;
+    std::unique_ptr<pldm::responder::fru::Handler> handler;
+};
+
+} // namespace
+
+TEST_F(FruRecordByOptionTest, singlePart)
+{
+    build(0);
+    auto part = getPart(0, PLDM_GET_FIRSTPART);
+    ASSERT_EQ(part.completionCode, PLDM_SUCCESS);
+    EXPECT_EQ(part.nextDataTransferHandle, 0u);
+    EXPECT_EQ(part.transferFlag, PLDM_START_AND_END);
+
+    // The records are followed by the CRC32 of the records and pad bytes
+    const auto& records = motherboardRecords;
+    ASSERT_EQ(part.data.size(), records.size() + sizeof(uint32_t));
+    EXPECT_TRUE(std::equal(records.begin(), records.end(), part.data.begin()));
+    uint32_t checksum = 0;
+    std::memcpy(&checksum, part.data.data() + records.size(),
+                sizeof(checksum));
+    EXPECT_EQ(checksum, crc32(records.data(), records.size()));
+
+    // The data transfer handle of a part is its offset in the data
+    EXPECT_EQ(getPart(part.data.size(), PLDM_GET_NEXTPART).completionCode,
+              PLDM_FRU_INVALID_DATA_TRANSFER_HANDLE);
+}
+
+TEST_F(FruRecordByOptionTest, multipart)
+{
+    build(12);
+    auto part = getPart(0, PLDM_GET_FIRSTPART);
+    ASSERT_EQ(part.completionCode, PLDM_SUCCESS);
+    EXPECT_EQ(part.transferFlag, PLDM_START);
+    EXPECT_EQ(part.nextDataTransferHandle, 12u);
+    auto data = part.data;
+
+    part = getPart(part.nextDataTransferHandle, PLDM_GET_NEXTPART);
+    ASSERT_EQ(part.completionCode, PLDM_SUCCESS);
+    EXPECT_EQ(part.transferFlag, PLDM_MIDDLE);
+    EXPECT_EQ(part.nextDataTransferHandle, 24u);
+    data.insert(data.end(), part.data.begin(), part.data.end());
+
+    part = getPart(part.nextDataTransferHandle, PLDM_GET_NEXTPART);
+    ASSERT_EQ(part.completionCode, PLDM_SUCCESS);
+    EXPECT_EQ(part.transferFlag, PLDM_END);
+    EXPECT_EQ(part.nextDataTransferHandle, 0u);
+    EXPECT_EQ(part.data.size(), 4u);
+    data.insert(data.end(), part.data.begin(), part.data.end());
+
+    // The parts put together are the records and their checksum
+    ASSERT_EQ(data.size(), motherboardRecords.size() + sizeof(uint32_t));
+    EXPECT_TRUE(std::equal(motherboardRecords.begin(),
+                           motherboardRecords.end(), data.begin()));
+    uint32_t checksum = 0;
+    std::memcpy(&checksum, data.data() + motherboardRecords.size(),
+                sizeof(checksum));
+    EXPECT_EQ(checksum,
+              crc32(motherboardRecords.data(), motherboardRecords.size()));
+
+    // A first part request ignores the data transfer handle
+    part = getPart(24, PLDM_GET_FIRSTPART);
+    EXPECT_EQ(part.transferFlag, PLDM_START);
+    EXPECT_EQ(part.nextDataTransferHandle, 12u);
+
+    EXPECT_EQ(getPart(data.size(), PLDM_GET_NEXTPART).completionCode,
+              PLDM_FRU_INVALID_DATA_TRANSFER_HANDLE);
+}
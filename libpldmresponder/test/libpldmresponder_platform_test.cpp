@@ -12,6 +12,8 @@
 #include <sdbusplus/test/sdbus_mock.hpp>
 #include <sdeventplus/event.hpp>
 
+#include <stdexcept>
+
 using namespace pldm::pdr;
 using namespace pldm::utils;
 using namespace pldm::responder;
@@ -20,8 +22,10 @@ using namespace pldm::responder::pdr;
 using namespace pldm::responder::pdr_utils;
 
 using ::testing::_;
+using ::testing::ByMove;
 using ::testing::Return;
 using ::testing::StrEq;
+using ::testing::Throw;
 
 TEST(getPDR, testGoodPath)
 {
@@ -222,6 +226,159 @@ TEST(getPDR, testFindPDR)
     pldm_pdr_destroy(pdrRepo);
 }
 
+TEST(getPDR, testSnapshotWalk)
+{
+    auto repo = pldm_pdr_init();
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        std::vector<uint8_t> pdr(sizeof(pldm_pdr_hdr), i);
+        uint32_t handle = 0;
+        ASSERT_EQ(pldm_pdr_add_check(repo, pdr.data(), pdr.size(), false, 1,
+                                     &handle),
+                  0);
+    }
+
+    RepoSnapshots snapshots(repo);
+    auto record = snapshots.getRecord(1, 0);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->recordHandle, 1);
+    EXPECT_EQ(record->nextRecordHandle, 2);
+
+    // Modify the repository in the middle of the walk
+    pldm_delete_by_record_handle(repo, 2, false);
+    snapshots.publish();
+
+    // The walk in progress keeps observing the generation it started on
+    record = snapshots.getRecord(1, 2);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->nextRecordHandle, 3);
+    record = snapshots.getRecord(1, 3);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->nextRecordHandle, 0);
+
+    // A new walk observes the latest generation
+    EXPECT_EQ(snapshots.getRecord(2, 2), nullptr);
+    record = snapshots.getRecord(1, 0);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->nextRecordHandle, 3);
+    EXPECT_EQ(snapshots.current()->getRecordCount(), 2);
+
+    pldm_pdr_destroy(repo);
+}
+
+TEST(getPDR, testGenerationTracking)
+{
+    auto repo = pldm_pdr_init();
+    Repo pdrRepo(repo);
+    std::vector<uint8_t> pdr(sizeof(pldm_pdr_hdr));
+    PdrEntry entry{pdr.data(), static_cast<uint32_t>(pdr.size()), {}};
+
+    // The repositories not served through snapshots are not counted, like
+    // the temporary ones built by getRepoByType()
+    pdrRepo.addRecord(entry);
+    EXPECT_EQ(getRepoGeneration(repo), 0);
+
+    {
+        RepoSnapshots snapshots(repo);
+        pdrRepo.addRecord(entry);
+        EXPECT_EQ(getRepoGeneration(repo), 1);
+        {
+            RepoSnapshots other(repo);
+            repoModified(repo);
+        }
+        EXPECT_EQ(snapshots.getGeneration(), 2);
+    }
+
+    // The generation is dropped along with the last tracker
+    EXPECT_EQ(getRepoGeneration(repo), 0);
+
+    pldm_pdr_destroy(repo);
+}
+
+TEST(removeRemotePDRs, testBatch)
+{
+    auto repo = pldm_pdr_init();
+    for (uint8_t i = 0; i < 6; ++i)
+    {
+        std::vector<uint8_t> pdr(sizeof(pldm_pdr_hdr), i);
+        uint32_t handle = 0;
+        ASSERT_EQ(pldm_pdr_add_check(repo, pdr.data(), pdr.size(), i != 0,
+                                     i % 2 ? 2 : 3, &handle),
+                  0);
+    }
+
+    auto removed = removeRemotePDRs(
+        repo, [](RecordHandle recordHandle, TerminusHandle terminusHandle) {
+        return recordHandle == 3 || terminusHandle == 2;
+    });
+    ASSERT_EQ(removed.size(), 4);
+    EXPECT_EQ(removed[0][sizeof(pldm_pdr_hdr) - 1], 1);
+    EXPECT_EQ(removed[1][sizeof(pldm_pdr_hdr) - 1], 2);
+    EXPECT_EQ(removed[2][sizeof(pldm_pdr_hdr) - 1], 3);
+    EXPECT_EQ(removed[3][sizeof(pldm_pdr_hdr) - 1], 5);
+    EXPECT_EQ(pldm_pdr_get_record_count(repo), 2);
+
+    // The local record is left alone, the remote record kept is added back
+    // with its record and terminus handles
+    uint8_t* data = nullptr;
+    uint32_t size{};
+    uint32_t nextRecordHandle{};
+    auto record = pldm_pdr_find_record(repo, 1, &data, &size,
+                                       &nextRecordHandle);
+    ASSERT_NE(record, nullptr);
+    EXPECT_FALSE(pldm_pdr_record_is_remote(record));
+    record = pldm_pdr_find_record(repo, 5, &data, &size, &nextRecordHandle);
+    ASSERT_NE(record, nullptr);
+    EXPECT_TRUE(pldm_pdr_record_is_remote(record));
+    EXPECT_EQ(pldm_pdr_get_terminus_handle(repo, record), 3);
+    EXPECT_EQ(data[sizeof(pldm_pdr_hdr) - 1], 4);
+
+    // Nothing to remove leaves the repository untouched
+    removed = removeRemotePDRs(
+        repo, [](RecordHandle, TerminusHandle) { return false; });
+    EXPECT_TRUE(removed.empty());
+    EXPECT_EQ(pldm_pdr_get_record_count(repo), 2);
+
+    pldm_pdr_destroy(repo);
+}
+
+TEST(getPDR, testInPlaceEdit)
+{
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
+        requestPayload{};
+    auto req = reinterpret_cast<pldm_msg*>(requestPayload.data());
+    size_t requestPayloadLength = requestPayload.size() - sizeof(pldm_msg_hdr);
+    auto request = reinterpret_cast<struct pldm_get_pdr_req*>(req->payload);
+    request->request_count = 100;
+
+    auto pdrRepo = pldm_pdr_init();
+    MockdBusHandler mockedUtils;
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, 0, nullptr, "", pdrRepo, nullptr, nullptr,
+                    nullptr, nullptr, nullptr, nullptr, nullptr, event);
+
+    auto getValidity = [&]() {
+        auto response = handler.getPDR(req, requestPayloadLength);
+        auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        auto resp =
+            reinterpret_cast<struct pldm_get_pdr_resp*>(responsePtr->payload);
+        EXPECT_EQ(PLDM_SUCCESS, resp->completion_code);
+        return reinterpret_cast<const pldm_terminus_locator_pdr*>(
+                   resp->record_data)
+            ->validity;
+    };
+    ASSERT_EQ(getValidity(), PLDM_TL_PDR_VALID);
+
+    // Invalidate the terminus locator PDR in place, the record count stays
+    // the same but the writer bumps the generation of the repository
+    pldm_pdr_update_TL_pdr(pdrRepo, TERMINUS_HANDLE, TERMINUS_ID, BmcMctpEid,
+                           false);
+    repoModified(pdrRepo);
+    EXPECT_EQ(getValidity(), PLDM_TL_PDR_NOT_VALID);
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
 TEST(setStateEffecterStatesHandler, testGoodRequest)
 {
     std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
@@ -407,7 +564,7 @@ TEST(getNumericEffecterValueHandler, testGoodRequest)
 {
     MockdBusHandler mockedUtils;
     EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
-        .Times(5)
+        .Times(6)
         .WillRepeatedly(Return("foo.bar"));
 
     auto inPDRRepo = pldm_pdr_init();
@@ -522,6 +679,87 @@ TEST(getNumericEffecterValueHandler, testBadRequest)
     pldm_pdr_destroy(numericEffecterPdrRepo);
 }
 
+class TestNumericEffecterValueCache :
+    public platform_numeric_effecter::NumericEffecterValueCache
+{
+  public:
+    using NumericEffecterValueCache::onInterfacesRemoved;
+    using NumericEffecterValueCache::onPropertiesChanged;
+
+    MOCK_METHOD(std::vector<std::unique_ptr<sdbusplus::bus::match_t>>, watch,
+                (uint16_t, const pldm::utils::DBusMapping&,
+                 const std::string&),
+                (override));
+};
+
+TEST(NumericEffecterValueCache, invalidation)
+{
+    constexpr uint16_t effecterId = 3;
+    constexpr auto interface = "xyz.openbmc_project.Foo.Bar";
+    pldm::utils::DBusMapping dbusMapping{"/foo/bar", interface, "propertyName",
+                                         "uint64_t"};
+
+    TestNumericEffecterValueCache valueCache;
+    EXPECT_CALL(valueCache, watch(effecterId, dbusMapping, "foo.bar"))
+        .Times(1);
+    EXPECT_EQ(valueCache.find(effecterId), nullptr);
+
+    EXPECT_TRUE(valueCache.subscribe(effecterId, dbusMapping, "foo.bar"));
+    valueCache.update(effecterId, PLDM_EFFECTER_DATA_SIZE_UINT32, "uint64_t",
+                      PropertyValue(static_cast<uint64_t>(5)));
+    auto entry = valueCache.find(effecterId);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(std::get<uint64_t>(entry->value.value()), 5);
+
+    valueCache.onPropertiesChanged(
+        effecterId, "propertyName",
+        {{"propertyName", PropertyValue(static_cast<uint64_t>(7))}});
+    entry = valueCache.find(effecterId);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(std::get<uint64_t>(entry->value.value()), 7);
+
+    // Removing another interface of the object keeps the value
+    valueCache.onInterfacesRemoved(effecterId, interface,
+                                   {"xyz.openbmc_project.Foo.Other"});
+    EXPECT_NE(valueCache.find(effecterId), nullptr);
+
+    valueCache.onInterfacesRemoved(effecterId, interface, {interface});
+    EXPECT_EQ(valueCache.find(effecterId), nullptr);
+
+    // A change of the owner of the service drops the value the same way, the
+    // subscription stays in place
+    EXPECT_TRUE(valueCache.subscribe(effecterId, dbusMapping, "foo.bar"));
+    valueCache.update(effecterId, PLDM_EFFECTER_DATA_SIZE_UINT32, "uint64_t",
+                      PropertyValue(static_cast<uint64_t>(9)));
+    EXPECT_NE(valueCache.find(effecterId), nullptr);
+    valueCache.invalidate(effecterId);
+    EXPECT_EQ(valueCache.find(effecterId), nullptr);
+}
+
+TEST(NumericEffecterValueCache, unwatchedNotCached)
+{
+    constexpr uint16_t effecterId = 3;
+    pldm::utils::DBusMapping dbusMapping{
+        "/foo/bar", "xyz.openbmc_project.Foo.Bar", "propertyName", "uint64_t"};
+
+    TestNumericEffecterValueCache valueCache;
+    EXPECT_CALL(valueCache, watch(effecterId, dbusMapping, "foo.bar"))
+        .WillOnce(Throw(std::runtime_error("No bus")))
+        .WillOnce(Return(
+            ByMove(std::vector<std::unique_ptr<sdbusplus::bus::match_t>>{})));
+
+    // The value can't be kept up to date without the subscription
+    EXPECT_FALSE(valueCache.subscribe(effecterId, dbusMapping, "foo.bar"));
+    valueCache.update(effecterId, PLDM_EFFECTER_DATA_SIZE_UINT32, "uint64_t",
+                      PropertyValue(static_cast<uint64_t>(5)));
+    EXPECT_EQ(valueCache.find(effecterId), nullptr);
+
+    EXPECT_TRUE(valueCache.subscribe(effecterId, dbusMapping, "foo.bar"));
+    valueCache.update(effecterId, PLDM_EFFECTER_DATA_SIZE_UINT32, "uint64_t",
+                      PropertyValue(static_cast<uint64_t>(5)));
+    EXPECT_NE(valueCache.find(effecterId), nullptr);
+}
+
 TEST(parseStateSensor, allScenarios)
 {
     // Sample state sensor with SensorID - 1, EntityType - Processor Module(67)
@@ -742,6 +980,75 @@ TEST(StateSensorHandler, allScenarios)
     }
 }
 
+TEST(StateSensorHandler, eventAction)
+{
+    using namespace pldm::responder::events;
+
+    StateSensorHandler handler{"./event_jsons/good"};
+
+    // Event state not configured for the sensor
+    EXPECT_EQ(handler.eventAction({1, 64, 1, 1, 1, false}, 0),
+              PLDM_ERROR_INVALID_DATA);
+    // Sensor in a container that is not configured
+    EXPECT_EQ(handler.eventAction({3, 64, 1, 0, 1, false}, 0), PLDM_SUCCESS);
+    // Entry without container ID matches any container
+    EXPECT_EQ(handler.eventAction({10, 120, 2, 0, 2, false}, 3),
+              PLDM_ERROR_INVALID_DATA);
+    // No BMC action for the sensor
+    EXPECT_EQ(handler.eventAction({0, 0, 0, 0, 1, false}, 0), PLDM_SUCCESS);
+}
+
+class MockStateSensorHandler :
+    public pldm::responder::events::StateSensorHandler
+{
+  public:
+    using StateSensorHandler::StateSensorHandler;
+
+    std::vector<std::pair<std::string, PropertyValue>> writes;
+
+  protected:
+    void writeProperty(const DBusMapping& dbusMapping,
+                       const PropertyValue& value) override
+    {
+        writes.emplace_back(dbusMapping.propertyName, value);
+    }
+};
+
+TEST(StateSensorHandler, coalescedWrites)
+{
+    using namespace std::chrono_literals;
+
+    MockStateSensorHandler handler{"./event_jsons/good"};
+    auto event = sdeventplus::Event::get_default();
+
+    // value1 is written again after value2, the later value is sent in the
+    // slot of the first write, ahead of value2
+    EXPECT_EQ(handler.eventAction({1, 64, 1, 0, 1, false}, 0), PLDM_SUCCESS);
+    EXPECT_EQ(handler.eventAction({1, 64, 1, 1, 1, false}, 2), PLDM_SUCCESS);
+    EXPECT_EQ(handler.eventAction({1, 64, 1, 0, 1, false}, 1), PLDM_SUCCESS);
+    EXPECT_EQ(handler.eventAction({2, 67, 2, 0, 1, false}, 1), PLDM_SUCCESS);
+    EXPECT_EQ(handler.eventAction({1, 64, 1, 0, 1, false}, 2), PLDM_SUCCESS);
+    EXPECT_TRUE(handler.writes.empty());
+
+    event.run(100ms);
+    EXPECT_EQ(handler.writes,
+              (std::vector<std::pair<std::string, PropertyValue>>{
+                  {"value1", std::string("xyz.openbmc_project.State.Fatal")},
+                  {"value2", static_cast<uint8_t>(9)},
+                  {"value3", true}}));
+
+    // The writes queued once sent are sent in a new batch
+    EXPECT_EQ(handler.eventAction({1, 64, 1, 1, 1, false}, 3), PLDM_SUCCESS);
+    EXPECT_EQ(handler.eventAction({1, 64, 1, 0, 1, false}, 0), PLDM_SUCCESS);
+    handler.writes.clear();
+    event.run(100ms);
+    EXPECT_EQ(handler.writes,
+              (std::vector<std::pair<std::string, PropertyValue>>{
+                  {"value2", static_cast<uint8_t>(10)},
+                  {"value1",
+                   std::string("xyz.openbmc_project.State.Normal")}}));
+}
+
 TEST(TerminusLocatorPDR, BMCTerminusLocatorPDR)
 {
     auto inPDRRepo = pldm_pdr_init();
@@ -0,0 +1,98 @@
+#include "libpldmresponder/sensor_event_emitter.hpp"
+
+#include <libpldm/base.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+class MockEmitter : public StateSensorEventEmitter
+{
+  public:
+    using StateSensorEventEmitter::StateSensorEventEmitter;
+
+    std::vector<std::pair<std::vector<StateSensorEvent>, bool>> sent;
+    bool fail = false;
+
+  protected:
+    void send(const std::vector<StateSensorEvent>& events,
+              bool batched) override
+    {
+        if (fail)
+        {
+            throw std::runtime_error("send failed");
+        }
+        sent.emplace_back(events, batched);
+    }
+};
+
+} // namespace
+
+TEST(StateSensorEventEmitter, unbatched)
+{
+    MockEmitter emitter(true, 8);
+
+    EXPECT_EQ(emitter.emit({1, 10, 0, 2, 1}), PLDM_SUCCESS);
+    EXPECT_EQ(emitter.emit({1, 11, 0, 2, 1}), PLDM_SUCCESS);
+    ASSERT_EQ(emitter.sent.size(), 2u);
+    EXPECT_FALSE(emitter.sent[0].second);
+    EXPECT_EQ(emitter.sent[1].first,
+              (std::vector<StateSensorEventEmitter::StateSensorEvent>{
+                  {1, 11, 0, 2, 1}}));
+
+    emitter.fail = true;
+    EXPECT_EQ(emitter.emit({1, 12, 0, 2, 1}), PLDM_ERROR);
+
+    const auto& counters = emitter.getCounters();
+    EXPECT_EQ(counters.emitted, 2u);
+    EXPECT_EQ(counters.dropped, 1u);
+    EXPECT_EQ(counters.batches, 0u);
+}
+
+TEST(StateSensorEventEmitter, batched)
+{
+    auto event = sdeventplus::Event::get_new();
+    MockEmitter emitter(true, 3);
+    emitter.start(event, 10ms);
+
+    EXPECT_EQ(emitter.emit({1, 10, 0, 2, 1}), PLDM_SUCCESS);
+    EXPECT_EQ(emitter.emit({1, 11, 0, 2, 1}), PLDM_SUCCESS);
+    EXPECT_TRUE(emitter.sent.empty());
+    EXPECT_EQ(emitter.getCounters().queueDepth, 2u);
+
+    // The window expires
+    for (int i = 0; i < 100 && emitter.sent.empty(); ++i)
+    {
+        event.run(100ms);
+    }
+    ASSERT_EQ(emitter.sent.size(), 1u);
+    EXPECT_TRUE(emitter.sent[0].second);
+    EXPECT_EQ(emitter.sent[0].first.size(), 2u);
+
+    // A full queue does not wait for the window
+    for (uint16_t sensorId = 0; sensorId < 3; ++sensorId)
+    {
+        emitter.emit({1, sensorId, 0, 2, 1});
+    }
+    ASSERT_EQ(emitter.sent.size(), 2u);
+    EXPECT_EQ(emitter.sent[1].first.size(), 3u);
+
+    emitter.fail = true;
+    emitter.emit({1, 10, 0, 2, 1});
+    emitter.flush();
+
+    const auto& counters = emitter.getCounters();
+    EXPECT_EQ(counters.queueDepth, 0u);
+    EXPECT_EQ(counters.maxQueueDepth, 3u);
+    EXPECT_EQ(counters.batches, 2u);
+    EXPECT_EQ(counters.emitted, 5u);
+    EXPECT_EQ(counters.dropped, 1u);
+}
@@ -0,0 +1,131 @@
+#include "common/test/mocked_utils.hpp"
+#include "libpldmresponder/state_sensor_mirror.hpp"
+
+#include <libpldm/platform.h>
+
+#include <stdexcept>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+using namespace pldm::responder::pdr_utils;
+using namespace pldm::responder::platform_state_sensor;
+using ::testing::_;
+using ::testing::Return;
+using ::testing::Throw;
+
+namespace
+{
+
+class MockMirror : public StateSensorMirror
+{
+  public:
+    using StateSensorMirror::StateSensorMirror;
+    using StateSensorMirror::setState;
+
+    bool subscribeFails = false;
+    size_t subscriptions = 0;
+
+  protected:
+    void subscribe(const DBusHandlerInterface&, uint16_t,
+                   const DbusMappings&, const DbusValMaps&, size_t) override
+    {
+        ++subscriptions;
+        if (subscribeFails)
+        {
+            throw std::runtime_error("No bus");
+        }
+    }
+};
+
+const DbusMappings dbusMappings{{"/foo/bar", "xyz.openbmc_project.Foo.Bar",
+                                 "propertyName", "string"}};
+const DbusValMaps dbusValMaps{
+    {{0, PropertyValue(std::string("xyz.openbmc_project.Foo.Bar.V0"))},
+     {1, PropertyValue(std::string("xyz.openbmc_project.Foo.Bar.V1"))},
+     {2, PropertyValue(std::string("xyz.openbmc_project.Foo.Bar.V2"))}}};
+
+} // namespace
+
+TEST(StateSensorMirror, failedReadNotMirrored)
+{
+    MockdBusHandler dbusHandler;
+    MockMirror mirror;
+    EXPECT_CALL(dbusHandler, getDbusPropertyVariant(_, _, _))
+        .WillOnce(Throw(std::runtime_error("No such object")))
+        .WillOnce(Return(
+            PropertyValue(std::string("xyz.openbmc_project.Foo.Bar.V1"))));
+
+    // A failed read is reported unavailable and read again the next time
+    auto fields = mirror.read(dbusHandler, 1, 1, dbusMappings, dbusValMaps);
+    ASSERT_EQ(fields.size(), 1);
+    EXPECT_EQ(fields[0].sensor_op_state, PLDM_SENSOR_UNAVAILABLE);
+    EXPECT_EQ(mirror.find(1), nullptr);
+
+    fields = mirror.read(dbusHandler, 1, 1, dbusMappings, dbusValMaps);
+    ASSERT_EQ(fields.size(), 1);
+    EXPECT_EQ(fields[0].sensor_op_state, PLDM_SENSOR_ENABLED);
+    EXPECT_EQ(fields[0].event_state, 1);
+
+    // Later readings and changes are served from memory
+    auto entry = mirror.find(1);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->compositeSensorCount, 1);
+    mirror.setState(1, 0, 2);
+    EXPECT_EQ(mirror.find(1)->stateFields[0].event_state, 2);
+
+    // An invalidated sensor is read from D-Bus again
+    mirror.invalidate(1);
+    EXPECT_EQ(mirror.find(1), nullptr);
+}
+
+TEST(StateSensorMirror, unwatchedNotMirrored)
+{
+    MockdBusHandler dbusHandler;
+    MockMirror mirror;
+    mirror.subscribeFails = true;
+    EXPECT_CALL(dbusHandler, getDbusPropertyVariant(_, _, _))
+        .WillOnce(Return(
+            PropertyValue(std::string("xyz.openbmc_project.Foo.Bar.V2"))));
+
+    // The states read can't be kept up to date without the subscriptions
+    auto fields = mirror.read(dbusHandler, 1, 1, dbusMappings, dbusValMaps);
+    ASSERT_EQ(fields.size(), 1);
+    EXPECT_EQ(fields[0].event_state, 2);
+    EXPECT_EQ(mirror.find(1), nullptr);
+}
+
+TEST(StateSensorMirror, failedSubscriptionRetried)
+{
+    using namespace std::chrono_literals;
+
+    MockdBusHandler dbusHandler;
+    EXPECT_CALL(dbusHandler, getDbusPropertyVariant(_, _, _))
+        .WillRepeatedly(Return(
+            PropertyValue(std::string("xyz.openbmc_project.Foo.Bar.V1"))));
+
+    // The failed subscriptions are not retried within the retry interval
+    MockMirror mirror(1h);
+    mirror.subscribeFails = true;
+    mirror.read(dbusHandler, 1, 1, dbusMappings, dbusValMaps);
+    mirror.read(dbusHandler, 1, 1, dbusMappings, dbusValMaps);
+    EXPECT_EQ(mirror.subscriptions, 1);
+    EXPECT_EQ(mirror.find(1), nullptr);
+
+    // The other sensors are subscribed to as usual
+    mirror.subscribeFails = false;
+    mirror.read(dbusHandler, 2, 1, dbusMappings, dbusValMaps);
+    EXPECT_EQ(mirror.subscriptions, 2);
+    EXPECT_NE(mirror.find(2), nullptr);
+
+    // Once the retry interval elapsed the sensor is mirrored
+    MockMirror retryingMirror(0ms);
+    retryingMirror.subscribeFails = true;
+    retryingMirror.read(dbusHandler, 1, 1, dbusMappings, dbusValMaps);
+    retryingMirror.subscribeFails = false;
+    retryingMirror.read(dbusHandler, 1, 1, dbusMappings, dbusValMaps);
+    EXPECT_EQ(retryingMirror.subscriptions, 2);
+    EXPECT_NE(retryingMirror.find(1), nullptr);
+}
@@ -0,0 +1,297 @@
+#include "cert_exchange.hpp"
+
+#include <libpldm/base.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <algorithm>
+#include <functional>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+
+constexpr auto certObjPath = "/xyz/openbmc_project/certs/ca/entry/";
+constexpr auto certEntryIntf = "xyz.openbmc_project.Certs.Entry";
+
+CertExchange::~CertExchange()
+{
+    for (const auto& [fileHandle, exchange] : exchanges)
+    {
+        if (exchange.csrFd >= 0)
+        {
+            close(exchange.csrFd);
+        }
+        if (exchange.certFd >= 0)
+        {
+            close(exchange.certFd);
+        }
+    }
+}
+
+CertExchange& CertExchange::get()
+{
+    static CertExchange certExchange;
+    return certExchange;
+}
+
+std::optional<uint32_t> CertExchange::stageCsr(uint32_t fileHandle,
+                                               const std::string& csr)
+{
+    auto name = "CSR_" + std::to_string(fileHandle);
+    int fd = memfd_create(name.c_str(), MFD_CLOEXEC);
+    if (fd == -1)
+    {
+        error(
+            "Failed to create the CSR file for file handle '{FILE_HANDLE}', error number - {ERROR_NUM}",
+            "FILE_HANDLE", fileHandle, "ERROR_NUM", errno);
+        return std::nullopt;
+    }
+
+    size_t written = 0;
+    while (written < csr.size())
+    {
+        auto rc = ::write(fd, csr.data() + written, csr.size() - written);
+        if (rc == -1)
+        {
+            error(
+                "Failed to stage the CSR for file handle '{FILE_HANDLE}', error number - {ERROR_NUM}",
+                "FILE_HANDLE", fileHandle, "ERROR_NUM", errno);
+            close(fd);
+            return std::nullopt;
+        }
+        written += rc;
+    }
+
+    end(fileHandle);
+    exchanges.emplace(fileHandle,
+                      Exchange{State::CsrStaged, fd,
+                               static_cast<uint32_t>(csr.size())});
+    return csr.size();
+}
+
+int CertExchange::getCsrFd(uint32_t fileHandle) const
+{
+    auto it = exchanges.find(fileHandle);
+    return it == exchanges.end() ? -1 : it->second.csrFd;
+}
+
+uint32_t CertExchange::getCsrSize(uint32_t fileHandle) const
+{
+    auto it = exchanges.find(fileHandle);
+    return it == exchanges.end() || it->second.csrFd < 0 ? 0
+                                                         : it->second.csrSize;
+}
+
+void CertExchange::csrRead(uint32_t fileHandle, uint64_t end)
+{
+    auto it = exchanges.find(fileHandle);
+    if (it == exchanges.end() || it->second.csrFd < 0 ||
+        end < it->second.csrSize)
+    {
+        return;
+    }
+
+    close(it->second.csrFd);
+    it->second.csrFd = -1;
+    it->second.state = State::CsrSent;
+}
+
+int CertExchange::beginCert(uint32_t fileHandle, uint64_t length)
+{
+    auto name = "ClientCert_" + std::to_string(fileHandle);
+    int fd = memfd_create(name.c_str(), MFD_CLOEXEC);
+    if (fd == -1)
+    {
+        error(
+            "Failed to create the client certificate file for file handle '{FILE_HANDLE}', error number - {ERROR_NUM}",
+            "FILE_HANDLE", fileHandle, "ERROR_NUM", errno);
+        return PLDM_ERROR;
+    }
+
+    auto& exchange = exchanges[fileHandle];
+    if (exchange.certFd >= 0)
+    {
+        close(exchange.certFd);
+    }
+    exchange.state = State::CertReceiving;
+    exchange.certFd = fd;
+    exchange.remaining = length;
+    return PLDM_SUCCESS;
+}
+
+int CertExchange::getCertFd(uint32_t fileHandle) const
+{
+    auto it = exchanges.find(fileHandle);
+    return it == exchanges.end() ? -1 : it->second.certFd;
+}
+
+int CertExchange::writeCert(uint32_t fileHandle, const char* buffer,
+                            uint32_t offset, uint32_t& length)
+{
+    auto fd = getCertFd(fileHandle);
+    if (fd < 0)
+    {
+        error(
+            "Failed to find the client certificate for file handle '{FILE_HANDLE}'",
+            "FILE_HANDLE", fileHandle);
+        return PLDM_ERROR;
+    }
+
+    auto rc = pwrite(fd, buffer, length, offset);
+    if (rc == -1)
+    {
+        error(
+            "Failed to write certificate at offset '{OFFSET}' of length '{LENGTH}', error number - {ERROR_NUM}",
+            "OFFSET", offset, "LENGTH", length, "ERROR_NUM", errno);
+        return PLDM_ERROR;
+    }
+    length = rc;
+    certWritten(fileHandle, length);
+    return PLDM_SUCCESS;
+}
+
+void CertExchange::certWritten(uint32_t fileHandle, uint64_t length)
+{
+    auto it = exchanges.find(fileHandle);
+    if (it == exchanges.end() || it->second.certFd < 0)
+    {
+        return;
+    }
+
+    auto& exchange = it->second;
+    exchange.remaining -= std::min(length, exchange.remaining);
+    if (!exchange.remaining)
+    {
+        completeCert(fileHandle, exchange);
+    }
+}
+
+void CertExchange::completeCert(uint32_t fileHandle, Exchange& exchange)
+{
+    std::string cert;
+    auto size = lseek(exchange.certFd, 0, SEEK_END);
+    if (size > 0)
+    {
+        cert.resize(size);
+        auto rc = pread(exchange.certFd, cert.data(), cert.size(), 0);
+        cert.resize(std::max<ssize_t>(rc, 0));
+    }
+
+    if (!cert.empty())
+    {
+        info(
+            "Client certificate write status 'complete' for file handle '{FILE_HANDLE}'",
+            "FILE_HANDLE", fileHandle);
+        publish(fileHandle, "ClientCertificate", cert);
+        publish(fileHandle, "Status", certStatusComplete);
+    }
+    else
+    {
+        info(
+            "Client certificate write status 'Bad CSR' for file handle '{FILE_HANDLE}'",
+            "FILE_HANDLE", fileHandle);
+        publish(fileHandle, "Status", certStatusBadCsr);
+    }
+    end(fileHandle);
+}
+
+void CertExchange::end(uint32_t fileHandle)
+{
+    auto it = exchanges.find(fileHandle);
+    if (it == exchanges.end())
+    {
+        return;
+    }
+
+    if (it->second.csrFd >= 0)
+    {
+        close(it->second.csrFd);
+    }
+    if (it->second.certFd >= 0)
+    {
+        close(it->second.certFd);
+    }
+    exchanges.erase(it);
+}
+
+void CertExchange::publishStatus(uint32_t fileHandle,
+                                 const std::string& status)
+{
+    publish(fileHandle, "Status", status);
+    if (status == certStatusBadCsr)
+    {
+        end(fileHandle);
+    }
+}
+
+std::optional<CertExchange::State>
+    CertExchange::getState(uint32_t fileHandle) const
+{
+    auto it = exchanges.find(fileHandle);
+    if (it == exchanges.end())
+    {
+        return std::nullopt;
+    }
+
+    return it->second.state;
+}
+
+void CertExchange::publish(uint32_t fileHandle, const std::string& property,
+                           const std::string& value)
+{
+    auto key = std::make_tuple(fileHandle, property);
+    if (auto it = pendingWriteIndex.find(key); it != pendingWriteIndex.end())
+    {
+        pendingWrites[it->second].second = value;
+    }
+    else
+    {
+        pendingWriteIndex.emplace(std::move(key), pendingWrites.size());
+        pendingWrites.emplace_back(
+            pldm::utils::DBusMapping{certObjPath + std::to_string(fileHandle),
+                                     certEntryIntf, property, "string"},
+            value);
+    }
+
+    if (!writeEvent)
+    {
+        writeEvent = std::make_unique<sdeventplus::source::Defer>(
+            sdeventplus::Event::get_default(),
+            std::bind(std::mem_fn(&CertExchange::processPendingWrites), this,
+                      std::placeholders::_1));
+    }
+}
+
+void CertExchange::processPendingWrites(
+    sdeventplus::source::EventBase& /*source */)
+{
+    writeEvent.reset();
+    auto writes = std::move(pendingWrites);
+    pendingWrites.clear();
+    pendingWriteIndex.clear();
+
+    for (const auto& [dbusMapping, value] : writes)
+    {
+        try
+        {
+            pldm::utils::DBusHandler().setDbusProperty(dbusMapping, value);
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to set property '{PROPERTY}' of certificate entry '{PATH}', error - {ERROR}",
+                "PROPERTY", dbusMapping.propertyName, "PATH",
+                dbusMapping.objectPath, "ERROR", e);
+        }
+    }
+}
+
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "common/utils.hpp"
+
+#include <sdeventplus/source/event.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+
+constexpr auto certStatusComplete =
+    "xyz.openbmc_project.Certs.Entry.State.Complete";
+constexpr auto certStatusPending =
+    "xyz.openbmc_project.Certs.Entry.State.Pending";
+constexpr auto certStatusBadCsr =
+    "xyz.openbmc_project.Certs.Entry.State.BadCSR";
+
+/** @class CertExchange
+ *
+ *  @brief Pipeline of the certificate exchanges with the host, keyed by the
+ *  file handle shared by a CSR and the client certificate signed from it.
+ *
+ *  The CSRs and the client certificates are staged in memory backed files
+ *  instead of the filesystem, so that neither the D-Bus signal handlers nor
+ *  the file I/O commands wait on the storage. The state of each exchange is
+ *  kept in memory until the client certificate is published or the CSR is
+ *  rejected, and the status of the certificate entries is published from a
+ *  deferred event source, once the PLDM response went out.
+ */
+class CertExchange
+{
+  public:
+    enum class State
+    {
+        CsrStaged,     //!< the CSR waits to be read by the host
+        CsrSent,       //!< the host read the whole CSR
+        CertReceiving, //!< the host is writing the client certificate
+    };
+
+    CertExchange(const CertExchange&) = delete;
+    CertExchange& operator=(const CertExchange&) = delete;
+    CertExchange(CertExchange&&) = delete;
+    CertExchange& operator=(CertExchange&&) = delete;
+    ~CertExchange();
+
+    /** @brief Get the certificate exchange pipeline
+     *
+     *  @return reference to the certificate exchange pipeline
+     */
+    static CertExchange& get();
+
+    /** @brief Stage a CSR for the host to read
+     *
+     *  @param[in] fileHandle - file handle of the certificate entry
+     *  @param[in] csr - content of the CSR
+     *
+     *  @return size of the staged CSR, std::nullopt if it could not be staged
+     */
+    std::optional<uint32_t> stageCsr(uint32_t fileHandle,
+                                     const std::string& csr);
+
+    /** @brief Get the file descriptor of a staged CSR
+     *
+     *  @param[in] fileHandle - file handle of the certificate entry
+     *
+     *  @return file descriptor, owned by the pipeline, -1 if no CSR is staged
+     */
+    int getCsrFd(uint32_t fileHandle) const;
+
+    /** @brief Get the size of a staged CSR
+     *
+     *  @param[in] fileHandle - file handle of the certificate entry
+     *
+     *  @return size of the CSR, 0 if no CSR is staged
+     */
+    uint32_t getCsrSize(uint32_t fileHandle) const;
+
+    /** @brief Record that the host read a CSR up to an offset, the CSR is
+     *         dropped once read to its end
+     *
+     *  @param[in] fileHandle - file handle of the certificate entry
+     *  @param[in] end - offset the host read the CSR up to
+     */
+    void csrRead(uint32_t fileHandle, uint64_t end);
+
+    /** @brief Stage the client certificate the host is about to write
+     *
+     *  @param[in] fileHandle - file handle of the certificate entry
+     *  @param[in] length - length of the client certificate
+     *
+     *  @return PLDM completion code
+     */
+    int beginCert(uint32_t fileHandle, uint64_t length);
+
+    /** @brief Get the file descriptor the client certificate is staged in
+     *
+     *  @param[in] fileHandle - file handle of the certificate entry
+     *
+     *  @return file descriptor, owned by the pipeline, -1 if no client
+     *          certificate is being received
+     */
+    int getCertFd(uint32_t fileHandle) const;
+
+    /** @brief Write a part of the client certificate
+     *
+     *  @param[in] fileHandle - file handle of the certificate entry
+     *  @param[in] buffer - data of the part
+     *  @param[in] offset - offset of the part in the client certificate
+     *  @param[in,out] length - length of the part, length written on return
+     *
+     *  @return PLDM completion code
+     */
+    int writeCert(uint32_t fileHandle, const char* buffer, uint32_t offset,
+                  uint32_t& length);
+
+    /** @brief Record that a part of the client certificate was written to
+     *         its file descriptor, the certificate is published once all of
+     *         it was written
+     *
+     *  @param[in] fileHandle - file handle of the certificate entry
+     *  @param[in] length - length of the part
+     */
+    void certWritten(uint32_t fileHandle, uint64_t length);
+
+    /** @brief Publish the status of a certificate entry, the exchange ends
+     *         if the CSR is rejected
+     *
+     *  @param[in] fileHandle - file handle of the certificate entry
+     *  @param[in] status - Status property value
+     */
+    void publishStatus(uint32_t fileHandle, const std::string& status);
+
+    /** @brief Get the state of an exchange
+     *
+     *  @param[in] fileHandle - file handle of the certificate entry
+     *
+     *  @return state, std::nullopt if the exchange is not tracked
+     */
+    std::optional<State> getState(uint32_t fileHandle) const;
+
+  private:
+    CertExchange() = default;
+
+    struct Exchange
+    {
+        State state;
+        int csrFd = -1;         //!< staged CSR
+        uint32_t csrSize = 0;   //!< size of the staged CSR
+        int certFd = -1;        //!< staged client certificate
+        uint64_t remaining = 0; //!< length of the certificate left to write
+    };
+
+    /** @brief Publish the client certificate once it was written, which
+     *         ends the exchange
+     *
+     *  @param[in] fileHandle - file handle of the certificate entry
+     *  @param[in] exchange - the exchange
+     */
+    void completeCert(uint32_t fileHandle, Exchange& exchange);
+
+    /** @brief End an exchange
+     *
+     *  @param[in] fileHandle - file handle of the certificate entry
+     */
+    void end(uint32_t fileHandle);
+
+    /** @brief Queue a property write of a certificate entry
+     *
+     *  @param[in] fileHandle - file handle of the certificate entry
+     *  @param[in] property - property name
+     *  @param[in] value - property value
+     */
+    void publish(uint32_t fileHandle, const std::string& property,
+                 const std::string& value);
+
+    /** @brief Send the pending D-Bus property writes
+     *
+     *  @param[in] source - sdeventplus event source
+     */
+    void processPendingWrites(sdeventplus::source::EventBase& source);
+
+    /** @brief exchanges keyed by file handle */
+    std::unordered_map<uint32_t, Exchange> exchanges;
+
+    /** @brief D-Bus property writes waiting to be sent, in arrival order */
+    std::vector<std::pair<pldm::utils::DBusMapping, pldm::utils::PropertyValue>>
+        pendingWrites;
+
+    /** @brief index of the pending write of a property, keyed by the file
+     *         handle and the property name
+     */
+    std::map<std::tuple<uint32_t, std::string>, size_t> pendingWriteIndex;
+
+    /** @brief event source sending the pending writes */
+    std::unique_ptr<sdeventplus::source::Defer> writeEvent;
+};
+
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,208 @@
+#include "dump_entry_index.hpp"
+
+#include "common/utils.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <vector>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+
+namespace
+{
+
+constexpr auto dumpManagerPath = "/xyz/openbmc_project/dump";
+constexpr auto dumpEntriesPath = "/xyz/openbmc_project/dump/";
+constexpr auto dumpEntryIntf = "xyz.openbmc_project.Dump.Entry";
+constexpr auto offloadUriProperty = "OffloadUri";
+constexpr auto sourceDumpIdProperty = "SourceDumpId";
+
+} // namespace
+
+DumpEntryIndex::DumpEntryIndex()
+{
+    using namespace sdbusplus::bus::match::rules;
+    auto& bus = pldm::utils::DBusHandler::getBus();
+
+    interfacesAddedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        bus, interfacesAdded() + argNpath(0, dumpEntriesPath),
+        [this](sdbusplus::message_t& msg) {
+        try
+        {
+            sdbusplus::message::object_path path;
+            pldm::dbus::InterfaceMap interfaces;
+            msg.read(path, interfaces);
+            for (const auto& [interface, properties] : interfaces)
+            {
+                update(path.str, interface, properties);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to index the added dump entry at path '{PATH}', error - {ERROR}",
+                "PATH", msg.get_path(), "ERROR", e);
+        }
+    });
+
+    interfacesRemovedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        bus, interfacesRemoved() + argNpath(0, dumpEntriesPath),
+        [this](sdbusplus::message_t& msg) {
+        try
+        {
+            sdbusplus::message::object_path path;
+            std::vector<std::string> interfaces;
+            msg.read(path, interfaces);
+            if (std::ranges::find(interfaces, dumpEntryIntf) !=
+                interfaces.end())
+            {
+                remove(path.str);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to drop the removed dump entry at path '{PATH}', error - {ERROR}",
+                "PATH", msg.get_path(), "ERROR", e);
+        }
+    });
+
+    propertiesChangedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        bus,
+        type::signal() + member("PropertiesChanged") +
+            interface("org.freedesktop.DBus.Properties") +
+            path_namespace(dumpManagerPath),
+        [this](sdbusplus::message_t& msg) {
+        try
+        {
+            std::string interface;
+            pldm::dbus::PropertyMap properties;
+            msg.read(interface, properties);
+            update(msg.get_path(), interface, properties);
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to update the dump entry at path '{PATH}', error - {ERROR}",
+                "PATH", msg.get_path(), "ERROR", e);
+        }
+    });
+}
+
+DumpEntryIndex& DumpEntryIndex::get()
+{
+    static DumpEntryIndex dumpEntryIndex;
+    return dumpEntryIndex;
+}
+
+std::optional<std::string>
+    DumpEntryIndex::findBySourceDumpId(const std::string& interface,
+                                       uint32_t sourceDumpId)
+{
+    auto ids = sourceDumpIdIndex.find(interface);
+    if (ids == sourceDumpIdIndex.end())
+    {
+        return std::nullopt;
+    }
+
+    auto path = ids->second.find(sourceDumpId);
+    if (path == ids->second.end())
+    {
+        return std::nullopt;
+    }
+
+    return path->second;
+}
+
+std::optional<std::string>
+    DumpEntryIndex::getOffloadUri(const std::string& path)
+{
+    auto entry = entries.find(path);
+    if (entry == entries.end() || entry->second.offloadUri.empty())
+    {
+        return std::nullopt;
+    }
+
+    return entry->second.offloadUri;
+}
+
+void DumpEntryIndex::seed(const pldm::dbus::ObjectValueTree& objects)
+{
+    entries.clear();
+    sourceDumpIdIndex.clear();
+    for (const auto& [path, interfaces] : objects)
+    {
+        for (const auto& [interface, properties] : interfaces)
+        {
+            update(path.str, interface, properties);
+        }
+    }
+}
+
+void DumpEntryIndex::update(const std::string& path,
+                            const std::string& interface,
+                            const pldm::dbus::PropertyMap& properties)
+{
+    for (const auto& [name, value] : properties)
+    {
+        if (name == offloadUriProperty && interface == dumpEntryIntf)
+        {
+            auto uri = std::get_if<std::string>(&value);
+            if (uri)
+            {
+                entries[path].offloadUri = *uri;
+            }
+        }
+        else if (name == sourceDumpIdProperty)
+        {
+            auto sourceDumpId = std::get_if<uint32_t>(&value);
+            if (!sourceDumpId)
+            {
+                continue;
+            }
+
+            auto& ids = sourceDumpIdIndex[interface];
+            auto& entry = entries[path];
+            if (auto prev = entry.sourceDumpIds.find(interface);
+                prev != entry.sourceDumpIds.end())
+            {
+                if (auto it = ids.find(prev->second);
+                    it != ids.end() && it->second == path)
+                {
+                    ids.erase(it);
+                }
+            }
+            entry.sourceDumpIds.insert_or_assign(interface, *sourceDumpId);
+            ids.insert_or_assign(*sourceDumpId, path);
+        }
+    }
+}
+
+void DumpEntryIndex::remove(const std::string& path)
+{
+    auto entry = entries.find(path);
+    if (entry == entries.end())
+    {
+        return;
+    }
+
+    for (const auto& [interface, sourceDumpId] : entry->second.sourceDumpIds)
+    {
+        auto& ids = sourceDumpIdIndex[interface];
+        if (auto it = ids.find(sourceDumpId);
+            it != ids.end() && it->second == path)
+        {
+            ids.erase(it);
+        }
+    }
+    entries.erase(entry);
+}
+
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "common/types.hpp"
+
+#include <sdbusplus/bus/match.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace pldm
+{
+namespace responder
+{
+
+/** @class DumpEntryIndex
+ *
+ *  @brief Index of the dump entries hosted by the dump manager, answering the
+ *  source dump ID to object path and the offload URI lookups of the dump
+ *  offload without a round trip to the dump manager.
+ *
+ *  The index is seeded with the GetManagedObjects reply the caller falls back
+ *  to on a miss and kept current from the InterfacesAdded, InterfacesRemoved
+ *  and PropertiesChanged signals of the dump entries. A miss is not
+ *  authoritative as the signal may still be queued.
+ */
+class DumpEntryIndex
+{
+  public:
+    DumpEntryIndex(const DumpEntryIndex&) = delete;
+    DumpEntryIndex& operator=(const DumpEntryIndex&) = delete;
+    DumpEntryIndex(DumpEntryIndex&&) = delete;
+    DumpEntryIndex& operator=(DumpEntryIndex&&) = delete;
+
+    /** @brief Constructor, subscribes to the dump entry signals */
+    DumpEntryIndex();
+
+    /** @brief Get the index of the dump entries
+     *
+     *  @return reference to the dump entry index
+     */
+    static DumpEntryIndex& get();
+
+    /** @brief Find a dump entry by its source dump ID
+     *
+     *  @param[in] interface - dump entry interface holding the source dump ID
+     *  @param[in] sourceDumpId - source dump ID
+     *
+     *  @return object path of the dump entry, std::nullopt if not indexed
+     */
+    std::optional<std::string> findBySourceDumpId(const std::string& interface,
+                                                  uint32_t sourceDumpId);
+
+    /** @brief Get the offload URI of a dump entry
+     *
+     *  @param[in] path - object path of the dump entry
+     *
+     *  @return offload URI, std::nullopt if the entry is not indexed or has no
+     *          offload URI
+     */
+    std::optional<std::string> getOffloadUri(const std::string& path);
+
+    /** @brief Replace the content of the index with the objects of the dump
+     *         manager
+     *
+     *  @param[in] objects - reply of GetManagedObjects on the dump manager
+     */
+    void seed(const pldm::dbus::ObjectValueTree& objects);
+
+    /** @brief Update the properties of a dump entry, to be called on the
+     *         properties set by PLDM as the signal is only processed on the
+     *         next dispatch of the event loop
+     *
+     *  @param[in] path - object path of the dump entry
+     *  @param[in] interface - interface of the properties
+     *  @param[in] properties - properties and their values
+     */
+    void update(const std::string& path, const std::string& interface,
+                const pldm::dbus::PropertyMap& properties);
+
+  protected:
+    /** @brief Remove a dump entry from the index, on the InterfacesRemoved
+     *         signal of the entry
+     *
+     *  @param[in] path - object path of the dump entry
+     */
+    void remove(const std::string& path);
+
+  private:
+    struct DumpEntry
+    {
+        std::string offloadUri; //!< offload URI, empty when not offloading
+        /** @brief source dump IDs keyed by interface */
+        std::unordered_map<std::string, uint32_t> sourceDumpIds;
+    };
+
+    /** @brief dump entries keyed by object path */
+    std::unordered_map<std::string, DumpEntry> entries;
+
+    /** @brief object paths keyed by interface and source dump ID */
+    std::unordered_map<std::string, std::unordered_map<uint32_t, std::string>>
+        sourceDumpIdIndex;
+
+    /** @brief dump entry signal matches */
+    std::unique_ptr<sdbusplus::bus::match_t> interfacesAddedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> interfacesRemovedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> propertiesChangedMatch;
+};
+
+} // namespace responder
+} // namespace pldm
@@ -639,8 +639,8 @@ Response Handler::getFileTable(const pldm_msg* request, size_t payloadLength)
     }
 
     using namespace pldm::filetable;
-    auto table = buildFileTable(FILE_TABLE_JSON);
-    auto attrTable = table();
+    auto& table = buildFileTable(FILE_TABLE_JSON);
+    const auto& attrTable = table();
     response.resize(response.size() + attrTable.size());
     responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
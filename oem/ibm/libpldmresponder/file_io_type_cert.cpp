@@ -1,13 +1,17 @@
 #include "file_io_type_cert.hpp"
 
+#include "cert_exchange.hpp"
 #include "common/utils.hpp"
 
 #include <libpldm/base.h>
 #include <libpldm/oem/ibm/file_io.h>
 #include <stdint.h>
+#include <unistd.h>
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+
 PHOSPHOR_LOG2_USING;
 
 namespace pldm
@@ -16,8 +20,6 @@ using namespace utils;
 
 namespace responder
 {
-constexpr auto certObjPath = "/xyz/openbmc_project/certs/ca/entry/";
-constexpr auto certEntryIntf = "xyz.openbmc_project.Certs.Entry";
 static constexpr auto certFilePath = "/var/lib/ibm/bmcweb/";
 
 CertMap CertHandler::certMap;
@@ -28,50 +30,75 @@ void CertHandler::writeFromMemory(uint32_t offset, uint32_t length,
                                   SharedAIORespData& sharedAIORespDataobj,
                                   sdeventplus::Event& event)
 {
-    auto it = certMap.find(certType);
-    if (it == certMap.end())
+    int fd = -1;
+    if (certType == PLDM_FILE_TYPE_SIGNED_CERT)
+    {
+        fd = CertExchange::get().getCertFd(fileHandle);
+    }
+    else if (auto it = certMap.find(certType); it != certMap.end())
+    {
+        fd = std::get<0>(it->second);
+    }
+    if (fd == -1)
     {
         error(
-            "Failed to find file type '{TYPE}' in certificate map. Write from memory during certificate exchange failed",
-            "TYPE", certType);
+            "Failed to find file type '{TYPE}' with file handle '{FILE_HANDLE}'. Write from memory during certificate exchange failed",
+            "TYPE", certType, "FILE_HANDLE", fileHandle);
         FileHandler::dmaResponseToRemoteTerminus(sharedAIORespDataobj,
                                                  PLDM_ERROR, 0);
         FileHandler::deleteAIOobjects(nullptr, sharedAIORespDataobj);
         return;
     }
-    auto fd = std::get<0>(it->second);
-    transferFileData(fd, false, offset, length, address, sharedAIORespDataobj,
-                     event);
+
+    // The DMA transfer closes the descriptor it is given, the certificate
+    // keeps its own till all of it is written
+    int transferFd = dup(fd);
+    if (transferFd == -1)
+    {
+        error(
+            "Failed to duplicate the descriptor of file type '{TYPE}', error number - {ERROR_NUM}",
+            "TYPE", certType, "ERROR_NUM", errno);
+        FileHandler::dmaResponseToRemoteTerminus(sharedAIORespDataobj,
+                                                 PLDM_ERROR, 0);
+        FileHandler::deleteAIOobjects(nullptr, sharedAIORespDataobj);
+        return;
+    }
+    transferLength = length;
+    transferFileData(transferFd, false, offset, length, address,
+                     sharedAIORespDataobj, event);
 
     return;
 }
 
-void CertHandler::postDataTransferCallBack(bool IsWriteToMemOp, uint32_t length)
+void CertHandler::postDataTransferCallBack(bool IsWriteToMemOp,
+                                           uint32_t /*length*/)
 {
-    if (IsWriteToMemOp)
+    if (!IsWriteToMemOp)
     {
-        auto it = certMap.find(certType);
-        if (it == certMap.end())
-        {
-            error(
-                "CertHandler::writeFromMemory:file for type {TYPE} doesn't exist",
-                "TYPE", certType);
-            return;
-        }
-        // auto fd = std::get<0>(it->second);
-        auto& remSize = std::get<1>(it->second);
-        remSize -= length;
-        if (!remSize)
-        {
-            // close(fd);
-            certMap.erase(it);
-        }
+        CertExchange::get().csrRead(fileHandle, csrReadEnd);
+        return;
     }
-    else
+
+    if (certType == PLDM_FILE_TYPE_SIGNED_CERT)
     {
-        fs::remove(certfilePath);
+        CertExchange::get().certWritten(fileHandle, transferLength);
+        return;
+    }
+
+    auto it = certMap.find(certType);
+    if (it == certMap.end())
+    {
+        error("CertHandler::writeFromMemory:file for type {TYPE} doesn't exist",
+              "TYPE", certType);
+        return;
+    }
+    auto& remSize = std::get<1>(it->second);
+    remSize -= std::min<uint64_t>(transferLength, remSize);
+    if (!remSize)
+    {
+        close(std::get<0>(it->second));
+        certMap.erase(it);
     }
-    return;
 }
 
 void CertHandler::readIntoMemory(uint32_t offset, uint32_t length,
@@ -80,8 +107,6 @@ void CertHandler::readIntoMemory(uint32_t offset, uint32_t length,
                                  SharedAIORespData& sharedAIORespDataobj,
                                  sdeventplus::Event& event)
 {
-    std::string filePath = certFilePath;
-    filePath += "CSR_" + std::to_string(fileHandle);
     if (certType != PLDM_FILE_TYPE_CERT_SIGNING_REQUEST)
     {
         FileHandler::dmaResponseToRemoteTerminus(
@@ -89,32 +114,85 @@ void CertHandler::readIntoMemory(uint32_t offset, uint32_t length,
         FileHandler::deleteAIOobjects(nullptr, sharedAIORespDataobj);
         return;
     }
-    certfilePath = filePath;
-    transferFileData(filePath.c_str(), true, offset, length, address,
+
+    auto& certExchange = CertExchange::get();
+    int fd = certExchange.getCsrFd(fileHandle);
+    if (fd == -1)
+    {
+        error("CSR with file handle '{FILE_HANDLE}' does not exist",
+              "FILE_HANDLE", fileHandle);
+        FileHandler::dmaResponseToRemoteTerminus(
+            sharedAIORespDataobj, PLDM_INVALID_FILE_HANDLE, length);
+        FileHandler::deleteAIOobjects(nullptr, sharedAIORespDataobj);
+        return;
+    }
+
+    auto csrSize = certExchange.getCsrSize(fileHandle);
+    if (offset >= csrSize)
+    {
+        error(
+            "Offset '{OFFSET}' exceeds CSR size '{SIZE}' for file handle {FILE_HANDLE}",
+            "OFFSET", offset, "SIZE", csrSize, "FILE_HANDLE", fileHandle);
+        FileHandler::dmaResponseToRemoteTerminus(
+            sharedAIORespDataobj, PLDM_DATA_OUT_OF_RANGE, length);
+        FileHandler::deleteAIOobjects(nullptr, sharedAIORespDataobj);
+        return;
+    }
+    if (offset + length > csrSize)
+    {
+        length = csrSize - offset;
+    }
+
+    int transferFd = dup(fd);
+    if (transferFd == -1)
+    {
+        error(
+            "Failed to duplicate the CSR descriptor for file handle '{FILE_HANDLE}', error number - {ERROR_NUM}",
+            "FILE_HANDLE", fileHandle, "ERROR_NUM", errno);
+        FileHandler::dmaResponseToRemoteTerminus(sharedAIORespDataobj,
+                                                 PLDM_ERROR, 0);
+        FileHandler::deleteAIOobjects(nullptr, sharedAIORespDataobj);
+        return;
+    }
+    csrReadEnd = static_cast<uint64_t>(offset) + length;
+    transferFileData(transferFd, true, offset, length, address,
                      sharedAIORespDataobj, event);
 }
 
 int CertHandler::read(uint32_t offset, uint32_t& length, Response& response,
                       oem_platform::Handler* /*oemPlatformHandler*/)
 {
-    std::string filePath = certFilePath;
-    filePath += "CSR_" + std::to_string(fileHandle);
     if (certType != PLDM_FILE_TYPE_CERT_SIGNING_REQUEST)
     {
         return PLDM_ERROR_INVALID_DATA;
     }
-    auto rc = readFile(filePath.c_str(), offset, length, response);
-    fs::remove(filePath);
+
+    auto& certExchange = CertExchange::get();
+    int fd = certExchange.getCsrFd(fileHandle);
+    if (fd == -1)
+    {
+        error("CSR with file handle '{FILE_HANDLE}' does not exist",
+              "FILE_HANDLE", fileHandle);
+        return PLDM_ERROR;
+    }
+    auto rc = readFileByFd(fd, offset, length, response);
     if (rc)
     {
         return PLDM_ERROR;
     }
+    certExchange.csrRead(fileHandle, static_cast<uint64_t>(offset) + length);
     return PLDM_SUCCESS;
 }
 
 int CertHandler::write(const char* buffer, uint32_t offset, uint32_t& length,
                        oem_platform::Handler* /*oemPlatformHandler*/)
 {
+    if (certType == PLDM_FILE_TYPE_SIGNED_CERT)
+    {
+        return CertExchange::get().writeCert(fileHandle, buffer, offset,
+                                             length);
+    }
+
     auto it = certMap.find(certType);
     if (it == certMap.end())
     {
@@ -125,15 +203,7 @@ int CertHandler::write(const char* buffer, uint32_t offset, uint32_t& length,
     }
 
     auto fd = std::get<0>(it->second);
-    int rc = lseek(fd, offset, SEEK_SET);
-    if (rc == -1)
-    {
-        error(
-            "Failed to write certificate lseek at offset '{OFFSET}' of length '{LENGTH}', error number - {ERROR_NUM}",
-            "OFFSET", offset, "LENGTH", length, "ERROR_NUM", errno);
-        return PLDM_ERROR;
-    }
-    rc = ::write(fd, buffer, length);
+    auto rc = pwrite(fd, buffer, length, offset);
     if (rc == -1)
     {
         error(
@@ -143,128 +213,53 @@ int CertHandler::write(const char* buffer, uint32_t offset, uint32_t& length,
     }
     length = rc;
     auto& remSize = std::get<1>(it->second);
-    remSize -= length;
+    remSize -= std::min<uint64_t>(length, remSize);
     if (!remSize)
     {
         close(fd);
         certMap.erase(it);
     }
-
-    if (certType == PLDM_FILE_TYPE_SIGNED_CERT)
-    {
-        constexpr auto certObjPath = "/xyz/openbmc_project/certs/ca/entry/";
-        constexpr auto certEntryIntf = "xyz.openbmc_project.Certs.Entry";
-
-        std::string filePath = certFilePath;
-        filePath += "ClientCert_" + std::to_string(fileHandle);
-
-        std::ifstream inFile;
-        inFile.open(filePath);
-        std::stringstream strStream;
-        strStream << inFile.rdbuf();
-        std::string str = strStream.str();
-        inFile.close();
-
-        if (!str.empty())
-        {
-            PropertyValue value{str};
-
-            DBusMapping dbusMapping{certObjPath + std::to_string(fileHandle),
-                                    certEntryIntf, "ClientCertificate",
-                                    "string"};
-            try
-            {
-                pldm::utils::DBusHandler().setDbusProperty(dbusMapping, value);
-            }
-            catch (const std::exception& e)
-            {
-                error(
-                    "Failed to write for set client certificate, error - {ERROR}",
-                    "ERROR", e);
-                return PLDM_ERROR;
-            }
-            PropertyValue valueStatus{
-                "xyz.openbmc_project.Certs.Entry.State.Complete"};
-            DBusMapping dbusMappingStatus{certObjPath +
-                                              std::to_string(fileHandle),
-                                          certEntryIntf, "Status", "string"};
-            try
-            {
-                info(
-                    "Client certificate write status 'complete' for file handle '{FILE_HANDLE}'",
-                    "FILE_HANDLE", fileHandle);
-                pldm::utils::DBusHandler().setDbusProperty(dbusMappingStatus,
-                                                           valueStatus);
-            }
-            catch (const std::exception& e)
-            {
-                error(
-                    "Failed to write the set status property for certificate entry, error - {ERROR}",
-                    "ERROR", e);
-                return PLDM_ERROR;
-            }
-            fs::remove(filePath);
-        }
-        else
-        {
-            PropertyValue value{"xyz.openbmc_project.Certs.Entry.State.BadCSR"};
-            DBusMapping dbusMapping{certObjPath + std::to_string(fileHandle),
-                                    certEntryIntf, "Status", "string"};
-            try
-            {
-                info(
-                    "Client certificate write status 'Bad CSR' for file handle '{FILE_HANDLE}'",
-                    "FILE_HANDLE", fileHandle);
-                pldm::utils::DBusHandler().setDbusProperty(dbusMapping, value);
-            }
-            catch (const std::exception& e)
-            {
-                error(
-                    "Failed to write the set status property for certficate entry, error - {ERROR}",
-                    "ERROR", e);
-                return PLDM_ERROR;
-            }
-        }
-    }
     return PLDM_SUCCESS;
 }
 
-int CertHandler::newFileAvailable(uint64_t length)
+int CertHandler::openRootCert(uint64_t length)
 {
     fs::create_directories(certFilePath);
     fs::permissions(certFilePath,
                     fs::perms::others_read | fs::perms::owner_write);
-    int fileFd = -1;
-    int flags = O_WRONLY | O_CREAT | O_TRUNC;
     std::string filePath = certFilePath;
+    int fileFd = open((filePath + "RootCert").c_str(),
+                      O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fileFd == -1)
+    {
+        error(
+            "Failed to open root certificate file, error number - {ERROR_NUM}",
+            "ERROR_NUM", errno);
+        return PLDM_ERROR;
+    }
 
-    if (certType == PLDM_FILE_TYPE_CERT_SIGNING_REQUEST)
+    if (auto it = certMap.find(certType); it != certMap.end())
     {
-        return PLDM_ERROR_INVALID_DATA;
+        close(std::get<0>(it->second));
     }
+    certMap.insert_or_assign(certType, std::tuple(fileFd, length));
+    return PLDM_SUCCESS;
+}
+
+int CertHandler::newFileAvailable(uint64_t length)
+{
     if (certType == PLDM_FILE_TYPE_SIGNED_CERT)
     {
         info(
             "New file available for client certificate file with file handle {FILE_HANDLE}",
             "FILE_HANDLE", fileHandle);
-        fileFd = open(
-            (filePath + "ClientCert_" + std::to_string(fileHandle)).c_str(),
-            flags, S_IRUSR | S_IWUSR);
+        return CertExchange::get().beginCert(fileHandle, length);
     }
-    else if (certType == PLDM_FILE_TYPE_ROOT_CERT)
+    if (certType == PLDM_FILE_TYPE_ROOT_CERT)
     {
-        fileFd = open((filePath + "RootCert").c_str(), flags,
-                      S_IRUSR | S_IWUSR);
+        return openRootCert(length);
     }
-    if (fileFd == -1)
-    {
-        error(
-            "Failed to open new file available with file type '{TYPE}', error number - {ERROR_NUM}",
-            "TYPE", certType, "ERROR_NUM", errno);
-        return PLDM_ERROR;
-    }
-    certMap.emplace(certType, std::tuple(fileFd, length));
-    return PLDM_SUCCESS;
+    return PLDM_ERROR_INVALID_DATA;
 }
 
 int CertHandler::newFileAvailableWithMetaData(uint64_t length,
@@ -273,64 +268,31 @@ int CertHandler::newFileAvailableWithMetaData(uint64_t length,
                                               uint32_t /*metaDataValue3*/,
                                               uint32_t /*metaDataValue4*/)
 {
-    fs::create_directories(certFilePath);
-    fs::permissions(certFilePath,
-                    fs::perms::others_read | fs::perms::owner_write);
-    int fileFd = -1;
-    int flags = O_WRONLY | O_CREAT | O_TRUNC;
-    std::string filePath = certFilePath;
-
-    if (certType == PLDM_FILE_TYPE_CERT_SIGNING_REQUEST)
+    if (certType == PLDM_FILE_TYPE_ROOT_CERT)
     {
-        return PLDM_ERROR_INVALID_DATA;
+        return openRootCert(length);
     }
-    if (certType == PLDM_FILE_TYPE_SIGNED_CERT)
+    if (certType != PLDM_FILE_TYPE_SIGNED_CERT)
     {
-        if (metaDataValue1 == PLDM_SUCCESS)
-        {
-            info(
-                "Client certificate new file available with meta data for file handle '{FILE_HANDLE}'",
-                "FILE_HANDLE", fileHandle);
-            fileFd = open(
-                (filePath + "ClientCert_" + std::to_string(fileHandle)).c_str(),
-                flags, S_IRUSR | S_IWUSR);
-        }
-        else if (metaDataValue1 == PLDM_INVALID_CERT_DATA)
-        {
-            error(
-                "New file available with meta data for client certificate file has invalid data '{META_DATA}' with file handle '{FILE_HANDLE}'",
-                "META_DATA", metaDataValue1, "FILE_HANDLE", fileHandle);
-            DBusMapping dbusMapping{certObjPath + std::to_string(fileHandle),
-                                    certEntryIntf, "Status", "string"};
-            std::string status = "xyz.openbmc_project.Certs.Entry.State.BadCSR";
-            PropertyValue value{status};
-            try
-            {
-                pldm::utils::DBusHandler().setDbusProperty(dbusMapping, value);
-            }
-            catch (const std::exception& e)
-            {
-                error(
-                    "Failed to set set status property of certificate entry in new file available with meta data, error - {ERROR}",
-                    "ERROR", e);
-                return PLDM_ERROR;
-            }
-        }
+        return PLDM_ERROR_INVALID_DATA;
     }
-    else if (certType == PLDM_FILE_TYPE_ROOT_CERT)
+
+    if (metaDataValue1 == PLDM_SUCCESS)
     {
-        fileFd = open((filePath + "RootCert").c_str(), flags,
-                      S_IRUSR | S_IWUSR);
+        info(
+            "Client certificate new file available with meta data for file handle '{FILE_HANDLE}'",
+            "FILE_HANDLE", fileHandle);
+        return CertExchange::get().beginCert(fileHandle, length);
     }
-    if (fileFd == -1)
+
+    error(
+        "New file available with meta data for client certificate file has invalid data '{META_DATA}' with file handle '{FILE_HANDLE}'",
+        "META_DATA", metaDataValue1, "FILE_HANDLE", fileHandle);
+    if (metaDataValue1 == PLDM_INVALID_CERT_DATA)
     {
-        error(
-            "Failed to open file type '{TYPE}' but New file available with meta data, error number - {ERROR_NUM}",
-            "TYPE", certType, "ERROR_NUM", errno);
-        return PLDM_ERROR;
+        CertExchange::get().publishStatus(fileHandle, certStatusBadCsr);
     }
-    certMap.emplace(certType, std::tuple(fileFd, length));
-    return PLDM_SUCCESS;
+    return PLDM_ERROR;
 }
 
 int CertHandler::fileAckWithMetaData(uint8_t fileStatus,
@@ -341,28 +303,10 @@ int CertHandler::fileAckWithMetaData(uint8_t fileStatus,
 {
     if (certType == PLDM_FILE_TYPE_CERT_SIGNING_REQUEST)
     {
-        DBusMapping dbusMapping{certObjPath + std::to_string(fileHandle),
-                                certEntryIntf, "Status", "string"};
-        PropertyValue value = "xyz.openbmc_project.Certs.Entry.State.Pending";
-        if (fileStatus == PLDM_ERROR_INVALID_DATA)
-        {
-            value = "xyz.openbmc_project.Certs.Entry.State.BadCSR";
-        }
-        else if (fileStatus == PLDM_ERROR_NOT_READY)
-        {
-            value = "xyz.openbmc_project.Certs.Entry.State.Pending";
-        }
-        try
-        {
-            pldm::utils::DBusHandler().setDbusProperty(dbusMapping, value);
-        }
-        catch (const std::exception& e)
-        {
-            error(
-                "Failed to set status property of certificate entry for file ack with meta data, error - {ERROR}",
-                "ERROR", e);
-            return PLDM_ERROR;
-        }
+        CertExchange::get().publishStatus(
+            fileHandle, fileStatus == PLDM_ERROR_INVALID_DATA
+                            ? certStatusBadCsr
+                            : certStatusPending);
     }
     return PLDM_SUCCESS;
 }
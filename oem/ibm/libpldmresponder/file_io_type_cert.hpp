@@ -17,7 +17,9 @@ using CertMap = std::map<CertType, CertDetails>;
 /** @class CertHandler
  *
  *  @brief Inherits and implements FileHandler. This class is used
- *  to read/write certificates and certificate signing requests
+ *  to read/write certificates and certificate signing requests. The CSRs and
+ *  the client certificates go through the CertExchange pipeline, the root
+ *  certificate is written to the filesystem
  */
 class CertHandler : public FileHandler
 {
@@ -70,10 +72,24 @@ class CertHandler : public FileHandler
     ~CertHandler() {}
 
   private:
+    /** @brief Open the root certificate file for the host to write
+     *
+     *  @param[in] length - length of the root certificate
+     *
+     *  @return PLDM completion code
+     */
+    int openRootCert(uint64_t length);
+
     uint16_t certType;      //!< type of the certificate
-    static CertMap certMap; //!< holds the fd and remaining read/write size for
-                            //!< each certificate
-    std::string certfilePath;
+    static CertMap certMap; //!< holds the fd and remaining write size of the
+                            //!< root certificate
+
+    /** @brief offset a CSR read into memory ends at */
+    uint64_t csrReadEnd = 0;
+
+    /** @brief length of the client certificate part written from memory */
+    uint32_t transferLength = 0;
+
     enum SignedCertStatus
     {
         PLDM_INVALID_CERT_DATA = 0X03
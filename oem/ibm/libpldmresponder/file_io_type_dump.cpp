@@ -2,6 +2,7 @@
 
 #include "com/ibm/Dump/Notify/server.hpp"
 #include "common/utils.hpp"
+#include "dump_entry_index.hpp"
 #include "utils.hpp"
 #include "xyz/openbmc_project/Common/error.hpp"
 
@@ -138,6 +139,13 @@ std::string DumpHandler::findDumpObjPath(uint32_t fileHandle)
         return curDumpEntryPath;
     }
 
+    auto& dumpEntryIndex = DumpEntryIndex::get();
+    if (auto path = dumpEntryIndex.findBySourceDumpId(dumpEntryIntf,
+                                                      fileHandle))
+    {
+        return *path;
+    }
+
     dbus::ObjectValueTree objects;
 
     try
@@ -155,6 +163,7 @@ std::string DumpHandler::findDumpObjPath(uint32_t fileHandle)
             "PATH", DUMP_MANAGER_PATH, "INTERFACE", dumpEntryIntf, "ERROR", e);
         return curDumpEntryPath;
     }
+    dumpEntryIndex.seed(objects);
 
     for (const auto& object : objects)
     {
@@ -246,6 +255,8 @@ void DumpHandler::resetOffloadUri()
     {
         pldm::utils::DBusHandler().setDbusProperty(dbusMapping,
                                                    offloadUriValue);
+        DumpEntryIndex::get().update(path, dumpEntry,
+                                     {{"OffloadUri", std::string{}}});
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -267,6 +278,12 @@ std::string DumpHandler::getOffloadUri(uint32_t fileHandle)
         return {};
     }
 
+    auto& dumpEntryIndex = DumpEntryIndex::get();
+    if (auto offloadUri = dumpEntryIndex.getOffloadUri(path))
+    {
+        return *offloadUri;
+    }
+
     std::string socketInterface{};
 
     try
@@ -276,6 +293,8 @@ std::string DumpHandler::getOffloadUri(uint32_t fileHandle)
                 path.c_str(), "OffloadUri", dumpEntry);
         info("Offload URI socketInterface={SOCKET_INTF}", "SOCKET_INTF",
              socketInterface);
+        dumpEntryIndex.update(path, dumpEntry,
+                              {{"OffloadUri", socketInterface}});
     }
     catch (const std::exception& e)
     {
@@ -413,6 +432,8 @@ int DumpHandler::fileAck(uint8_t fileStatus)
                 {
                     pldm::utils::DBusHandler().setDbusProperty(dbusMapping,
                                                                value);
+                    DumpEntryIndex::get().update(path, dumpIntf,
+                                                 {{"SourceDumpId", val}});
                 }
                 catch (const std::exception& e)
                 {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "file_io_by_type.hpp"
+#include "lid_index.hpp"
 
 #include <phosphor-logging/lg2.hpp>
 
@@ -33,23 +34,19 @@ class LidHandler : public FileHandler
         FileHandler(fileHandle), lidType(lidType)
     {
         sideToRead = permSide ? Pside : Tside;
-        isPatchDir = false;
-        std::string dir = permSide ? LID_ALTERNATE_DIR : LID_RUNNING_DIR;
-        std::stringstream stream;
-        stream << std::hex << fileHandle;
-        auto lidName = stream.str() + ".lid";
-        std::string patchDir = permSide ? LID_ALTERNATE_PATCH_DIR
-                                        : LID_RUNNING_PATCH_DIR;
-        auto patch = fs::path(patchDir) / lidName;
-        if (fs::is_regular_file(patch))
+        auto& lidIndex = LidIndex::get();
+        auto patchDir = permSide ? LidDir::AlternatePatch
+                                 : LidDir::RunningPatch;
+        isPatchDir = lidIndex.fileSize(patchDir, fileHandle).has_value();
+        if (isPatchDir)
         {
-            lidPath = patch;
-            isPatchDir = true;
+            lidDir = patchDir;
         }
         else
         {
-            lidPath = std::move(dir) + '/' + lidName;
+            lidDir = permSide ? LidDir::Alternate : LidDir::Running;
         }
+        lidPath = lidIndex.path(lidDir, fileHandle);
     }
 
     /** @brief Method to construct the LID path based on current boot side
@@ -63,22 +60,11 @@ class LidHandler : public FileHandler
             pldm::responder::oem_ibm_platform::Handler* oemIbmPlatformHandler =
                 dynamic_cast<pldm::responder::oem_ibm_platform::Handler*>(
                     oemPlatformHandler);
-            std::string dir = LID_ALTERNATE_DIR;
-            if (isPatchDir)
-            {
-                dir = LID_ALTERNATE_PATCH_DIR;
-            }
+            lidDir = isPatchDir ? LidDir::AlternatePatch : LidDir::Alternate;
             if (oemIbmPlatformHandler->codeUpdate->fetchCurrentBootSide() ==
                 sideToRead)
             {
-                if (isPatchDir)
-                {
-                    dir = LID_RUNNING_PATCH_DIR;
-                }
-                else
-                {
-                    dir = LID_RUNNING_DIR;
-                }
+                lidDir = isPatchDir ? LidDir::RunningPatch : LidDir::Running;
             }
             else if (oemIbmPlatformHandler->codeUpdate
                          ->isCodeUpdateInProgress())
@@ -86,14 +72,49 @@ class LidHandler : public FileHandler
                 return false;
             }
 
-            std::stringstream stream;
-            stream << std::hex << fileHandle;
-            auto lidName = stream.str() + ".lid";
-            lidPath = std::move(dir) + '/' + lidName;
+            lidPath = LidIndex::get().path(lidDir, fileHandle);
         }
         return true;
     }
 
+    /** @brief Method to open the LID for reading, the offset and the length
+     *         are validated against the LID size held by the LID index
+     *  @param[in] offset - offset to read
+     *  @param[in/out] length - length to be read, trimmed to the LID size
+     *  @param[out] fd - file descriptor of the LID
+     *  @return PLDM status code
+     */
+    int openLid(uint32_t offset, uint32_t& length, int& fd)
+    {
+        auto fileSize = LidIndex::get().fileSize(lidDir, fileHandle);
+        if (!fileSize)
+        {
+            error("File '{PATH}' and handle {FILE_HANDLE} does not exist",
+                  "PATH", lidPath, "FILE_HANDLE", fileHandle);
+            return PLDM_INVALID_FILE_HANDLE;
+        }
+        if (offset >= *fileSize)
+        {
+            error(
+                "Offset '{OFFSET}' exceeds file size '{SIZE}' and file handle '{FILE_HANDLE}'",
+                "OFFSET", offset, "SIZE", *fileSize, "FILE_HANDLE",
+                fileHandle);
+            return PLDM_DATA_OUT_OF_RANGE;
+        }
+        if (static_cast<uint64_t>(offset) + length > *fileSize)
+        {
+            length = *fileSize - offset;
+        }
+
+        fd = open(lidPath.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            error("Failed to open file '{LID_PATH}'", "LID_PATH", lidPath);
+            return PLDM_ERROR;
+        }
+        return PLDM_SUCCESS;
+    }
+
     virtual void writeFromMemory(uint32_t offset, uint32_t length,
                                  uint64_t address,
                                  oem_platform::Handler* oemPlatformHandler,
@@ -191,17 +212,26 @@ class LidHandler : public FileHandler
                                 SharedAIORespData& sharedAIORespDataobj,
                                 sdeventplus::Event& event)
     {
-        if (constructLIDPath(oemPlatformHandler))
-        {
-            transferFileData(lidPath, true, offset, length, address,
-                             sharedAIORespDataobj, event);
-        }
-        else
+        if (!constructLIDPath(oemPlatformHandler))
         {
             FileHandler::dmaResponseToRemoteTerminus(sharedAIORespDataobj,
                                                      PLDM_ERROR, 0);
             FileHandler::deleteAIOobjects(nullptr, sharedAIORespDataobj);
+            return;
         }
+
+        int fd = -1;
+        auto rc = openLid(offset, length, fd);
+        if (rc != PLDM_SUCCESS)
+        {
+            FileHandler::dmaResponseToRemoteTerminus(
+                sharedAIORespDataobj,
+                static_cast<pldm_fileio_completion_codes>(rc), length);
+            FileHandler::deleteAIOobjects(nullptr, sharedAIORespDataobj);
+            return;
+        }
+        transferFileData(fd, true, offset, length, address,
+                         sharedAIORespDataobj, event);
     }
 
     virtual int write(const char* buffer, uint32_t offset, uint32_t& length,
@@ -311,11 +341,20 @@ class LidHandler : public FileHandler
     virtual int read(uint32_t offset, uint32_t& length, Response& response,
                      oem_platform::Handler* oemPlatformHandler)
     {
-        if (constructLIDPath(oemPlatformHandler))
+        if (!constructLIDPath(oemPlatformHandler))
         {
-            return readFile(lidPath, offset, length, response);
+            return PLDM_ERROR;
         }
-        return PLDM_ERROR;
+
+        int fd = -1;
+        auto rc = openLid(offset, length, fd);
+        if (rc != PLDM_SUCCESS)
+        {
+            return rc;
+        }
+        rc = readFileByFd(fd, offset, length, response);
+        close(fd);
+        return rc;
     }
 
     virtual int fileAck(uint8_t /*fileStatus*/)
@@ -360,6 +399,7 @@ class LidHandler : public FileHandler
     std::string lidPath;
     std::string sideToRead;
     bool isPatchDir;
+    LidDir lidDir;
     static inline MarkerLIDremainingSize markerLIDremainingSize;
     uint8_t lidType;
     bool mcodeUpdateInProgress = false;
@@ -1,10 +1,16 @@
 #include "file_table.hpp"
 
 #include <libpldm/utils.h>
+#include <sys/inotify.h>
+#include <unistd.h>
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <array>
 #include <fstream>
+#include <sstream>
+#include <utility>
 
 PHOSPHOR_LOG2_USING;
 
@@ -12,6 +18,14 @@ namespace pldm
 {
 namespace filetable
 {
+
+/** @brief Events on a file changing its size */
+constexpr uint32_t sizeEvents = IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB;
+
+/** @brief Events on a directory adding or removing a file */
+constexpr uint32_t dirEvents = IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                               IN_MOVED_TO;
+
 FileTable::FileTable(const std::string& fileTableConfigPath)
 {
     std::ifstream jsonFile(fileTableConfigPath);
@@ -30,12 +44,13 @@ FileTable::FileTable(const std::string& fileTableConfigPath)
         return;
     }
 
-    uint16_t fileNameLength = 0;
-    uint32_t fileSize = 0;
-    uint32_t traits = 0;
-    size_t tableSize = 0;
-    Handle handle = 0;
-    auto iter = fileTable.begin();
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd == -1)
+    {
+        error(
+            "Failed to initialize inotify for the file table, error number - {ERROR_NUM}",
+            "ERROR_NUM", errno);
+    }
 
     // Iterate through each JSON object in the config file
     for (const auto& record : data)
@@ -43,18 +58,114 @@ FileTable::FileTable(const std::string& fileTableConfigPath)
         constexpr auto path = "path";
         constexpr auto fileTraits = "file_traits";
 
+        FileRecord fileRecord{};
         std::string filepath = record.value(path, "");
-        traits = static_cast<uint32_t>(record.value(fileTraits, 0));
+        fileRecord.traits = static_cast<uint32_t>(record.value(fileTraits, 0));
 
         // Split the filepath string using ',' as a delimiter
         // as the json can define multiple paths to try and use
         // in order of priority
         std::istringstream stringstream(filepath);
         std::string path_substr;
-        fs::path fsPath;
         while (std::getline(stringstream, path_substr, ','))
         {
-            fsPath.assign(path_substr);
+            fs::path fsPath(path_substr);
+            paths.emplace(fsPath.string());
+            if (fsPath.has_parent_path())
+            {
+                dirs.emplace(fsPath.parent_path().string());
+            }
+            fileRecord.paths.emplace_back(std::move(fsPath));
+        }
+        records.emplace_back(std::move(fileRecord));
+    }
+
+    watchDirectories();
+    encode();
+}
+
+FileTable::~FileTable()
+{
+    if (fd != -1)
+    {
+        close(fd);
+    }
+}
+
+FileTable::FileTable(FileTable&& other) noexcept :
+    records(std::move(other.records)),
+    tableEntries(std::move(other.tableEntries)),
+    handles(std::move(other.handles)),
+    sizeOffsets(std::move(other.sizeOffsets)), paths(std::move(other.paths)),
+    dirs(std::move(other.dirs)), watches(std::move(other.watches)),
+    fd(std::exchange(other.fd, -1)),
+    fileTable(std::move(other.fileTable)), padCount(other.padCount),
+    checkSum(other.checkSum)
+{}
+
+FileTable& FileTable::operator=(FileTable&& other) noexcept
+{
+    if (this != &other)
+    {
+        clear();
+        records = std::move(other.records);
+        tableEntries = std::move(other.tableEntries);
+        handles = std::move(other.handles);
+        sizeOffsets = std::move(other.sizeOffsets);
+        paths = std::move(other.paths);
+        dirs = std::move(other.dirs);
+        watches = std::move(other.watches);
+        fd = std::exchange(other.fd, -1);
+        fileTable = std::move(other.fileTable);
+        padCount = other.padCount;
+        checkSum = other.checkSum;
+    }
+    return *this;
+}
+
+void FileTable::clear()
+{
+    if (fd != -1)
+    {
+        close(fd);
+        fd = -1;
+    }
+    records.clear();
+    tableEntries.clear();
+    handles.clear();
+    sizeOffsets.clear();
+    paths.clear();
+    dirs.clear();
+    watches.clear();
+    fileTable.clear();
+    padCount = 0;
+    checkSum = 0;
+}
+
+void FileTable::encode()
+{
+    uint16_t fileNameLength = 0;
+    uint32_t fileSize = 0;
+    uint32_t traits = 0;
+    size_t tableSize = 0;
+
+    tableEntries.clear();
+    handles.clear();
+    sizeOffsets.clear();
+    fileTable.clear();
+    padCount = 0;
+    auto iter = fileTable.begin();
+
+    for (size_t index = 0; index < records.size(); ++index)
+    {
+        // The handle is the position of the file in the config, the host
+        // caches it and it must not change when other files come and go
+        auto handle = static_cast<Handle>(index);
+        const auto& record = records[index];
+        fs::path fsPath;
+        for (const auto& path : record.paths)
+        {
+            fsPath = path;
             if (fs::exists(fsPath))
             {
                 break;
@@ -67,6 +178,7 @@ FileTable::FileTable(const std::string& fileTableConfigPath)
             continue;
         }
 
+        traits = record.traits;
         fileNameLength =
             static_cast<uint16_t>(fsPath.filename().string().size());
         fileSize = static_cast<uint32_t>(fs::file_size(fsPath));
@@ -88,6 +200,8 @@ FileTable::FileTable(const std::string& fileTableConfigPath)
                     fileNameLength, iter);
         std::advance(iter, fileNameLength);
 
+        sizeOffsets.emplace(handle, static_cast<size_t>(std::distance(
+                                        fileTable.begin(), iter)));
         std::copy_n(reinterpret_cast<uint8_t*>(&fileSize), sizeof(fileSize),
                     iter);
         std::advance(iter, sizeof(fileSize));
@@ -102,8 +216,8 @@ FileTable::FileTable(const std::string& fileTableConfigPath)
         entry.traits.value = traits;
 
         // Insert the file entries in the map
+        handles.emplace(entry.fsPath.string(), handle);
         tableEntries.emplace(handle, std::move(entry));
-        handle++;
     }
 
     constexpr uint8_t padWidth = 4;
@@ -115,18 +229,183 @@ FileTable::FileTable(const std::string& fileTableConfigPath)
         fileTable.resize(tableSize + padCount, 0);
     }
 
-    // Calculate the checksum
-    checkSum = crc32(fileTable.data(), fileTable.size());
+    fileTable.resize(fileTable.size() + sizeof(checkSum));
+    updateCheckSum();
 }
 
-Table FileTable::operator()() const
+void FileTable::refresh()
 {
-    Table table(fileTable);
-    table.resize(fileTable.size() + sizeof(checkSum));
-    auto iter = table.begin() + fileTable.size();
+    if (fd == -1)
+    {
+        return;
+    }
+
+    bool rebuild = false;
+    bool rewatch = false;
+    std::unordered_set<Handle> resized;
+    alignas(inotify_event) std::array<char, 4096> buffer;
+    ssize_t bytes{};
+    while ((bytes = ::read(fd, buffer.data(), buffer.size())) > 0)
+    {
+        for (ssize_t offset = 0; offset < bytes;)
+        {
+            auto event =
+                reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                rebuild = true;
+                continue;
+            }
+
+            auto dir = watches.find(event->wd);
+            if (dir == watches.end())
+            {
+                continue;
+            }
+            if (event->mask & IN_IGNORED)
+            {
+                // The directory is gone along with the files in it, its
+                // nearest ancestor is watched till it comes back
+                watches.erase(dir);
+                rebuild = true;
+                rewatch = true;
+                continue;
+            }
+            if (!event->len)
+            {
+                continue;
+            }
+
+            auto path = (dir->second / event->name).string();
+            if ((event->mask & IN_ISDIR) && isConfiguredDir(path))
+            {
+                // A directory on the way to the configured files came or
+                // went, the files in it may have come or gone with it
+                rebuild = true;
+                rewatch = true;
+                continue;
+            }
+            if (!paths.contains(path))
+            {
+                continue;
+            }
+
+            auto handle = handles.find(path);
+            if (handle != handles.end() && (event->mask & sizeEvents))
+            {
+                resized.emplace(handle->second);
+            }
+            else
+            {
+                // A path alternative appeared or disappeared
+                rebuild = true;
+            }
+        }
+    }
+
+    if (rewatch)
+    {
+        watchDirectories();
+    }
+
+    if (!rebuild)
+    {
+        for (auto handle : resized)
+        {
+            if (!updateFileSize(handle))
+            {
+                rebuild = true;
+                break;
+            }
+        }
+    }
+
+    if (rebuild)
+    {
+        encode();
+    }
+    else if (!resized.empty())
+    {
+        updateCheckSum();
+    }
+}
+
+void FileTable::watchDirectories()
+{
+    if (fd == -1)
+    {
+        return;
+    }
+
+    for (const auto& [wd, dir] : watches)
+    {
+        inotify_rm_watch(fd, wd);
+    }
+    watches.clear();
+
+    for (const auto& dir : dirs)
+    {
+        // A directory missing yet is watched through its nearest existing
+        // ancestor, till it is created
+        std::error_code ec;
+        fs::path watched(dir);
+        while (!fs::is_directory(watched, ec) && watched.has_relative_path())
+        {
+            watched = watched.parent_path();
+        }
+
+        auto wd = inotify_add_watch(fd, watched.c_str(),
+                                    sizeEvents | dirEvents);
+        if (wd != -1)
+        {
+            watches.insert_or_assign(wd, std::move(watched));
+        }
+    }
+}
+
+bool FileTable::isConfiguredDir(const std::string& path) const
+{
+    return std::ranges::any_of(dirs, [&path](const auto& dir) {
+        return dir == path ||
+               (dir.starts_with(path) && dir[path.size()] == '/');
+    });
+}
+
+bool FileTable::updateFileSize(Handle handle)
+{
+    std::error_code ec;
+    const auto& fsPath = tableEntries.at(handle).fsPath;
+    if (!fs::is_regular_file(fsPath, ec))
+    {
+        return false;
+    }
+
+    auto fileSize = static_cast<uint32_t>(fs::file_size(fsPath, ec));
+    if (ec)
+    {
+        return false;
+    }
+
+    std::copy_n(reinterpret_cast<uint8_t*>(&fileSize), sizeof(fileSize),
+                fileTable.begin() + sizeOffsets.at(handle));
+    return true;
+}
+
+void FileTable::updateCheckSum()
+{
+    // Calculate the checksum, the table ends with room for it
+    auto tableSize = fileTable.size() - sizeof(checkSum);
+    checkSum = crc32(fileTable.data(), tableSize);
     std::copy_n(reinterpret_cast<const uint8_t*>(&checkSum), sizeof(checkSum),
-                iter);
-    return table;
+                fileTable.begin() + tableSize);
+}
+
+const Table& FileTable::operator()()
+{
+    refresh();
+    return fileTable;
 }
 
 FileTable& buildFileTable(const std::string& fileTablePath)
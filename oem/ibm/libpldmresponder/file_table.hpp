@@ -6,6 +6,9 @@
 #include <nlohmann/json.hpp>
 
 #include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace pldm
@@ -33,6 +36,17 @@ struct FileEntry
     bitfield32_t traits; //!< File traits
 };
 
+/** @struct FileRecord
+ *
+ *  Data structure for storing a file table config entry, the paths are the
+ *  alternatives to try in order of priority.
+ */
+struct FileRecord
+{
+    std::vector<fs::path> paths; //!< File path alternatives
+    uint32_t traits;             //!< File traits
+};
+
 /** @class FileTable
  *
  *  FileTable class encapsulates the data related to files supported by PLDM
@@ -40,6 +54,14 @@ struct FileEntry
  *  file handle and extract the file attribute table. The file attribute table
  *  comprises of metadata for files. Metadata includes the file handle, file
  *  name, current file size and file traits.
+ *
+ *  The file handle is the position of the file in the config, so that the
+ *  handles the host has cached stay valid as files come and go.
+ *
+ *  The directories of the configured files are watched with inotify, the
+ *  ones missing through their nearest existing ancestor. The pending changes
+ *  are applied on every lookup, a size change patches the file entry and the
+ *  checksum in place, a file appearing or disappearing re-encodes the table.
  */
 class FileTable
 {
@@ -52,17 +74,18 @@ class FileTable
      */
     FileTable(const std::string& fileTableConfigPath);
     FileTable() = default;
-    ~FileTable() = default;
-    FileTable(const FileTable&) = default;
-    FileTable& operator=(const FileTable&) = default;
-    FileTable(FileTable&&) = default;
-    FileTable& operator=(FileTable&&) = default;
+    ~FileTable();
+    FileTable(const FileTable&) = delete;
+    FileTable& operator=(const FileTable&) = delete;
+    FileTable(FileTable&& other) noexcept;
+    FileTable& operator=(FileTable&& other) noexcept;
 
     /** @brief Get the file attribute table
      *
-     * @return Table- contents of the file attribute table
+     * @return Table- contents of the file attribute table, including the
+     *                checksum
      */
-    Table operator()() const;
+    const Table& operator()();
 
     /** @brief Get the FileEntry at the file handle
      *
@@ -70,8 +93,9 @@ class FileTable
      *
      * @return FileEntry - file entry at the handle
      */
-    FileEntry at(Handle handle) const
+    FileEntry at(Handle handle)
     {
+        refresh();
         return tableEntries.at(handle);
     }
 
@@ -81,25 +105,71 @@ class FileTable
      */
     bool isEmpty() const
     {
-        return fileTable.empty();
+        return tableEntries.empty();
     }
 
     /** @brief Clear the file table contents
      *
      */
-    void clear()
-    {
-        tableEntries.clear();
-        fileTable.clear();
-        padCount = 0;
-        checkSum = 0;
-    }
+    void clear();
 
   private:
+    /** @brief Encode the file attribute table from the file records */
+    void encode();
+
+    /** @brief Apply the file changes reported by inotify */
+    void refresh();
+
+    /** @brief Watch the directories of the configured files, replacing the
+     *         existing watches
+     */
+    void watchDirectories();
+
+    /** @brief Check if a path is a configured directory or one of its
+     *         ancestors
+     *
+     * @param[in] path - directory path
+     *
+     * @return bool - true if the path leads to a configured directory
+     */
+    bool isConfiguredDir(const std::string& path) const;
+
+    /** @brief Patch the size of a file entry in the file attribute table
+     *
+     * @param[in] handle - file handle
+     *
+     * @return bool - false if the file is no longer a regular file
+     */
+    bool updateFileSize(Handle handle);
+
+    /** @brief Compute the checksum and store it at the end of the table */
+    void updateCheckSum();
+
+    /** @brief file table config entries */
+    std::vector<FileRecord> records;
+
     /** @brief handle to FileEntry mappings for lookups based on file handle */
     std::unordered_map<Handle, FileEntry> tableEntries;
 
-    /** @brief file attribute table including the pad bytes, except the checksum
+    /** @brief file path to handle mappings of the files in the table */
+    std::unordered_map<std::string, Handle> handles;
+
+    /** @brief offset of the file size field of each handle in the table */
+    std::unordered_map<Handle, size_t> sizeOffsets;
+
+    /** @brief all the path alternatives of the file records */
+    std::unordered_set<std::string> paths;
+
+    /** @brief directories of the path alternatives */
+    std::unordered_set<std::string> dirs;
+
+    /** @brief watched directories keyed by watch descriptor */
+    std::unordered_map<int, fs::path> watches;
+
+    /** @brief inotify file descriptor */
+    int fd = -1;
+
+    /** @brief file attribute table including the pad bytes and the checksum
      */
     std::vector<uint8_t> fileTable;
 
@@ -1,10 +1,15 @@
 #include "fru_oem_ibm.hpp"
 
+#include "host-bmc/dbus/custom_dbus.hpp"
+
 #include <com/ibm/VPD/Manager/client.hpp>
 #include <phosphor-logging/lg2.hpp>
 
+#include <cstring>
 #include <format>
-#include <ranges>
+#include <map>
+#include <string_view>
+#include <tuple>
 
 PHOSPHOR_LOG2_USING;
 
@@ -15,6 +20,10 @@ namespace responder
 namespace oem_ibm_fru
 {
 
+constexpr auto itemInterface = "xyz.openbmc_project.Inventory.Item";
+constexpr auto pcieDeviceInterface =
+    "xyz.openbmc_project.Inventory.Item.PCIeDevice";
+
 void pldm::responder::oem_ibm_fru::Handler::setIBMFruHandler(
     pldm::responder::fru::Handler* handler)
 {
@@ -24,65 +33,61 @@ void pldm::responder::oem_ibm_fru::Handler::setIBMFruHandler(
 int pldm::responder::oem_ibm_fru::Handler::processOEMFRUTable(
     const std::vector<uint8_t>& fruData)
 {
-    uint8_t dataSize = 0;
-    const uint8_t* data = fruData.data();
+    // Record header and TLV header sizes, without the variable length parts
+    constexpr auto recordHdrSize = sizeof(pldm_fru_record_data_format) -
+                                   sizeof(pldm_fru_record_tlv);
+    constexpr auto tlvHdrSize = sizeof(pldm_fru_record_tlv) - sizeof(uint8_t);
+
+    EntityObjectPaths entityObjectPaths;
+    for (const auto& [objPath, entity] : getAssociateEntityMap())
+    {
+        entityObjectPaths[std::make_tuple(entity.entity_type,
+                                          entity.entity_instance_num,
+                                          entity.entity_container_id)]
+            .emplace_back(objPath);
+    }
 
-    while (dataSize < fruData.size())
+    pldm::utils::ObjectValueTree objects;
+    int rc = PLDM_SUCCESS;
+    size_t offset = 0;
+
+    while (rc == PLDM_SUCCESS && offset < fruData.size())
     {
-        auto record =
-            reinterpret_cast<const pldm_fru_record_data_format*>(data);
-        if (!record)
+        if (fruData.size() - offset < recordHdrSize)
         {
-            return PLDM_ERROR_INVALID_DATA;
+            rc = PLDM_ERROR_INVALID_DATA;
+            break;
         }
 
-        auto& entityAssociationMap = getAssociateEntityMap();
+        auto record = reinterpret_cast<const pldm_fru_record_data_format*>(
+            fruData.data() + offset);
         uint16_t fruRSI = le16toh(record->record_set_id);
+        auto numFruFields = record->num_fru_fields;
+        offset += recordHdrSize;
 
-        dataSize += sizeof(pldm_fru_record_data_format) -
-                    sizeof(pldm_fru_record_tlv);
-        data += dataSize;
-
-        for ([[maybe_unused]] const auto& i :
-             std::views::iota(0, (int)record->num_fru_fields))
+        for (uint8_t i = 0; i < numFruFields; ++i)
         {
-            auto tlv = reinterpret_cast<const pldm_fru_record_tlv*>(data);
-            if (!tlv)
+            if (fruData.size() - offset < tlvHdrSize)
+            {
+                rc = PLDM_ERROR_INVALID_DATA;
+                break;
+            }
+
+            auto tlv = reinterpret_cast<const pldm_fru_record_tlv*>(
+                fruData.data() + offset);
+            if (fruData.size() - offset - tlvHdrSize < tlv->length)
             {
-                return PLDM_ERROR_INVALID_DATA;
+                rc = PLDM_ERROR_INVALID_DATA;
+                break;
             }
 
-            if (tlv->type == PLDM_OEM_FRU_FIELD_TYPE_PCIE_CONFIG_SPACE_DATA)
+            if (tlv->type == PLDM_OEM_FRU_FIELD_TYPE_PCIE_CONFIG_SPACE_DATA &&
+                tlv->length >= sizeof(PcieConfigSpaceData))
             {
-                auto pcieData =
-                    reinterpret_cast<const PcieConfigSpaceData*>(tlv->value);
-
-                if (!pcieData)
-                {
-                    return PLDM_ERROR_INVALID_DATA;
-                }
-
-                auto vendorId = std::format("0x{:04x}",
-                                            htole16(pcieData->vendorId));
-                auto deviceId = std::format("0x{:04x}",
-                                            htole16(pcieData->deviceId));
-                auto revisionId = std::format("0x{:02x}",
-                                              htole16(pcieData->revisionId));
-
-                std::string classCode = "0x";
-                for (const auto& ele : pcieData->classCode)
-                {
-                    classCode += std::format("{:02x}", ele);
-                }
-
-                auto subSystemVendorId = std::format(
-                    "0x{:04x}", htole16(pcieData->subSystemVendorId));
-                auto subSystemId = std::format("0x{:04x}",
-                                               htole16(pcieData->subSystemId));
-
-                updateDBusProperty(fruRSI, entityAssociationMap, vendorId,
-                                   deviceId, revisionId, classCode,
-                                   subSystemVendorId, subSystemId);
+                PcieConfigSpaceData pcieData{};
+                std::memcpy(&pcieData, tlv->value, sizeof(pcieData));
+                collectPCIeProperties(fruRSI, entityObjectPaths, pcieData,
+                                      objects);
             }
 
             if (tlv->type == PLDM_OEM_IBM_FRU_FIELD_TYPE_FIRMWARE_UAK)
@@ -91,77 +96,210 @@ int pldm::responder::oem_ibm_fru::Handler::processOEMFRUTable(
                                            &tlv->value[tlv->length]);
                 setFirmwareUAK(value);
             }
-            // length of tlv is removed from the structure pldm_fru_record_tlv
-            // and the new tlv length is added back.
-            dataSize += sizeof(pldm_fru_record_tlv) - sizeof(uint8_t) +
-                        tlv->length;
-            data += dataSize;
+
+            offset += tlvHdrSize + tlv->length;
         }
     }
 
-    return PLDM_SUCCESS;
+    // Publish whatever was decoded, even if the table is truncated
+    publishInventoryProperties(objects);
+
+    return rc;
 }
 
-void Handler::updateDBusProperty(
-    uint16_t fruRSI, const AssociatedEntityMap& fruAssociationMap,
-    const std::string& vendorId, const std::string& deviceId,
-    const std::string& revisionId, const std::string& classCode,
-    const std::string& subSystemVendorId, const std::string& subSystemId)
+void Handler::collectPCIeProperties(uint16_t fruRSI,
+                                    const EntityObjectPaths& entityObjectPaths,
+                                    const PcieConfigSpaceData& pcieData,
+                                    pldm::utils::ObjectValueTree& objects)
 {
     uint16_t entityType{};
     uint16_t entityInstanceNum{};
     uint16_t containerId{};
     uint16_t terminusHandle{};
-    const pldm_pdr_record* record{};
 
-    record = pldm_pdr_fru_record_set_find_by_rsi(
+    auto record = pldm_pdr_fru_record_set_find_by_rsi(
         pdrRepo, fruRSI, &terminusHandle, &entityType, &entityInstanceNum,
         &containerId);
+    if (!record)
+    {
+        return;
+    }
+
+    auto it = entityObjectPaths.find(
+        std::make_tuple(entityType, entityInstanceNum, containerId));
+    if (it == entityObjectPaths.end())
+    {
+        return;
+    }
+
+    std::string classCode = "0x";
+    for (const auto& ele : pcieData.classCode)
+    {
+        classCode += std::format("{:02x}", ele);
+    }
 
-    if (record)
+    pldm::utils::PropertyMap pcieProperties{
+        {"Function0VendorId",
+         std::format("0x{:04x}", htole16(pcieData.vendorId))},
+        {"Function0DeviceId",
+         std::format("0x{:04x}", htole16(pcieData.deviceId))},
+        {"Function0RevisionId",
+         std::format("0x{:02x}", htole16(pcieData.revisionId))},
+        {"Function0ClassCode", classCode},
+        {"Function0SubsystemVendorId",
+         std::format("0x{:04x}", htole16(pcieData.subSystemVendorId))},
+        {"Function0SubsystemId",
+         std::format("0x{:04x}", htole16(pcieData.subSystemId))}};
+
+    for (const auto& objPath : it->second)
     {
-        for (const auto& [key, value] : fruAssociationMap)
+        auto& interfaces = objects[sdbusplus::message::object_path(objPath)];
+        if (!(pldm::responder::utils::checkIfIBMFru(objPath)))
         {
-            if (entityInstanceNum == value.entity_instance_num &&
-                entityType == value.entity_type &&
-                containerId == value.entity_container_id)
-            {
-                if (!(pldm::responder::utils::checkIfIBMFru(key)))
-                {
-                    pldm::utils::setFruPresence(key, true);
-                }
-                dbus_map_update(key, "Function0VendorId", vendorId);
-                dbus_map_update(key, "Function0DeviceId", deviceId);
-                dbus_map_update(key, "Function0RevisionId", revisionId);
-                dbus_map_update(key, "Function0ClassCode", classCode);
-                dbus_map_update(key, "Function0SubsystemVendorId",
-                                subSystemVendorId);
-                dbus_map_update(key, "Function0SubsystemId", subSystemId);
-            }
+            interfaces[itemInterface]["Present"] = true;
+        }
+        interfaces[pcieDeviceInterface] = pcieProperties;
+    }
+}
+
+void Handler::publishInventoryProperties(
+    const pldm::utils::ObjectValueTree& objects)
+{
+    // Objects of the other services, grouped by the owning service
+    std::map<std::string, pldm::utils::ObjectValueTree> serviceObjects;
+    for (const auto& [objPath, interfaces] : objects)
+    {
+        if (updateHostedObject(objPath.str, interfaces))
+        {
+            continue;
+        }
+
+        try
+        {
+            auto service = dBusIntf->getService(objPath.str.c_str(),
+                                                pcieDeviceInterface);
+            serviceObjects[service].emplace(objPath, interfaces);
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to find the service hosting the PCIe device '{PATH}', error - {ERROR}",
+                "PATH", objPath.str, "ERROR", e);
+        }
+    }
+    if (serviceObjects.empty())
+    {
+        return;
+    }
+
+    std::string inventoryService;
+    try
+    {
+        inventoryService = dBusIntf->getService(
+            pldm::utils::inventoryPath,
+            pldm::utils::inventoryManager::interface);
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to find the inventory manager, error - {ERROR}", "ERROR",
+              e);
+    }
+
+    for (const auto& [service, serviceObjs] : serviceObjects)
+    {
+        if (service == inventoryService)
+        {
+            notifyInventoryManager(service, serviceObjs);
+            continue;
+        }
+        for (const auto& [objPath, interfaces] : serviceObjs)
+        {
+            setObjectProperties(objPath.str, interfaces);
         }
     }
 }
 
-void Handler::dbus_map_update(const std::string& adapterObjPath,
-                              const std::string& propertyName,
-                              const std::string& propValue)
+bool Handler::updateHostedObject(const std::string& objPath,
+                                 const pldm::utils::InterfaceMap& interfaces)
+{
+    auto& customDBus = pldm::dbus::CustomDBus::getCustomDBus();
+    auto pcieProperties = interfaces.find(pcieDeviceInterface);
+    if (pcieProperties == interfaces.end() ||
+        !customDBus.setPCIeDeviceFunction0Props(objPath,
+                                                pcieProperties->second))
+    {
+        return false;
+    }
+
+    if (interfaces.contains(itemInterface))
+    {
+        customDBus.updateItemPresentStatus(objPath, true);
+    }
+    return true;
+}
+
+void Handler::notifyInventoryManager(
+    const std::string& service, const pldm::utils::ObjectValueTree& objects)
 {
-    pldm::utils::PropertyValue value = propValue;
-    pldm::utils::DBusMapping dbusMapping;
-    dbusMapping.objectPath = adapterObjPath;
-    dbusMapping.interface = "xyz.openbmc_project.Inventory.Item.PCIeDevice";
-    dbusMapping.propertyName = propertyName;
-    dbusMapping.propertyType = "string";
+    // The inventory manager expects the object paths relative to the
+    // inventory root
+    std::string_view inventoryRoot = pldm::utils::inventoryPath;
+    pldm::utils::ObjectValueTree notifyObjects;
+    for (const auto& [objPath, interfaces] : objects)
+    {
+        std::string_view path = objPath.str;
+        if (path.starts_with(inventoryRoot))
+        {
+            path.remove_prefix(inventoryRoot.size());
+        }
+        notifyObjects.emplace(
+            sdbusplus::message::object_path(std::string(path)), interfaces);
+    }
+
+    auto& bus = pldm::utils::DBusHandler::getBus();
     try
     {
-        pldm::utils::DBusHandler().setDbusProperty(dbusMapping, value);
+        auto method = bus.new_method_call(
+            service.c_str(), pldm::utils::inventoryPath,
+            pldm::utils::inventoryManager::interface, "Notify");
+        method.append(notifyObjects);
+        bus.call_noreply(method, dbusTimeout);
     }
     catch (const std::exception& e)
     {
         error(
-            "Failed to set property '{PROPERTY} at path '{PATH}' and interface '{INTERFACE}', error - {ERROR}",
-            "PROPERTY", propertyName, "PATH", adapterObjPath, "INTERFACE",
-            dbusMapping.interface, "ERROR", e);
+            "Failed to publish the PCIe device properties of '{COUNT}' objects to the inventory manager, error - {ERROR}",
+            "COUNT", notifyObjects.size(), "ERROR", e);
+    }
+}
+
+void Handler::setObjectProperties(const std::string& objPath,
+                                  const pldm::utils::InterfaceMap& interfaces)
+{
+    for (const auto& [interface, properties] : interfaces)
+    {
+        for (const auto& [propertyName, value] : properties)
+        {
+            if (interface == itemInterface && propertyName == "Present")
+            {
+                pldm::utils::setFruPresence(objPath, std::get<bool>(value));
+                continue;
+            }
+
+            pldm::utils::DBusMapping dbusMapping{objPath, interface,
+                                                 propertyName, "string"};
+            try
+            {
+                dBusIntf->setDbusProperty(dbusMapping, value);
+            }
+            catch (const std::exception& e)
+            {
+                error(
+                    "Failed to set property '{PROPERTY}' at path '{PATH}' and interface '{INTERFACE}', error - {ERROR}",
+                    "PROPERTY", propertyName, "PATH", objPath, "INTERFACE",
+                    interface, "ERROR", e);
+            }
+        }
     }
 }
 
@@ -17,6 +17,12 @@ using AssociatedEntityMap = std::map<ObjectPath, pldm_entity>;
 namespace oem_ibm_fru
 {
 
+/** @brief FRU object paths keyed by entity type, entity instance number and
+ *         container ID
+ */
+using EntityObjectPaths =
+    std::map<std::tuple<uint16_t, uint16_t, uint16_t>, std::vector<ObjectPath>>;
+
 // structure of the PCIE config space data
 struct PcieConfigSpaceData
 {
@@ -35,7 +41,9 @@ struct PcieConfigSpaceData
 class Handler : public oem_fru::Handler
 {
   public:
-    Handler(pldm_pdr* repo) : pdrRepo(repo) {}
+    Handler(const pldm::utils::DBusHandler* dBusIntf, pldm_pdr* repo) :
+        dBusIntf(dBusIntf), pdrRepo(repo)
+    {}
 
     /** @brief Method to set the fru handler in the
      *    oem_ibm_handler class
@@ -57,7 +65,49 @@ class Handler : public oem_fru::Handler
         return fruHandler->getAssociateEntityMap();
     }
 
-    ~Handler() = default;
+    virtual ~Handler() = default;
+
+  protected:
+    /** @brief Publish the collected inventory properties. The objects pldm
+     *         hosts are updated in place, the objects of the inventory
+     *         manager are sent with a single Notify call and the objects of
+     *         any other service are updated property by property.
+     *
+     *  @param[in] objects - the inventory objects to be published
+     */
+    void publishInventoryProperties(
+        const pldm::utils::ObjectValueTree& objects);
+
+    /** @brief Update the properties of an inventory object hosted by pldm
+     *
+     *  @param[in] objPath - the inventory object path
+     *  @param[in] interfaces - the properties to be set, by interface
+     *
+     *  @return false if pldm doesn't host the object
+     */
+    virtual bool
+        updateHostedObject(const std::string& objPath,
+                           const pldm::utils::InterfaceMap& interfaces);
+
+    /** @brief Send the inventory objects to the inventory manager
+     *
+     *  @param[in] service - D-Bus service of the inventory manager
+     *  @param[in] objects - the inventory objects, by absolute object path
+     */
+    virtual void notifyInventoryManager(
+        const std::string& service,
+        const pldm::utils::ObjectValueTree& objects);
+
+    /** @brief Set the properties of an inventory object one by one
+     *
+     *  @param[in] objPath - the inventory object path
+     *  @param[in] interfaces - the properties to be set, by interface
+     */
+    void setObjectProperties(const std::string& objPath,
+                             const pldm::utils::InterfaceMap& interfaces);
+
+    /** @brief D-Bus handler used to find the owners of the objects */
+    const pldm::utils::DBusHandler* dBusIntf;
 
   private:
     /** @brief pointer to BMC's primary PDR repo */
@@ -65,33 +115,19 @@ class Handler : public oem_fru::Handler
 
     pldm::responder::fru::Handler* fruHandler; //!< pointer to PLDM fru handler
 
-    /** @brief update the DBus property
+    /** @brief Collect the PCIe device properties of a PCIe config space
+     *         data field
      *
      *  @param[in] fruRSI - fru record set identifier
-     *  @param[in] fruAssociationMap - the dbus path to pldm entity stored while
-     *                                 creating the pldm fru records
-     *  @param[in] vendorId - the vendor ID
-     *  @param[in] deviceId - the device ID
-     *  @param[in] revisionId - the revision ID
-     *  @param[in] classCode - the class Code
-     *  @param[in] subSystemVendorId - the subSystemVendor ID
-     *  @param[in] subSystemId - the subSystem ID
-     */
-    void updateDBusProperty(
-        uint16_t fruRSI, const AssociatedEntityMap& fruAssociationMap,
-        const std::string& vendorId, const std::string& deviceId,
-        const std::string& revisionId, const std::string& classCode,
-        const std::string& subSystemVendorId, const std::string& subSystemId);
-
-    /** @brief DBus Map update
-     *
-     *  @param[in] adapterObjectPath - the fru object path
-     *  @param[in] propertyName - the fru property name
-     *  @param[in] propValue - the fru property value
+     *  @param[in] entityObjectPaths - FRU object paths by entity, built from
+     *                                 the dbus path to pldm entity map
+     *  @param[in] pcieData - the PCIe config space data
+     *  @param[in,out] objects - the inventory objects to be published
      */
-    void dbus_map_update(const std::string& adapterObjectPath,
-                         const std::string& propertyName,
-                         const std::string& propValue);
+    void collectPCIeProperties(uint16_t fruRSI,
+                               const EntityObjectPaths& entityObjectPaths,
+                               const PcieConfigSpaceData& pcieData,
+                               pldm::utils::ObjectValueTree& objects);
 
     /** @brief setting firmware UAK (Update Access Key)
      *
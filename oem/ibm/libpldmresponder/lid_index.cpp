@@ -0,0 +1,234 @@
+#include "lid_index.hpp"
+
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <sstream>
+#include <string_view>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+
+namespace
+{
+
+constexpr std::string_view lidSuffix = ".lid";
+
+/** @brief Events dropping the index entry of a LID file */
+constexpr uint32_t lidEvents = IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                               IN_MOVED_TO | IN_MODIFY | IN_CLOSE_WRITE |
+                               IN_ATTRIB;
+
+/** @brief Events on the parent directory replacing a LID directory */
+constexpr uint32_t dirEvents = IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                               IN_MOVED_TO;
+
+std::optional<uint64_t> statLid(const std::string& path)
+{
+    struct stat st{};
+    if (::stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode))
+    {
+        return st.st_size;
+    }
+
+    return std::nullopt;
+}
+
+} // namespace
+
+LidIndex::LidIndex(sdeventplus::Event& event, const LidDirs& lidDirs)
+{
+    for (size_t i = 0; i < dirs.size(); ++i)
+    {
+        dirs[i].path = lidDirs[i];
+    }
+
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd == -1)
+    {
+        error(
+            "Failed to initialize inotify for the LID index, error number - {ERROR_NUM}",
+            "ERROR_NUM", errno);
+        return;
+    }
+
+    try
+    {
+        io = std::make_unique<sdeventplus::source::IO>(
+            event, fd, EPOLLIN,
+            [this](sdeventplus::source::IO&, int, uint32_t) {
+            processEvents();
+        });
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to watch the LID directories, error - {ERROR}", "ERROR",
+              e);
+        close(fd);
+        fd = -1;
+    }
+}
+
+LidIndex::~LidIndex()
+{
+    io.reset();
+    if (fd != -1)
+    {
+        close(fd);
+    }
+}
+
+LidIndex& LidIndex::get()
+{
+    static auto event = sdeventplus::Event::get_default();
+    static LidIndex lidIndex(event,
+                             {LID_RUNNING_DIR, LID_ALTERNATE_DIR,
+                              LID_RUNNING_PATCH_DIR, LID_ALTERNATE_PATCH_DIR});
+    return lidIndex;
+}
+
+std::string LidIndex::path(LidDir dir, uint32_t lidId) const
+{
+    std::stringstream stream;
+    stream << std::hex << lidId;
+    return (dirs[static_cast<size_t>(dir)].path /
+            (stream.str() + std::string(lidSuffix)))
+        .string();
+}
+
+std::optional<uint64_t> LidIndex::fileSize(LidDir dir, uint32_t lidId)
+{
+    auto& directory = dirs[static_cast<size_t>(dir)];
+
+    // Changes made since the last dispatch of the event loop are still queued
+    processEvents();
+    if (directory.wd == -1 && !watch(directory))
+    {
+        return statLid(path(dir, lidId));
+    }
+
+    if (auto it = directory.sizes.find(lidId); it != directory.sizes.end())
+    {
+        return it->second;
+    }
+
+    auto size = statLid(path(dir, lidId));
+    directory.sizes.emplace(lidId, size);
+    return size;
+}
+
+bool LidIndex::watch(Directory& dir)
+{
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    if (dir.parentWd == -1)
+    {
+        dir.parentWd = inotify_add_watch(fd, dir.path.parent_path().c_str(),
+                                         dirEvents | IN_ONLYDIR | IN_MASK_ADD);
+        if (dir.parentWd == -1)
+        {
+            return false;
+        }
+    }
+
+    dir.wd = inotify_add_watch(fd, dir.path.c_str(), lidEvents | IN_ONLYDIR);
+    return dir.wd != -1;
+}
+
+void LidIndex::unwatch(Directory& dir)
+{
+    dir.sizes.clear();
+    if (dir.wd == -1)
+    {
+        return;
+    }
+
+    // The running and the alternate directory can resolve to the same one
+    if (std::ranges::count(dirs, dir.wd, &Directory::wd) == 1)
+    {
+        inotify_rm_watch(fd, dir.wd);
+    }
+    dir.wd = -1;
+}
+
+void LidIndex::processEvents()
+{
+    if (fd == -1)
+    {
+        return;
+    }
+
+    alignas(inotify_event) std::array<char, 4096> buffer;
+    ssize_t bytes{};
+    while ((bytes = ::read(fd, buffer.data(), buffer.size())) > 0)
+    {
+        for (ssize_t offset = 0; offset < bytes;)
+        {
+            auto event =
+                reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                for (auto& dir : dirs)
+                {
+                    dir.sizes.clear();
+                }
+                continue;
+            }
+
+            std::string_view name = event->len ? event->name : "";
+            for (auto& dir : dirs)
+            {
+                if (event->wd == dir.parentWd)
+                {
+                    if (event->mask & IN_IGNORED)
+                    {
+                        dir.parentWd = -1;
+                        unwatch(dir);
+                    }
+                    else if (name == dir.path.filename().native())
+                    {
+                        unwatch(dir);
+                    }
+                }
+                else if (event->wd == dir.wd)
+                {
+                    if (event->mask &
+                        (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF))
+                    {
+                        unwatch(dir);
+                    }
+                    else if (name.ends_with(lidSuffix))
+                    {
+                        auto stem = name.substr(0,
+                                                name.size() - lidSuffix.size());
+                        uint32_t lidId{};
+                        auto [ptr, ec] = std::from_chars(
+                            stem.data(), stem.data() + stem.size(), lidId, 16);
+                        if (ec == std::errc() &&
+                            ptr == stem.data() + stem.size())
+                        {
+                            dir.sizes.erase(lidId);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace pldm
+{
+namespace responder
+{
+
+namespace fs = std::filesystem;
+
+/** @brief Directories the LIDs are served from */
+enum class LidDir : uint8_t
+{
+    Running,
+    Alternate,
+    RunningPatch,
+    AlternatePatch,
+};
+
+using LidDirs = std::array<fs::path, 4>;
+
+/** @class LidIndex
+ *
+ *  @brief Index of the LID files served to the host. The index maps a LID ID
+ *  to the size of its file, or to its absence, in each of the LID
+ *  directories so that the LID path probes made on every ReadFile request
+ *  are answered from memory.
+ *
+ *  A directory is only indexed while an inotify watch is in place on it and
+ *  on its parent, the later catches the directory being replaced (e.g. a
+ *  symlink switched to another image). Any change reported by the watches
+ *  drops the affected entries, the events still queued are consumed ahead of
+ *  every lookup. Lookups in a directory that can't be watched go to the file
+ *  system.
+ */
+class LidIndex
+{
+  public:
+    LidIndex() = delete;
+    LidIndex(const LidIndex&) = delete;
+    LidIndex& operator=(const LidIndex&) = delete;
+    LidIndex(LidIndex&&) = delete;
+    LidIndex& operator=(LidIndex&&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - event loop the inotify events are processed on
+     *  @param[in] dirs - LID directories, in the order of LidDir
+     */
+    LidIndex(sdeventplus::Event& event, const LidDirs& dirs);
+
+    ~LidIndex();
+
+    /** @brief Get the index of the LID directories of the BMC, attached to
+     *         the default event loop
+     *
+     *  @return reference to the LID index
+     */
+    static LidIndex& get();
+
+    /** @brief Get the path of a LID file
+     *
+     *  @param[in] dir - LID directory
+     *  @param[in] lidId - LID ID
+     *
+     *  @return path of the LID file
+     */
+    std::string path(LidDir dir, uint32_t lidId) const;
+
+    /** @brief Get the size of a LID file
+     *
+     *  @param[in] dir - LID directory
+     *  @param[in] lidId - LID ID
+     *
+     *  @return size of the LID file, std::nullopt if it is not a regular file
+     */
+    std::optional<uint64_t> fileSize(LidDir dir, uint32_t lidId);
+
+  private:
+    struct Directory
+    {
+        fs::path path;     //!< LID directory
+        int wd = -1;       //!< watch descriptor of the directory
+        int parentWd = -1; //!< watch descriptor of the parent directory
+        /** @brief LID file sizes keyed by LID ID, std::nullopt for LIDs that
+         *         are not present
+         */
+        std::unordered_map<uint32_t, std::optional<uint64_t>> sizes;
+    };
+
+    /** @brief Put the inotify watches in place for a directory
+     *
+     *  @param[in] dir - LID directory
+     *
+     *  @return true if the directory and its parent are watched
+     */
+    bool watch(Directory& dir);
+
+    /** @brief Stop indexing a directory
+     *
+     *  @param[in] dir - LID directory
+     */
+    void unwatch(Directory& dir);
+
+    /** @brief Drop the index entries affected by the pending inotify events
+     */
+    void processEvents();
+
+    /** @brief inotify file descriptor */
+    int fd = -1;
+
+    /** @brief indexed directories, in the order of LidDir */
+    std::array<Directory, 4> dirs;
+
+    /** @brief event source of the inotify file descriptor */
+    std::unique_ptr<sdeventplus::source::IO> io;
+};
+
+} // namespace responder
+} // namespace pldm
@@ -279,6 +279,7 @@ void attachOemEntityToEntityAssociationPDR(
                 repo.getPdr(), bmc_record_handle, &parent_entity, &childEntity,
                 &updatedRecordHdlBmc);
         }
+        pdr_utils::repoModified(repo.getPdr());
     }
 }
 
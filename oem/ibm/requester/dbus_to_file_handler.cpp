@@ -1,6 +1,7 @@
 #include "dbus_to_file_handler.hpp"
 
 #include "common/utils.hpp"
+#include "oem/ibm/libpldmresponder/cert_exchange.hpp"
 
 #include <libpldm/oem/ibm/file_io.h>
 
@@ -218,35 +219,15 @@ std::string DbusToFileHandler::getAcfFileContent()
 void DbusToFileHandler::newCsrFileAvailable(const std::string& csr,
                                             const std::string fileHandle)
 {
-    namespace fs = std::filesystem;
-    std::string dirPath = "/var/lib/ibm/bmcweb";
-    const fs::path certDirPath = dirPath;
-
-    if (!fs::exists(certDirPath))
+    auto handle = static_cast<uint32_t>(stoi(fileHandle));
+    auto fileSize =
+        pldm::responder::CertExchange::get().stageCsr(handle, csr + "\n");
+    if (!fileSize)
     {
-        fs::create_directories(certDirPath);
-        fs::permissions(certDirPath,
-                        fs::perms::others_read | fs::perms::owner_write);
-    }
-
-    fs::path certFilePath = certDirPath / ("CSR_" + fileHandle);
-    std::ofstream certFile;
-
-    certFile.open(certFilePath, std::ios::out | std::ofstream::binary);
-
-    if (!certFile)
-    {
-        error("Failed to open certificate file '{PATH}'", "PATH", certFilePath);
         return;
     }
 
-    // Add csr to file
-    certFile << csr << std::endl;
-
-    certFile.close();
-    uint32_t fileSize = fs::file_size(certFilePath);
-
-    newFileAvailableSendToHost(fileSize, (uint32_t)stoi(fileHandle),
+    newFileAvailableSendToHost(*fileSize, handle,
                                PLDM_FILE_TYPE_CERT_SIGNING_REQUEST);
 }
 
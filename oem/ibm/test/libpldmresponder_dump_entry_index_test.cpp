@@ -0,0 +1,136 @@
+#include "oem/ibm/libpldmresponder/dump_entry_index.hpp"
+
+#include <sdbusplus/message.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder;
+
+namespace
+{
+
+constexpr auto dumpEntryIntf = "xyz.openbmc_project.Dump.Entry";
+constexpr auto systemDumpIntf = "xyz.openbmc_project.Dump.Entry.System";
+constexpr auto resourceDumpIntf = "xyz.openbmc_project.Dump.Entry.Resource";
+constexpr auto dump1 = "/xyz/openbmc_project/dump/system/entry/1";
+constexpr auto dump2 = "/xyz/openbmc_project/dump/system/entry/2";
+
+/** @brief the source dump ID fileAck resets a discarded dump to */
+constexpr uint32_t resetSourceDumpId = 0xFFFFFFFF;
+
+class TestDumpEntryIndex : public DumpEntryIndex
+{
+  public:
+    using DumpEntryIndex::remove;
+};
+
+} // namespace
+
+TEST(DumpEntryIndex, update)
+{
+    TestDumpEntryIndex index;
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 1), std::nullopt);
+
+    index.update(dump1, systemDumpIntf, {{"SourceDumpId", uint32_t{1}}});
+    index.update(dump1, dumpEntryIntf,
+                 {{"OffloadUri", std::string("/var/lib/dump/1")}});
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 1), dump1);
+    EXPECT_EQ(index.getOffloadUri(dump1), "/var/lib/dump/1");
+
+    // The source dump IDs are indexed per interface
+    EXPECT_EQ(index.findBySourceDumpId(resourceDumpIntf, 1), std::nullopt);
+
+    // A source dump ID of another type or the offload URI of another
+    // interface is not indexed
+    index.update(dump2, systemDumpIntf, {{"SourceDumpId", std::string("2")}});
+    index.update(dump2, systemDumpIntf,
+                 {{"OffloadUri", std::string("/var/lib/dump/2")}});
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 2), std::nullopt);
+    EXPECT_EQ(index.getOffloadUri(dump2), std::nullopt);
+
+    // An emptied offload URI is reported missing
+    index.update(dump1, dumpEntryIntf, {{"OffloadUri", std::string()}});
+    EXPECT_EQ(index.getOffloadUri(dump1), std::nullopt);
+}
+
+TEST(DumpEntryIndex, reassignedSourceDumpId)
+{
+    TestDumpEntryIndex index;
+    index.update(dump1, systemDumpIntf, {{"SourceDumpId", uint32_t{1}}});
+
+    // The entry is looked up by its new source dump ID only
+    index.update(dump1, systemDumpIntf, {{"SourceDumpId", uint32_t{3}}});
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 1), std::nullopt);
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 3), dump1);
+
+    // The source dump ID moved to another entry is not dropped along with
+    // the change of the previous entry
+    index.update(dump2, systemDumpIntf, {{"SourceDumpId", uint32_t{3}}});
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 3), dump2);
+    index.update(dump1, systemDumpIntf, {{"SourceDumpId", uint32_t{4}}});
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 3), dump2);
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 4), dump1);
+
+    // Setting the same source dump ID again keeps the entry indexed
+    index.update(dump2, systemDumpIntf, {{"SourceDumpId", uint32_t{3}}});
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 3), dump2);
+}
+
+TEST(DumpEntryIndex, resetSourceDumpId)
+{
+    TestDumpEntryIndex index;
+    index.update(dump1, systemDumpIntf, {{"SourceDumpId", uint32_t{1}}});
+    index.update(dump2, systemDumpIntf, {{"SourceDumpId", uint32_t{2}}});
+
+    // The discarded dumps are no longer found by their source dump ID
+    index.update(dump1, systemDumpIntf,
+                 {{"SourceDumpId", resetSourceDumpId}});
+    index.update(dump2, systemDumpIntf,
+                 {{"SourceDumpId", resetSourceDumpId}});
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 1), std::nullopt);
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 2), std::nullopt);
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, resetSourceDumpId),
+              dump2);
+
+    // Removing an entry leaves the reset ID of the other entry alone
+    index.remove(dump1);
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, resetSourceDumpId),
+              dump2);
+    index.remove(dump2);
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, resetSourceDumpId),
+              std::nullopt);
+}
+
+TEST(DumpEntryIndex, remove)
+{
+    TestDumpEntryIndex index;
+    index.update(dump1, systemDumpIntf, {{"SourceDumpId", uint32_t{1}}});
+    index.update(dump1, dumpEntryIntf,
+                 {{"OffloadUri", std::string("/var/lib/dump/1")}});
+
+    index.remove(dump1);
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 1), std::nullopt);
+    EXPECT_EQ(index.getOffloadUri(dump1), std::nullopt);
+
+    // Unknown entries are ignored
+    index.remove(dump2);
+}
+
+TEST(DumpEntryIndex, seed)
+{
+    TestDumpEntryIndex index;
+    index.update(dump1, systemDumpIntf, {{"SourceDumpId", uint32_t{1}}});
+
+    // The entries of the dump manager replace the indexed ones
+    pldm::dbus::ObjectValueTree objects{
+        {sdbusplus::message::object_path(dump2),
+         {{systemDumpIntf, {{"SourceDumpId", uint32_t{2}}}},
+          {dumpEntryIntf,
+           {{"OffloadUri", std::string("/var/lib/dump/2")}}}}}};
+    index.seed(objects);
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 1), std::nullopt);
+    EXPECT_EQ(index.findBySourceDumpId(systemDumpIntf, 2), dump2);
+    EXPECT_EQ(index.getOffloadUri(dump2), "/var/lib/dump/2");
+}
@@ -1,4 +1,5 @@
 
+#include "libpldmresponder/cert_exchange.hpp"
 #include "libpldmresponder/file_io.hpp"
 #include "libpldmresponder/file_io_by_type.hpp"
 #include "libpldmresponder/file_io_type_cert.hpp"
@@ -7,10 +8,12 @@
 #include "libpldmresponder/file_io_type_pcie.hpp"
 #include "libpldmresponder/file_io_type_pel.hpp"
 #include "libpldmresponder/file_table.hpp"
+#include "libpldmresponder/lid_index.hpp"
 #include "xyz/openbmc_project/Common/error.hpp"
 
 #include <libpldm/base.h>
 #include <libpldm/oem/ibm/file_io.h>
+#include <libpldm/utils.h>
 
 #include <nlohmann/json.hpp>
 
@@ -431,6 +434,69 @@ TEST_F(TestFileTable, ValidateFileTable)
               std::equal(attrTable.begin(), attrTable.end(), table.begin()));
 }
 
+TEST_F(TestFileTable, ValidateLiveFileTable)
+{
+    FileTable tableObj(fileTableConfig.c_str());
+
+    // Grow NVRAM-IMAGE from 1K to 2K bytes, the file size of handle 0
+    // follows the <4 bytes handle><2 bytes name length><11 bytes name>
+    std::ofstream(imageFile, std::ios::app) << std::string(1024, '\0');
+    auto table = tableObj();
+    uint32_t fileSize{};
+    memcpy(&fileSize, table.data() + 17, sizeof(fileSize));
+    ASSERT_EQ(fileSize, 2048);
+    uint32_t checkSum{};
+    memcpy(&checkSum, table.data() + table.size() - sizeof(checkSum),
+           sizeof(checkSum));
+    ASSERT_EQ(checkSum, crc32(table.data(), table.size() - sizeof(checkSum)));
+
+    // Removing NVRAM-IMAGE drops its entry, the handle of NVRAM-IMAGE-CKSUM
+    // the host has cached doesn't move
+    fs::remove(imageFile);
+    ASSERT_THROW(tableObj.at(0), std::out_of_range);
+    auto value = tableObj.at(1);
+    ASSERT_EQ(value.handle, 1);
+    ASSERT_EQ(strcmp(value.fsPath.c_str(), cksumFile.c_str()), 0);
+    table = tableObj();
+    uint32_t handle{};
+    memcpy(&handle, table.data(), sizeof(handle));
+    ASSERT_EQ(handle, 1);
+
+    // NVRAM-IMAGE coming back takes its own handle again
+    std::ofstream(imageFile) << std::string(1024, '\0');
+    value = tableObj.at(0);
+    ASSERT_EQ(strcmp(value.fsPath.c_str(), imageFile.c_str()), 0);
+    ASSERT_EQ(tableObj.at(1).handle, 1);
+}
+
+TEST_F(TestFileTable, ValidateMissingDirectory)
+{
+    // The directory of the second file doesn't exist yet
+    auto lidDir = dir / "lid" / "staging";
+    auto lidFile = lidDir / "LID";
+    auto jsonObjects = Json::array();
+    jsonObjects.push_back({{"path", imageFile.c_str()}, {"file_traits", 1}});
+    jsonObjects.push_back({{"path", lidFile.c_str()}, {"file_traits", 4}});
+    std::ofstream(fileTableConfig.c_str()) << jsonObjects;
+
+    FileTable tableObj(fileTableConfig.c_str());
+    ASSERT_THROW(tableObj.at(1), std::out_of_range);
+
+    fs::create_directories(lidDir);
+    std::ofstream(lidFile) << "LID";
+    auto value = tableObj.at(1);
+    ASSERT_EQ(strcmp(value.fsPath.c_str(), lidFile.c_str()), 0);
+
+    // The size of the file is followed in the new directory too
+    std::ofstream(lidFile, std::ios::app) << "LID";
+    auto table = tableObj();
+    // <4 bytes handle><2 bytes name length><11 bytes name><4 bytes size>
+    // <4 bytes traits><4 bytes handle><2 bytes name length><3 bytes name>
+    uint32_t fileSize{};
+    memcpy(&fileSize, table.data() + 34, sizeof(fileSize));
+    ASSERT_EQ(fileSize, 6);
+}
+
 TEST_F(TestFileTable, GetFileTableCommand)
 {
     // Initialise the file table with a valid handle of 0 & 1
@@ -905,3 +971,82 @@ TEST(readFileByType, testReadFile)
     ASSERT_EQ(response.size(), in.size());
     ASSERT_EQ(std::equal(in.begin(), in.end(), response.begin()), true);
 }
+
+TEST(LidIndex, invalidateOnChange)
+{
+    char tmplt[] = "/tmp/pldm_lid_index.XXXXXX";
+    fs::path dir(mkdtemp(tmplt));
+    LidDirs dirs{dir / "running", dir / "alternate", dir / "running_patch",
+                 dir / "alternate_patch"};
+    fs::create_directory(dirs[0]);
+    fs::create_directory(dirs[1]);
+
+    auto event = sdeventplus::Event::get_new();
+    LidIndex lidIndex(event, dirs);
+    uint32_t lidId = 0x81e00100;
+    ASSERT_EQ(lidIndex.path(LidDir::Running, lidId),
+              (dirs[0] / "81e00100.lid").string());
+
+    // Not present yet, the absence is indexed
+    ASSERT_FALSE(lidIndex.fileSize(LidDir::Running, lidId).has_value());
+    ASSERT_FALSE(lidIndex.fileSize(LidDir::RunningPatch, lidId).has_value());
+
+    std::ofstream(lidIndex.path(LidDir::Running, lidId)) << "lid";
+    ASSERT_EQ(lidIndex.fileSize(LidDir::Running, lidId), 3);
+    ASSERT_FALSE(lidIndex.fileSize(LidDir::Alternate, lidId).has_value());
+
+    std::ofstream(lidIndex.path(LidDir::Running, lidId), std::ios::app)
+        << "data";
+    ASSERT_EQ(lidIndex.fileSize(LidDir::Running, lidId), 7);
+
+    // Replacing the directory drops its entries
+    fs::rename(dirs[0], dir / "old");
+    fs::rename(dirs[1], dirs[0]);
+    ASSERT_FALSE(lidIndex.fileSize(LidDir::Running, lidId).has_value());
+
+    fs::remove_all(dir);
+}
+
+TEST(CertExchange, csrReadToEnd)
+{
+    auto& certExchange = CertExchange::get();
+    uint32_t fileHandle = 0x1001;
+    ASSERT_EQ(certExchange.stageCsr(fileHandle, "csr\n"), 4);
+    ASSERT_EQ(certExchange.getState(fileHandle),
+              CertExchange::State::CsrStaged);
+
+    CertHandler handler(fileHandle, PLDM_FILE_TYPE_CERT_SIGNING_REQUEST);
+    Response response;
+    uint32_t length = 2;
+    ASSERT_EQ(handler.read(0, length, response, nullptr), PLDM_SUCCESS);
+    ASSERT_EQ(certExchange.getState(fileHandle),
+              CertExchange::State::CsrStaged);
+
+    // The CSR is dropped once read to its end
+    length = 100;
+    ASSERT_EQ(handler.read(2, length, response, nullptr), PLDM_SUCCESS);
+    ASSERT_EQ(length, 2);
+    ASSERT_EQ(std::string(response.begin(), response.end()), "csr\n");
+    ASSERT_EQ(certExchange.getState(fileHandle), CertExchange::State::CsrSent);
+    ASSERT_EQ(handler.read(0, length, response, nullptr), PLDM_ERROR);
+}
+
+TEST(CertExchange, clientCertWrite)
+{
+    auto& certExchange = CertExchange::get();
+    uint32_t fileHandle = 0x1002;
+    CertHandler handler(fileHandle, PLDM_FILE_TYPE_SIGNED_CERT);
+    uint32_t length = 2;
+    ASSERT_EQ(handler.write("ce", 0, length, nullptr), PLDM_ERROR);
+
+    ASSERT_EQ(handler.newFileAvailable(4), PLDM_SUCCESS);
+    ASSERT_EQ(certExchange.getState(fileHandle),
+              CertExchange::State::CertReceiving);
+    ASSERT_EQ(handler.write("rt", 2, length, nullptr), PLDM_SUCCESS);
+    ASSERT_EQ(certExchange.getState(fileHandle),
+              CertExchange::State::CertReceiving);
+
+    // The exchange ends once the whole certificate is written
+    ASSERT_EQ(handler.write("ce", 0, length, nullptr), PLDM_SUCCESS);
+    ASSERT_FALSE(certExchange.getState(fileHandle).has_value());
+}
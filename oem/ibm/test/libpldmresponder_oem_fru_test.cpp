@@ -0,0 +1,161 @@
+#include "common/test/mocked_utils.hpp"
+#include "common/utils.hpp"
+#include "oem/ibm/libpldmresponder/fru_oem_ibm.hpp"
+
+#include <libpldm/entity.h>
+#include <libpldm/pdr.h>
+
+#include <cstring>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+using namespace pldm::responder;
+using ::testing::_;
+using ::testing::Return;
+using ::testing::ReturnRef;
+using ::testing::SaveArg;
+using ::testing::StrEq;
+
+namespace
+{
+
+constexpr auto inventoryService = "xyz.openbmc_project.Inventory.Manager";
+constexpr auto pcieDeviceInterface =
+    "xyz.openbmc_project.Inventory.Item.PCIeDevice";
+constexpr auto cardPath =
+    "/xyz/openbmc_project/inventory/system/chassis/motherboard/pcie_card4";
+
+} // namespace
+
+class MockOemFruHandler : public oem_ibm_fru::Handler
+{
+  public:
+    MockOemFruHandler(const DBusHandler* dBusIntf, pldm_pdr* repo) :
+        oem_ibm_fru::Handler(dBusIntf, repo)
+    {}
+
+    MOCK_METHOD((const AssociatedEntityMap&), getAssociateEntityMap, (),
+                (override));
+    MOCK_METHOD(bool, updateHostedObject,
+                (const std::string&, const InterfaceMap&), (override));
+    MOCK_METHOD(void, notifyInventoryManager,
+                (const std::string&, const ObjectValueTree&), (override));
+
+    using oem_ibm_fru::Handler::publishInventoryProperties;
+};
+
+TEST(OemFruHandler, processOEMFRUTable)
+{
+    auto repo = pldm_pdr_init();
+    uint32_t recordHandle = 0;
+    ASSERT_EQ(pldm_pdr_add_fru_record_set_check(repo, 1, 3, PLDM_ENTITY_CARD,
+                                                4, 2, &recordHandle),
+              0);
+
+    AssociatedEntityMap entityMap{{cardPath, {PLDM_ENTITY_CARD, 4, 2}}};
+    MockdBusHandler dbusHandler;
+    MockOemFruHandler handler(&dbusHandler, repo);
+    EXPECT_CALL(handler, getAssociateEntityMap())
+        .WillRepeatedly(ReturnRef(entityMap));
+    EXPECT_CALL(handler, updateHostedObject(cardPath, _))
+        .WillRepeatedly(Return(false));
+    EXPECT_CALL(dbusHandler,
+                getService(StrEq(cardPath), StrEq(pcieDeviceInterface)))
+        .WillRepeatedly(Return(inventoryService));
+    EXPECT_CALL(dbusHandler, getService(StrEq(inventoryPath), _))
+        .WillRepeatedly(Return(inventoryService));
+
+    oem_ibm_fru::PcieConfigSpaceData pcieData{};
+    pcieData.vendorId = 0x1014;
+    pcieData.deviceId = 0x034a;
+    pcieData.subSystemId = 0x0637;
+
+    // Record set 3, one PCIe config space data field
+    std::vector<uint8_t> fruData{0x03, 0x00, PLDM_FRU_RECORD_TYPE_OEM, 1, 1,
+                                 PLDM_OEM_FRU_FIELD_TYPE_PCIE_CONFIG_SPACE_DATA,
+                                 sizeof(pcieData)};
+    fruData.resize(fruData.size() + sizeof(pcieData));
+    std::memcpy(fruData.data() + fruData.size() - sizeof(pcieData), &pcieData,
+                sizeof(pcieData));
+
+    ObjectValueTree objects;
+    EXPECT_CALL(handler, notifyInventoryManager(inventoryService, _))
+        .WillOnce(SaveArg<1>(&objects));
+    EXPECT_EQ(handler.processOEMFRUTable(fruData), PLDM_SUCCESS);
+
+    ASSERT_EQ(objects.size(), 1);
+    const auto& properties =
+        objects.at(sdbusplus::message::object_path(cardPath))
+            .at(pcieDeviceInterface);
+    EXPECT_EQ(std::get<std::string>(properties.at("Function0VendorId")),
+              "0x1014");
+    EXPECT_EQ(std::get<std::string>(properties.at("Function0DeviceId")),
+              "0x034a");
+    EXPECT_EQ(std::get<std::string>(properties.at("Function0SubsystemId")),
+              "0x0637");
+
+    // A truncated field fails the table, what was decoded is still published
+    auto truncated = fruData;
+    truncated.insert(truncated.end(), {0x03, 0x00, PLDM_FRU_RECORD_TYPE_OEM,
+                                       1, 1, 0xfe, 0x10, 0x00});
+    EXPECT_CALL(handler, notifyInventoryManager(inventoryService, _)).Times(1);
+    EXPECT_EQ(handler.processOEMFRUTable(truncated), PLDM_ERROR_INVALID_DATA);
+
+    pldm_pdr_destroy(repo);
+}
+
+TEST(OemFruHandler, publishInventoryProperties)
+{
+    constexpr auto hostedPath =
+        "/xyz/openbmc_project/inventory/system/chassis/motherboard/pcie_card0";
+    constexpr auto otherPath =
+        "/xyz/openbmc_project/inventory/system/chassis/motherboard/pcie_card8";
+
+    PropertyMap pcieProperties{{"Function0VendorId", std::string("0x1014")}};
+    ObjectValueTree objects;
+    for (const auto& path : {hostedPath, cardPath, otherPath})
+    {
+        objects[sdbusplus::message::object_path(path)][pcieDeviceInterface] =
+            pcieProperties;
+    }
+
+    MockdBusHandler dbusHandler;
+    MockOemFruHandler handler(&dbusHandler, nullptr);
+
+    // The objects pldm hosts are updated in place, without a mapper lookup
+    EXPECT_CALL(handler, updateHostedObject(hostedPath, _))
+        .WillOnce(Return(true));
+    EXPECT_CALL(handler, updateHostedObject(cardPath, _))
+        .WillOnce(Return(false));
+    EXPECT_CALL(handler, updateHostedObject(otherPath, _))
+        .WillOnce(Return(false));
+    EXPECT_CALL(dbusHandler, getService(StrEq(hostedPath), _)).Times(0);
+    EXPECT_CALL(dbusHandler,
+                getService(StrEq(cardPath), StrEq(pcieDeviceInterface)))
+        .WillOnce(Return(inventoryService));
+    EXPECT_CALL(dbusHandler,
+                getService(StrEq(otherPath), StrEq(pcieDeviceInterface)))
+        .WillOnce(Return("xyz.openbmc_project.Inventory.Other"));
+    EXPECT_CALL(dbusHandler, getService(StrEq(inventoryPath), _))
+        .WillOnce(Return(inventoryService));
+
+    // Only the objects of the inventory manager are sent to it
+    ObjectValueTree notified;
+    EXPECT_CALL(handler, notifyInventoryManager(inventoryService, _))
+        .WillOnce(SaveArg<1>(&notified));
+
+    // The objects of the other services are set property by property
+    DBusMapping otherMapping{otherPath, pcieDeviceInterface,
+                             "Function0VendorId", "string"};
+    EXPECT_CALL(dbusHandler,
+                setDbusProperty(otherMapping,
+                                PropertyValue(std::string("0x1014"))))
+        .Times(1);
+
+    handler.publishInventoryProperties(objects);
+
+    ASSERT_EQ(notified.size(), 1);
+    EXPECT_TRUE(notified.contains(sdbusplus::message::object_path(cardPath)));
+}
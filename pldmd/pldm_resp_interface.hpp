@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/flight_recorder.hpp"
+#include "common/message_tracer.hpp"
 #include "common/transport.hpp"
 #include "common/utils.hpp"
 
@@ -50,7 +51,8 @@ class AltResponse
         FlightRecorder::GetInstance().saveRecord(response, true);
         if (verbose)
         {
-            printBuffer(Tx, response);
+            pldm::tracing::MessageTracer::GetInstance().record(TID, Tx,
+                                                               response);
         }
 
         int rc =
@@ -1,6 +1,7 @@
 
 #include "common/flight_recorder.hpp"
 #include "common/instance_id.hpp"
+#include "common/message_tracer.hpp"
 #include "common/transport.hpp"
 #include "common/utils.hpp"
 #include "dbus_impl_requester.hpp"
@@ -11,6 +12,7 @@
 #include "requester/handler.hpp"
 #include "requester/mctp_endpoint_discovery.hpp"
 #include "requester/request.hpp"
+#include "requester/request_proxy.hpp"
 
 #include <err.h>
 #include <getopt.h>
@@ -42,6 +44,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -59,6 +62,7 @@ PHOSPHOR_LOG2_USING;
 #include "libpldmresponder/oem_handler.hpp"
 #include "libpldmresponder/platform.hpp"
 #include "libpldmresponder/platform_config.hpp"
+#include "libpldmresponder/sensor_event_emitter.hpp"
 #include "xyz/openbmc_project/PLDM/Event/server.hpp"
 #endif
 
@@ -77,6 +81,7 @@ using namespace pldm::responder;
 using namespace pldm::utils;
 using sdeventplus::source::Signal;
 using namespace pldm::flightrecorder;
+using namespace pldm::tracing;
 
 void interruptFlightRecorderCallBack(Signal& /*signal*/,
                                      const struct signalfd_siginfo*)
@@ -84,6 +89,21 @@ void interruptFlightRecorderCallBack(Signal& /*signal*/,
     error("Received SIGUR1(10) Signal interrupt");
     // obtain the flight recorder instance and dump the recorder
     FlightRecorder::GetInstance().playRecorder();
+
+#ifdef LIBPLDMRESPONDER
+    const auto& counters = StateSensorEventEmitter::GetInstance().getCounters();
+    info(
+        "StateSensorEvent signals: queue depth {DEPTH}, max queue depth {MAX_DEPTH}, batches {BATCHES}, emitted {EMITTED}, dropped {DROPPED}",
+        "DEPTH", counters.queueDepth, "MAX_DEPTH", counters.maxQueueDepth,
+        "BATCHES", counters.batches, "EMITTED", counters.emitted, "DROPPED",
+        counters.dropped);
+#endif
+
+    auto traceCounters = MessageTracer::GetInstance().getCounters();
+    info(
+        "PLDM message trace: recorded {RECORDED}, dropped {DROPPED}, recording time {RECORD_TIME} ns",
+        "RECORDED", traceCounters.recorded, "DROPPED", traceCounters.dropped,
+        "RECORD_TIME", traceCounters.recordTime);
 }
 
 void requestPLDMServiceName()
@@ -161,7 +181,9 @@ void optionUsage(void)
 {
     info("Usage: pldmd [options]");
     info("Options:");
-    info(" [--verbose] - would enable verbosity");
+    info(
+        " [--verbose] - would enable verbosity, tracing the PLDM messages into {TRACE_PATH}",
+        "TRACE_PATH", messageTracePath);
 }
 
 int main(int argc, char** argv)
@@ -182,6 +204,11 @@ int main(int argc, char** argv)
             optionUsage();
             exit(EXIT_FAILURE);
     }
+    if (verbose)
+    {
+        MessageTracer::GetInstance().start(messageTracePath);
+    }
+
     // Setup PLDM requester transport
     auto hostEID = pldm::utils::readHostEID();
     /* To maintain current behaviour until we have the infrastructure to find
@@ -208,6 +235,8 @@ int main(int argc, char** argv)
     pldm::response_api::ResponseInterface respInterface;
 #ifdef LIBPLDMRESPONDER
     using namespace pldm::state_sensor;
+    StateSensorEventEmitter::GetInstance().start(
+        event, std::chrono::milliseconds(SENSOR_EVENT_SIGNAL_BATCH_WINDOW));
     dbus_api::Host dbusImplHost(bus, "/xyz/openbmc_project/pldm");
     std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo(
         pldm_pdr_init(), pldm_pdr_destroy);
@@ -259,7 +288,8 @@ int main(int argc, char** argv)
         &dbusHandler, codeUpdate.get(), pldmTransport.getEventSource(), hostEID,
         instanceIdDb, event, pdrRepo.get(), &reqHandler, bmcEntityTree.get());
     codeUpdate->setOemPlatformHandler(oemPlatformHandler.get());
-    oemFruHandler = std::make_unique<oem_ibm_fru::Handler>(pdrRepo.get());
+    oemFruHandler = std::make_unique<oem_ibm_fru::Handler>(&dbusHandler,
+                                                           pdrRepo.get());
 
     invoker.registerHandler(PLDM_OEM, std::make_unique<oem_ibm::Handler>(
                                           oemPlatformHandler.get(),
@@ -361,7 +391,7 @@ int main(int argc, char** argv)
             FlightRecorder::GetInstance().saveRecord(requestMsgVec, false);
             if (verbose)
             {
-                printBuffer(Rx, requestMsgVec);
+                MessageTracer::GetInstance().record(TID, Rx, requestMsgVec);
             }
             // process message and send response
             auto response = processRxMsg(requestMsgVec, invoker, reqHandler,
@@ -373,7 +403,8 @@ int main(int argc, char** argv)
                     FlightRecorder::GetInstance().saveRecord(*response, true);
                     if (verbose)
                     {
-                        printBuffer(Tx, *response);
+                        MessageTracer::GetInstance().record(TID, Tx,
+                                                            *response);
                     }
 
                     returnCode = pldmTransport.sendMsg(TID, (*response).data(),
@@ -428,6 +459,20 @@ int main(int argc, char** argv)
     {
         hostPDRHandler->setHostFirmwareCondition();
     }
+#endif
+#ifdef REQUEST_PROXY_SOCKET_PATH
+    std::unique_ptr<requester::RequestProxy<requester::Request>> requestProxy;
+    try
+    {
+        requestProxy =
+            std::make_unique<requester::RequestProxy<requester::Request>>(
+                event, instanceIdDb, reqHandler, REQUEST_PROXY_SOCKET_PATH);
+    }
+    catch (const std::system_error& e)
+    {
+        error("Failed to start the request proxy, error - {ERROR}", "ERROR",
+              e);
+    }
 #endif
     stdplus::signal::block(SIGUSR1);
     sdeventplus::source::Signal sigUsr1(
@@ -4,11 +4,21 @@
 #include "common/utils.hpp"
 #include "pldm_cmd_helper.hpp"
 
+#include <fcntl.h>
 #include <libpldm/bios_table.h>
 #include <libpldm/utils.h>
-
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <map>
 #include <optional>
+#include <span>
 
 namespace pldmtool
 {
@@ -31,6 +41,169 @@ const std::map<const char*, pldm_bios_table_types> pldmBIOSTableTypes{
     {"AttributeValueTable", PLDM_BIOS_ATTR_VAL_TABLE},
 };
 
+/** @brief Directory of the cache files, private to the user running pldmtool
+ */
+constexpr auto biosTableCacheDir = "/run/pldmtool";
+
+/** @brief Prefix of the cache file of the string and attribute tables of an
+ *         MCTP endpoint, suffixed by its EID
+ */
+constexpr auto biosTableCacheName = "bios_tables_";
+
+/** @brief Age the cached tables are fetched again at, bounding the window a
+ *         table change can go unnoticed in when the changed attribute keeps
+ *         its handle and type
+ */
+constexpr std::chrono::minutes biosTableCacheLifetime{10};
+
+constexpr std::array<char, 8> biosTableCacheMagic{'P', 'L', 'D', 'M',
+                                                  'B', 'I', 'O', 'S'};
+
+using Table = std::vector<uint8_t>;
+
+void appendTable(std::vector<uint8_t>& buffer, const Table& table)
+{
+    uint32_t size = table.size();
+    auto sizeBytes = reinterpret_cast<const uint8_t*>(&size);
+    buffer.insert(buffer.end(), sizeBytes, sizeBytes + sizeof(size));
+    buffer.insert(buffer.end(), table.begin(), table.end());
+}
+
+std::optional<Table> extractTable(std::span<const uint8_t>& buffer)
+{
+    uint32_t size = 0;
+    if (buffer.size() < sizeof(size))
+    {
+        return std::nullopt;
+    }
+    std::memcpy(&size, buffer.data(), sizeof(size));
+    buffer = buffer.subspan(sizeof(size));
+    if (buffer.size() < size)
+    {
+        return std::nullopt;
+    }
+    Table table(buffer.begin(), buffer.begin() + size);
+    buffer = buffer.subspan(size);
+    return table;
+}
+
+/** @brief Check that a cache file or directory is owned by the user running
+ *         pldmtool and can't be written by anyone else
+ */
+bool isPrivate(const struct stat& st)
+{
+    return st.st_uid == geteuid() && !(st.st_mode & (S_IWGRP | S_IWOTH));
+}
+
+/** @brief Get the cache directory, created if missing
+ *
+ *  @return the directory, std::nullopt if it is not private
+ */
+std::optional<std::filesystem::path> getBIOSTableCacheDir()
+{
+    if (mkdir(biosTableCacheDir, S_IRWXU) && errno != EEXIST)
+    {
+        return std::nullopt;
+    }
+
+    struct stat st{};
+    if (lstat(biosTableCacheDir, &st) || !S_ISDIR(st.st_mode) ||
+        !isPrivate(st))
+    {
+        return std::nullopt;
+    }
+    return biosTableCacheDir;
+}
+
+/** @brief Read the string and attribute tables from a cache file, the file
+ *         ends with the CRC32 of its content
+ *
+ *  @return the string and attribute tables, std::nullopt if the cache file is
+ *          missing, expired, corrupted or not private
+ */
+std::optional<std::pair<Table, Table>>
+    readBIOSTableCache(const std::filesystem::path& cachePath)
+{
+    int fd = open(cachePath.c_str(), O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd == -1)
+    {
+        return std::nullopt;
+    }
+
+    struct stat st{};
+    std::vector<uint8_t> buffer;
+    if (!fstat(fd, &st) && S_ISREG(st.st_mode) && isPrivate(st) &&
+        std::chrono::system_clock::now() -
+                std::chrono::system_clock::from_time_t(st.st_mtime) <=
+            biosTableCacheLifetime)
+    {
+        buffer.resize(st.st_size);
+        auto rc = read(fd, buffer.data(), buffer.size());
+        buffer.resize(std::max<ssize_t>(rc, 0));
+    }
+    close(fd);
+
+    uint32_t checksum = 0;
+    if (buffer.size() < biosTableCacheMagic.size() + sizeof(checksum) ||
+        !std::equal(biosTableCacheMagic.begin(), biosTableCacheMagic.end(),
+                    buffer.begin()))
+    {
+        return std::nullopt;
+    }
+
+    auto contentSize = buffer.size() - sizeof(checksum);
+    std::memcpy(&checksum, buffer.data() + contentSize, sizeof(checksum));
+    if (checksum != crc32(buffer.data(), contentSize))
+    {
+        return std::nullopt;
+    }
+
+    std::span<const uint8_t> content(buffer.data(), contentSize);
+    content = content.subspan(biosTableCacheMagic.size());
+    auto stringTable = extractTable(content);
+    auto attrTable = extractTable(content);
+    if (!stringTable || !attrTable || !content.empty())
+    {
+        return std::nullopt;
+    }
+    return std::make_pair(std::move(*stringTable), std::move(*attrTable));
+}
+
+/** @brief Write the string and attribute tables to a cache file, replacing
+ *         it atomically
+ */
+void writeBIOSTableCache(const std::filesystem::path& cachePath,
+                         const Table& stringTable, const Table& attrTable)
+{
+    std::vector<uint8_t> buffer(biosTableCacheMagic.begin(),
+                                biosTableCacheMagic.end());
+    appendTable(buffer, stringTable);
+    appendTable(buffer, attrTable);
+    uint32_t checksum = crc32(buffer.data(), buffer.size());
+    auto checksumBytes = reinterpret_cast<const uint8_t*>(&checksum);
+    buffer.insert(buffer.end(), checksumBytes,
+                  checksumBytes + sizeof(checksum));
+
+    auto tempPath = std::filesystem::path(cachePath).concat(
+        "." + std::to_string(getpid()));
+    std::error_code ec;
+    {
+        std::ofstream cacheFile(tempPath, std::ios::binary | std::ios::trunc);
+        std::filesystem::permissions(tempPath,
+                                     std::filesystem::perms::owner_read |
+                                         std::filesystem::perms::owner_write,
+                                     ec);
+        cacheFile.write(reinterpret_cast<const char*>(buffer.data()),
+                        buffer.size());
+        if (!cacheFile)
+        {
+            std::filesystem::remove(tempPath, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, cachePath, ec);
+}
+
 } // namespace
 
 class GetDateTime : public CommandInterface
@@ -239,6 +412,131 @@ class GetBIOSTableHandler : public CommandInterface
         return std::make_optional<Table>(tableData, tableData + tableSize);
     }
 
+    /** @brief String and attribute tables, the tables the attribute names are
+     *         resolved with
+     */
+    struct NameTables
+    {
+        Table stringTable;
+        Table attrTable;
+        bool cached; //!< read from the local cache
+    };
+
+    /** @brief Get the string and attribute tables, from the local cache of
+     *         the MCTP endpoint unless refreshing it. The tables fetched are
+     *         written to the cache.
+     *
+     *  A cached table can be stale, a command reading an attribute through it
+     *  checks the attribute against the attribute value exchanged with the
+     *  endpoint and refreshes the cache on a mismatch. A command setting an
+     *  attribute always refreshes the cache, the value it encodes depends on
+     *  the whole attribute entry.
+     *
+     *  @param[in] refresh - fetch the tables from the endpoint
+     *
+     *  @return the tables, std::nullopt if they are unavailable
+     */
+    std::optional<NameTables> getNameTables(bool refresh)
+    {
+        auto cacheDir = getBIOSTableCacheDir();
+        std::filesystem::path cachePath;
+        if (cacheDir)
+        {
+            cachePath = *cacheDir /
+                        (biosTableCacheName + std::to_string(getMCTPEID()));
+        }
+        if (cacheDir && !refresh)
+        {
+            if (auto tables = readBIOSTableCache(cachePath))
+            {
+                return NameTables{std::move(tables->first),
+                                  std::move(tables->second), true};
+            }
+        }
+
+        auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
+        auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+        if (!stringTable || !attrTable)
+        {
+            if (cacheDir)
+            {
+                std::error_code ec;
+                std::filesystem::remove(cachePath, ec);
+            }
+            return std::nullopt;
+        }
+        if (cacheDir)
+        {
+            writeBIOSTableCache(cachePath, *stringTable, *attrTable);
+        }
+        return NameTables{std::move(*stringTable), std::move(*attrTable),
+                          false};
+    }
+
+    /** @brief Get the current value of an attribute
+     *
+     *  @param[in] handle - attribute handle
+     *
+     *  @return the attribute value table entry, std::nullopt on failure
+     */
+    std::optional<Table> getAttributeCurrentValue(uint16_t handle)
+    {
+        std::vector<uint8_t> requestMsg(
+            sizeof(pldm_msg_hdr) +
+            PLDM_GET_BIOS_ATTR_CURR_VAL_BY_HANDLE_REQ_BYTES);
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+
+        auto rc = encode_get_bios_attribute_current_value_by_handle_req(
+            instanceId, 0, PLDM_GET_FIRSTPART, handle, request);
+        if (rc != PLDM_SUCCESS)
+        {
+            std::cerr << "PLDM: Request Message Error, rc =" << rc << std::endl;
+            return std::nullopt;
+        }
+
+        std::vector<uint8_t> responseMsg;
+        rc = pldmSendRecv(requestMsg, responseMsg);
+        if (rc != PLDM_SUCCESS)
+        {
+            std::cerr << "PLDM: Communication Error, rc =" << rc << std::endl;
+            return std::nullopt;
+        }
+
+        uint8_t cc = 0, transferFlag = 0;
+        uint32_t nextTransferHandle = 0;
+        struct variable_field attributeData;
+        auto responsePtr =
+            reinterpret_cast<struct pldm_msg*>(responseMsg.data());
+        auto payloadLength = responseMsg.size() - sizeof(pldm_msg_hdr);
+
+        rc = decode_get_bios_attribute_current_value_by_handle_resp(
+            responsePtr, payloadLength, &cc, &nextTransferHandle, &transferFlag,
+            &attributeData);
+        if (rc != PLDM_SUCCESS || cc != PLDM_SUCCESS ||
+            attributeData.length < sizeof(pldm_bios_attr_val_table_entry))
+        {
+            std::cerr << "Response Message Error: "
+                      << "rc=" << rc << ",cc=" << (int)cc << std::endl;
+            return std::nullopt;
+        }
+
+        return std::make_optional<Table>(
+            attributeData.ptr, attributeData.ptr + attributeData.length);
+    }
+
+    /** @brief Check an attribute value entry against the attribute it was
+     *         resolved from
+     */
+    static bool isValueOf(const Table& attrValueEntry,
+                          const pldm_bios_attr_table_entry* attrEntry)
+    {
+        auto valueEntry =
+            reinterpret_cast<const struct pldm_bios_attr_val_table_entry*>(
+                attrValueEntry.data());
+        return valueEntry->attr_handle == attrEntry->attr_handle &&
+               valueEntry->attr_type == attrEntry->attr_type;
+    }
+
     const pldm_bios_attr_table_entry*
         findAttrEntryByName(const std::string& name, const Table& attrTable,
                             const Table& stringTable)
@@ -693,68 +991,52 @@ class GetBIOSAttributeCurrentValueByHandle : public GetBIOSTableHandler
 
     void exec()
     {
-        auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-        auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-
-        if (!stringTable || !attrTable)
-        {
-            std::cout << "StringTable/AttrTable Unavaliable" << std::endl;
-            return;
-        }
-
-        auto handle = findAttrHandleByName(attrName, *attrTable, *stringTable);
-        if (!handle)
+        // A stale cache is refreshed and the attribute resolved again
+        for (bool refresh : {false, true})
         {
-            std::cerr << "Can not find the attribute " << attrName << std::endl;
-            return;
-        }
-
-        std::vector<uint8_t> requestMsg(
-            sizeof(pldm_msg_hdr) +
-            PLDM_GET_BIOS_ATTR_CURR_VAL_BY_HANDLE_REQ_BYTES);
-        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+            auto tables = getNameTables(refresh);
+            if (!tables)
+            {
+                std::cout << "StringTable/AttrTable Unavaliable" << std::endl;
+                return;
+            }
 
-        auto rc = encode_get_bios_attribute_current_value_by_handle_req(
-            instanceId, 0, PLDM_GET_FIRSTPART, *handle, request);
-        if (rc != PLDM_SUCCESS)
-        {
-            std::cerr << "PLDM: Request Message Error, rc =" << rc << std::endl;
-            return;
-        }
+            auto attrEntry = findAttrEntryByName(attrName, tables->attrTable,
+                                                 tables->stringTable);
+            if (attrEntry == nullptr)
+            {
+                if (tables->cached)
+                {
+                    continue;
+                }
+                std::cerr << "Can not find the attribute " << attrName
+                          << std::endl;
+                return;
+            }
 
-        std::vector<uint8_t> responseMsg;
-        rc = pldmSendRecv(requestMsg, responseMsg);
-        if (rc != PLDM_SUCCESS)
-        {
-            std::cerr << "PLDM: Communication Error, rc =" << rc << std::endl;
-            return;
-        }
+            auto attrValueEntry = getAttributeCurrentValue(
+                pldm_bios_table_attr_entry_decode_attribute_handle(attrEntry));
+            if (!attrValueEntry)
+            {
+                return;
+            }
+            if (tables->cached && !isValueOf(*attrValueEntry, attrEntry))
+            {
+                continue;
+            }
 
-        uint8_t cc = 0, transferFlag = 0;
-        uint32_t nextTransferHandle = 0;
-        struct variable_field attributeData;
-        auto responsePtr =
-            reinterpret_cast<struct pldm_msg*>(responseMsg.data());
-        auto payloadLength = responseMsg.size() - sizeof(pldm_msg_hdr);
+            auto tableEntry =
+                reinterpret_cast<const struct pldm_bios_attr_val_table_entry*>(
+                    attrValueEntry->data());
 
-        rc = decode_get_bios_attribute_current_value_by_handle_resp(
-            responsePtr, payloadLength, &cc, &nextTransferHandle, &transferFlag,
-            &attributeData);
-        if (rc != PLDM_SUCCESS || cc != PLDM_SUCCESS)
-        {
-            std::cerr << "Response Message Error: "
-                      << "rc=" << rc << ",cc=" << (int)cc << std::endl;
+            ordered_json avdata;
+            displayAttributeValueEntry(
+                tableEntry, std::make_optional(std::move(tables->attrTable)),
+                std::make_optional(std::move(tables->stringTable)), false,
+                avdata);
+            pldmtool::helper::DisplayInJson(avdata);
             return;
         }
-
-        auto tableEntry =
-            reinterpret_cast<const struct pldm_bios_attr_val_table_entry*>(
-                attributeData.ptr);
-
-        ordered_json avdata;
-        displayAttributeValueEntry(tableEntry, attrTable, stringTable, false,
-                                   avdata);
-        pldmtool::helper::DisplayInJson(avdata);
     }
 
   private:
@@ -786,24 +1068,35 @@ class SetBIOSAttributeCurrentValue : public GetBIOSTableHandler
 
     void exec()
     {
-        auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-        auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-        auto attrValueTable = getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
-
-        if (!stringTable || !attrTable)
+        // The tables the value is encoded with are fetched afresh, the cached
+        // ones may be stale
+        auto tables = getNameTables(true);
+        if (!tables)
         {
             std::cout << "StringTable/AttrTable Unavaliable" << std::endl;
             return;
         }
 
-        auto attrEntry = findAttrEntryByName(attrName, *attrTable,
-                                             *stringTable);
+        auto attrEntry = findAttrEntryByName(attrName, tables->attrTable,
+                                             tables->stringTable);
         if (attrEntry == nullptr)
         {
             std::cout << "Could not find attribute :" << attrName << std::endl;
             return;
         }
 
+        setAttributeCurrentValue(attrEntry, tables->stringTable);
+    }
+
+  private:
+    /** @brief Set the current value of an attribute
+     *
+     *  @param[in] attrEntry - attribute table entry of the attribute
+     *  @param[in] stringTable - string table
+     */
+    void setAttributeCurrentValue(const pldm_bios_attr_table_entry* attrEntry,
+                                  const Table& stringTable)
+    {
         std::vector<uint8_t> requestMsg;
 
         int rc = 0;
@@ -827,8 +1120,7 @@ class SetBIOSAttributeCurrentValue : public GetBIOSTableHandler
                 pldm_bios_table_attr_entry_enum_decode_pv_hdls_check(
                     attrEntry, pvHdls.data(), pvNum);
                 auto stringEntry = pldm_bios_table_string_find_by_string(
-                    stringTable->data(), stringTable->size(),
-                    attrValue.c_str());
+                    stringTable.data(), stringTable.size(), attrValue.c_str());
                 if (stringEntry == nullptr)
                 {
                     std::cout
@@ -950,7 +1242,6 @@ class SetBIOSAttributeCurrentValue : public GetBIOSTableHandler
         pldmtool::helper::DisplayInJson(data);
     }
 
-  private:
     std::string attrName;
     std::string attrValue;
 };
@@ -7,11 +7,18 @@
 #include <libpldm/transport/af-mctp.h>
 #include <libpldm/transport/mctp-demux.h>
 #include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include <systemd/sd-bus.h>
+#include <unistd.h>
 
 #include <sdbusplus/server.hpp>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
 #include <exception>
 
 using namespace pldm::utils;
@@ -21,13 +28,114 @@ namespace pldmtool
 namespace helper
 {
 
+#ifdef REQUEST_PROXY_SOCKET_PATH
+namespace
+{
+
+/** @brief Number of instance IDs of an endpoint, pldmd holds one for each
+ *         request it has queued to the endpoint
+ */
+constexpr auto instanceIdCount = 32;
+
+/** @brief Longest time pldmd takes to answer a request to an endpoint, once
+ *         it is sent. The request is answered within the instance ID
+ *         expiration interval, or once its retries are exhausted.
+ */
+constexpr auto requestTimeout = std::max<std::chrono::milliseconds>(
+    std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL),
+    std::chrono::milliseconds(RESPONSE_TIME_OUT) *
+        (NUMBER_OF_REQUEST_RETRIES + 1));
+
+/** @brief Longest time pldmd takes to answer a proxied request, which can
+ *         be queued behind a request for each other instance ID of the
+ *         endpoint
+ */
+constexpr auto proxyTimeout = requestTimeout * instanceIdCount;
+
+/** @brief Send a request through the request proxy of pldmd. pldmd stamps
+ *         the request with an instance ID of its own and answers once the
+ *         request is completed, has failed or its instance ID has expired.
+ *         The answer is waited for till proxyTimeout, the request is failed
+ *         rather than sent again on the transport past it, pldmd may still
+ *         have it queued. The socket is hung up if pldmd exits meanwhile.
+ *
+ *  @param[in] eid - remote MCTP endpoint
+ *  @param[in] requestMsg - PLDM request message
+ *  @param[out] responseMsg - PLDM response message
+ *
+ *  @return PLDM_REQUESTER_OPEN_FAIL if pldmd cannot be reached, which leaves
+ *          the request to the transport, PLDM_REQUESTER_SUCCESS or another
+ *          pldm_requester_rc_t error otherwise
+ */
+int proxySendRecv(uint8_t eid, const std::vector<uint8_t>& requestMsg,
+                  std::vector<uint8_t>& responseMsg)
+{
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return PLDM_REQUESTER_OPEN_FAIL;
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, REQUEST_PROXY_SOCKET_PATH,
+                 sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)))
+    {
+        close(fd);
+        return PLDM_REQUESTER_OPEN_FAIL;
+    }
+
+    std::vector<uint8_t> packet{eid};
+    packet.insert(packet.end(), requestMsg.begin(), requestMsg.end());
+    if (send(fd, packet.data(), packet.size(), MSG_NOSIGNAL) < 0)
+    {
+        close(fd);
+        return PLDM_REQUESTER_SEND_FAIL;
+    }
+
+    pollfd pfd{fd, POLLIN, 0};
+    int ready = 0;
+    do
+    {
+        ready = poll(&pfd, 1, proxyTimeout.count());
+    } while (ready < 0 && errno == EINTR);
+    if (ready == 0)
+    {
+        std::cerr << "pldmd did not answer the request within "
+                  << proxyTimeout.count() << " ms" << std::endl;
+    }
+    if (ready <= 0)
+    {
+        close(fd);
+        return PLDM_REQUESTER_RECV_FAIL;
+    }
+
+    auto size = recv(fd, nullptr, 0, MSG_PEEK | MSG_TRUNC);
+    if (size > 0)
+    {
+        packet.resize(size);
+        size = recv(fd, packet.data(), packet.size(), 0);
+    }
+    close(fd);
+    if (size <= static_cast<ssize_t>(sizeof(eid) + sizeof(pldm_msg_hdr)) ||
+        packet[0] != eid)
+    {
+        return PLDM_REQUESTER_RECV_FAIL;
+    }
+
+    responseMsg.assign(packet.begin() + sizeof(eid), packet.begin() + size);
+    return PLDM_REQUESTER_SUCCESS;
+}
+
+} // namespace
+#endif
+
 void CommandInterface::exec()
 {
-    instanceId = instanceIdDb.next(mctp_eid);
     auto [rc, requestMsg] = createRequestMsg();
     if (rc != PLDM_SUCCESS)
     {
-        instanceIdDb.free(mctp_eid, instanceId);
         std::cerr << "Failed to encode request message for " << pldmType << ":"
                   << commandName << " rc = " << rc << "\n";
         return;
@@ -38,14 +146,12 @@ void CommandInterface::exec()
 
     if (rc != PLDM_SUCCESS)
     {
-        instanceIdDb.free(mctp_eid, instanceId);
         std::cerr << "pldmSendRecv: Failed to receive RC = " << rc << "\n";
         return;
     }
 
     auto responsePtr = reinterpret_cast<struct pldm_msg*>(responseMsg.data());
     parseResponseMsg(responsePtr, responseMsg.size() - sizeof(pldm_msg_hdr));
-    instanceIdDb.free(mctp_eid, instanceId);
 }
 
 int CommandInterface::pldmSendRecv(std::vector<uint8_t>& requestMsg,
@@ -64,9 +170,36 @@ int CommandInterface::pldmSendRecv(std::vector<uint8_t>& requestMsg,
     }
 
     auto tid = mctp_eid;
+    int rc = PLDM_ERROR;
+
+#ifdef REQUEST_PROXY_SOCKET_PATH
+    // pldmd schedules the request along with its own ones when it is running,
+    // it does the retries as well
+    rc = proxySendRecv(tid, requestMsg, responseMsg);
+    if (rc != PLDM_REQUESTER_OPEN_FAIL)
+    {
+        if (rc)
+        {
+            std::cerr << "failed to pldm send recv through pldmd error rc "
+                      << rc << std::endl;
+        }
+        else if (pldmVerbose)
+        {
+            std::cout << "pldmtool: ";
+            printBuffer(Rx, responseMsg);
+        }
+        return rc;
+    }
+#endif
+
+    // Only the requests sent on the transport are given an instance ID here,
+    // pldmd stamps the proxied ones
+    instanceId = instanceIdDb.next(tid);
+    reinterpret_cast<pldm_msg_hdr*>(requestMsg.data())->instance_id =
+        instanceId;
+
     PldmTransport pldmTransport{};
     uint8_t retry = 0;
-    int rc = PLDM_ERROR;
 
     while (PLDM_REQUESTER_SUCCESS != rc && retry <= numRetries)
     {
@@ -100,6 +233,7 @@ int CommandInterface::pldmSendRecv(std::vector<uint8_t>& requestMsg,
     {
         std::cerr << "failed to pldm send recv error rc " << rc << std::endl;
     }
+    instanceIdDb.free(tid, instanceId);
 
     return rc;
 }
@@ -6,9 +6,15 @@
 #include <libpldm/state_set.h>
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstring>
+#include <fstream>
 #include <map>
 #include <ranges>
+#include <set>
+#include <span>
+#include <tuple>
 
 #ifdef OEM_IBM
 #include "oem/ibm/oem_ibm_state_set.hpp"
@@ -47,6 +53,48 @@ static const std::map<uint8_t, std::string> sensorOpState{
     {PLDM_SENSOR_SHUTTINGDOWN, "Sensor Shutting down"},
     {PLDM_SENSOR_INTEST, "Sensor Intest"}};
 
+static const std::map<uint8_t, std::string> pdrType = {
+    {PLDM_TERMINUS_LOCATOR_PDR, "Terminus Locator PDR"},
+    {PLDM_NUMERIC_SENSOR_PDR, "Numeric Sensor PDR"},
+    {PLDM_NUMERIC_SENSOR_INITIALIZATION_PDR,
+     "Numeric Sensor Initialization PDR"},
+    {PLDM_STATE_SENSOR_PDR, "State Sensor PDR"},
+    {PLDM_STATE_SENSOR_INITIALIZATION_PDR, "State Sensor Initialization PDR"},
+    {PLDM_SENSOR_AUXILIARY_NAMES_PDR, "Sensor Auxiliary Names PDR"},
+    {PLDM_OEM_UNIT_PDR, "OEM Unit PDR"},
+    {PLDM_OEM_STATE_SET_PDR, "OEM State Set PDR"},
+    {PLDM_NUMERIC_EFFECTER_PDR, "Numeric Effecter PDR"},
+    {PLDM_NUMERIC_EFFECTER_INITIALIZATION_PDR,
+     "Numeric Effecter Initialization PDR"},
+    {PLDM_COMPACT_NUMERIC_SENSOR_PDR, "Compact Numeric Sensor PDR"},
+    {PLDM_STATE_EFFECTER_PDR, "State Effecter PDR"},
+    {PLDM_STATE_EFFECTER_INITIALIZATION_PDR,
+     "State Effecter Initialization PDR"},
+    {PLDM_EFFECTER_AUXILIARY_NAMES_PDR, "Effecter Auxiliary Names PDR"},
+    {PLDM_EFFECTER_OEM_SEMANTIC_PDR, "Effecter OEM Semantic PDR"},
+    {PLDM_PDR_ENTITY_ASSOCIATION, "Entity Association PDR"},
+    {PLDM_ENTITY_AUXILIARY_NAMES_PDR, "Entity Auxiliary Names PDR"},
+    {PLDM_OEM_ENTITY_ID_PDR, "OEM Entity ID PDR"},
+    {PLDM_INTERRUPT_ASSOCIATION_PDR, "Interrupt Association PDR"},
+    {PLDM_EVENT_LOG_PDR, "PLDM Event Log PDR"},
+    {PLDM_PDR_FRU_RECORD_SET, "FRU Record Set PDR"},
+    {PLDM_OEM_DEVICE_PDR, "OEM Device PDR"},
+    {PLDM_OEM_PDR, "OEM PDR"},
+};
+
+std::string getPDRType(uint8_t type)
+{
+    auto typeString = std::to_string(type);
+    try
+    {
+        return pdrType.at(type);
+    }
+    catch (const std::out_of_range& e)
+    {
+        return typeString;
+    }
+}
+
 std::vector<std::unique_ptr<CommandInterface>> commands;
 
 } // namespace
@@ -479,36 +527,6 @@ class GetPDR : public CommandInterface
     const std::array<std::string_view, 4> effecterInit = {
         "noInit", "useInitPDR", "enableEffecter", "disableEffecter"};
 
-    const std::map<uint8_t, std::string> pdrType = {
-        {PLDM_TERMINUS_LOCATOR_PDR, "Terminus Locator PDR"},
-        {PLDM_NUMERIC_SENSOR_PDR, "Numeric Sensor PDR"},
-        {PLDM_NUMERIC_SENSOR_INITIALIZATION_PDR,
-         "Numeric Sensor Initialization PDR"},
-        {PLDM_STATE_SENSOR_PDR, "State Sensor PDR"},
-        {PLDM_STATE_SENSOR_INITIALIZATION_PDR,
-         "State Sensor Initialization PDR"},
-        {PLDM_SENSOR_AUXILIARY_NAMES_PDR, "Sensor Auxiliary Names PDR"},
-        {PLDM_OEM_UNIT_PDR, "OEM Unit PDR"},
-        {PLDM_OEM_STATE_SET_PDR, "OEM State Set PDR"},
-        {PLDM_NUMERIC_EFFECTER_PDR, "Numeric Effecter PDR"},
-        {PLDM_NUMERIC_EFFECTER_INITIALIZATION_PDR,
-         "Numeric Effecter Initialization PDR"},
-        {PLDM_COMPACT_NUMERIC_SENSOR_PDR, "Compact Numeric Sensor PDR"},
-        {PLDM_STATE_EFFECTER_PDR, "State Effecter PDR"},
-        {PLDM_STATE_EFFECTER_INITIALIZATION_PDR,
-         "State Effecter Initialization PDR"},
-        {PLDM_EFFECTER_AUXILIARY_NAMES_PDR, "Effecter Auxiliary Names PDR"},
-        {PLDM_EFFECTER_OEM_SEMANTIC_PDR, "Effecter OEM Semantic PDR"},
-        {PLDM_PDR_ENTITY_ASSOCIATION, "Entity Association PDR"},
-        {PLDM_ENTITY_AUXILIARY_NAMES_PDR, "Entity Auxiliary Names PDR"},
-        {PLDM_OEM_ENTITY_ID_PDR, "OEM Entity ID PDR"},
-        {PLDM_INTERRUPT_ASSOCIATION_PDR, "Interrupt Association PDR"},
-        {PLDM_EVENT_LOG_PDR, "PLDM Event Log PDR"},
-        {PLDM_PDR_FRU_RECORD_SET, "FRU Record Set PDR"},
-        {PLDM_OEM_DEVICE_PDR, "OEM Device PDR"},
-        {PLDM_OEM_PDR, "OEM PDR"},
-    };
-
     static inline const std::map<uint8_t, std::string> setThermalTrip{
         {PLDM_STATE_SET_THERMAL_TRIP_STATUS_NORMAL, "Normal"},
         {PLDM_STATE_SET_THERMAL_TRIP_STATUS_THERMAL_TRIP, "Thermal Trip"}};
@@ -713,19 +731,6 @@ class GetPDR : public CommandInterface
         return data;
     }
 
-    std::string getPDRType(uint8_t type)
-    {
-        auto typeString = std::to_string(type);
-        try
-        {
-            return pdrType.at(type);
-        }
-        catch (const std::out_of_range& e)
-        {
-            return typeString;
-        }
-    }
-
     void printCommonPDRHeader(const pldm_pdr_hdr* hdr, ordered_json& output)
     {
         output["recordHandle"] = hdr->record_handle;
@@ -2130,6 +2135,435 @@ class GetNumericEffecterValue : public CommandInterface
     }
 };
 
+class AnalyzePDR : public CommandInterface
+{
+  public:
+    ~AnalyzePDR() = default;
+    AnalyzePDR() = delete;
+    AnalyzePDR(const AnalyzePDR&) = delete;
+    AnalyzePDR(AnalyzePDR&&) = default;
+    AnalyzePDR& operator=(const AnalyzePDR&) = delete;
+    AnalyzePDR& operator=(AnalyzePDR&&) = delete;
+
+    using CommandInterface::CommandInterface;
+
+    explicit AnalyzePDR(const char* type, const char* name, CLI::App* app) :
+        CommandInterface(type, name, app)
+    {
+        auto saveOption = app->add_option(
+            "-s,--save", saveFile,
+            "save the fetched PDRs to a raw PDR dump file");
+        app->add_option("-f,--file", dumpFile,
+                        "analyze a raw PDR dump file instead of fetching the "
+                        "PDRs from the endpoint")
+            ->check(CLI::ExistingFile)
+            ->excludes(saveOption);
+        app->add_option("-g,--graph", graphFile,
+                        "write the entity association graph to a file in the "
+                        "DOT format");
+    }
+
+    void exec() override
+    {
+        if (!dumpFile.empty())
+        {
+            std::ifstream dump(dumpFile, std::ios::binary);
+            pdrs.assign(std::istreambuf_iterator<char>(dump),
+                        std::istreambuf_iterator<char>());
+            if (dump.bad())
+            {
+                std::cerr << "Failed to read the PDR dump " << dumpFile
+                          << "\n";
+                return;
+            }
+        }
+        else
+        {
+            recordHandle = 0;
+            do
+            {
+                fetched = false;
+                CommandInterface::exec();
+            } while (fetched && recordHandle != 0);
+            if (!fetched)
+            {
+                return;
+            }
+
+            if (!saveFile.empty())
+            {
+                std::ofstream dump(saveFile, std::ios::binary);
+                dump.write(reinterpret_cast<const char*>(pdrs.data()),
+                           pdrs.size());
+                if (!dump)
+                {
+                    std::cerr << "Failed to write the PDR dump " << saveFile
+                              << "\n";
+                }
+            }
+        }
+
+        analyze();
+    }
+
+    std::pair<int, std::vector<uint8_t>> createRequestMsg() override
+    {
+        std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
+                                        PLDM_GET_PDR_REQ_BYTES);
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+
+        auto rc = encode_get_pdr_req(instanceId, recordHandle, 0,
+                                     PLDM_GET_FIRSTPART, UINT16_MAX, 0, request,
+                                     PLDM_GET_PDR_REQ_BYTES);
+        return {rc, requestMsg};
+    }
+
+    void parseResponseMsg(pldm_msg* responsePtr, size_t payloadLength) override
+    {
+        uint8_t completionCode = 0;
+        uint8_t recordData[UINT16_MAX] = {0};
+        uint32_t nextRecordHndl = 0;
+        uint32_t nextDataTransferHndl = 0;
+        uint8_t transferFlag = 0;
+        uint16_t respCnt = 0;
+        uint8_t transferCRC = 0;
+
+        auto rc = decode_get_pdr_resp(
+            responsePtr, payloadLength, &completionCode, &nextRecordHndl,
+            &nextDataTransferHndl, &transferFlag, &respCnt, recordData,
+            sizeof(recordData), &transferCRC);
+
+        if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
+        {
+            std::cerr << "Response Message Error: "
+                      << "rc=" << rc << ",cc=" << (int)completionCode
+                      << std::endl;
+            return;
+        }
+
+        if (transferFlag != PLDM_START_AND_END)
+        {
+            std::cerr << "Multipart transfer of the PDR with record handle "
+                      << recordHandle << " is not supported\n";
+            return;
+        }
+
+        // Guard against a repository whose record handles loop back
+        if (!requestedHandles.emplace(recordHandle).second)
+        {
+            std::cerr << "Record handle " << recordHandle
+                      << " was already fetched\n";
+            return;
+        }
+
+        pdrs.insert(pdrs.end(), recordData, recordData + respCnt);
+        recordHandle = nextRecordHndl;
+        fetched = true;
+    }
+
+  private:
+    /** @brief Entity type, entity instance number and container ID */
+    using Entity = std::tuple<uint16_t, uint16_t, uint16_t>;
+
+    /** @brief Entity referenced by a sensor, effecter or FRU record set PDR
+     */
+    struct EntityReference
+    {
+        uint32_t recordHandle;
+        uint8_t type;
+        uint16_t terminusHandle;
+        uint16_t id; //!< sensor ID, effecter ID or FRU record set identifier
+        Entity entity;
+    };
+
+    /** @brief Containment of an entity, from an entity association PDR */
+    struct Association
+    {
+        Entity container;
+        Entity child;
+        bool logical;
+    };
+
+    static uint16_t getUint16(std::span<const uint8_t> data, size_t offset)
+    {
+        uint16_t value = 0;
+        std::memcpy(&value, data.data() + offset, sizeof(value));
+        return value;
+    }
+
+    static Entity getEntity(std::span<const uint8_t> data, size_t offset)
+    {
+        return {getUint16(data, offset),
+                getUint16(data, offset + sizeof(uint16_t)),
+                getUint16(data, offset + 2 * sizeof(uint16_t))};
+    }
+
+    static ordered_json toJson(const Entity& entity)
+    {
+        const auto& [type, instance, container] = entity;
+        ordered_json output;
+        output["entityType"] = type;
+        output["entityInstanceNumber"] = instance;
+        output["containerID"] = container;
+        return output;
+    }
+
+    static std::string toNodeName(const Entity& entity)
+    {
+        const auto& [type, instance, container] = entity;
+        return "\"" + std::to_string(type) + "_" + std::to_string(instance) +
+               "_" + std::to_string(container) + "\"";
+    }
+
+    /** @brief Build the entity association graph out of the PDRs, print the
+     *         summary of the PDR repository along with the inconsistencies
+     *         found and write the graph if requested
+     */
+    void analyze()
+    {
+        // Terminus handle, then sensor ID, effecter ID or FRU record set
+        // identifier, the PDRs of a terminus share the ID spaces
+        enum IdSpace
+        {
+            sensorIds,
+            effecterIds,
+            fruRecordSetIds,
+        };
+        using Id = std::tuple<IdSpace, uint16_t, uint16_t>;
+
+        // Terminus handle, ID and entity type, instance number and container
+        // ID of the PDRs following the common header
+        constexpr size_t referenceLength = 5 * sizeof(uint16_t);
+        // Container ID, association type, container entity and number of
+        // contained entities, followed by the contained entities
+        constexpr size_t associationLength = 5 * sizeof(uint16_t);
+        constexpr size_t entityLength = 3 * sizeof(uint16_t);
+
+        std::map<uint8_t, size_t> typeCounts;
+        std::map<uint32_t, size_t> handleCounts;
+        std::map<Id, std::vector<uint32_t>> ids;
+        std::vector<EntityReference> references;
+        std::vector<Association> associations;
+        std::set<Entity> entities;
+        std::set<Entity> children;
+        ordered_json malformed = ordered_json::array();
+        size_t count = 0;
+
+        std::span<const uint8_t> data(pdrs);
+        size_t offset = 0;
+        while (offset < data.size())
+        {
+            pldm_pdr_hdr hdr{};
+            auto recordOffset = offset;
+            if (data.size() - offset < sizeof(hdr))
+            {
+                malformed.push_back({{"offset", recordOffset},
+                                     {"error", "truncated PDR header"}});
+                break;
+            }
+            std::memcpy(&hdr, data.data() + offset, sizeof(hdr));
+            uint32_t handle = hdr.record_handle;
+            uint8_t type = hdr.type;
+            uint16_t length = hdr.length;
+            if (data.size() - offset - sizeof(hdr) < length)
+            {
+                malformed.push_back({{"offset", recordOffset},
+                                     {"recordHandle", handle},
+                                     {"error", "truncated PDR data"}});
+                break;
+            }
+            auto body = data.subspan(offset + sizeof(hdr), length);
+            offset += sizeof(hdr) + length;
+
+            count++;
+            typeCounts[type]++;
+            handleCounts[handle]++;
+
+            switch (type)
+            {
+                case PLDM_STATE_SENSOR_PDR:
+                case PLDM_NUMERIC_SENSOR_PDR:
+                case PLDM_STATE_EFFECTER_PDR:
+                case PLDM_NUMERIC_EFFECTER_PDR:
+                case PLDM_PDR_FRU_RECORD_SET:
+                {
+                    if (body.size() < referenceLength)
+                    {
+                        malformed.push_back({{"offset", recordOffset},
+                                             {"recordHandle", handle},
+                                             {"error", "PDR data too short"}});
+                        continue;
+                    }
+                    EntityReference reference{
+                        handle, type, getUint16(body, 0),
+                        getUint16(body, sizeof(uint16_t)),
+                        getEntity(body, 2 * sizeof(uint16_t))};
+                    IdSpace space = fruRecordSetIds;
+                    if (type == PLDM_STATE_SENSOR_PDR ||
+                        type == PLDM_NUMERIC_SENSOR_PDR)
+                    {
+                        space = sensorIds;
+                    }
+                    else if (type == PLDM_STATE_EFFECTER_PDR ||
+                             type == PLDM_NUMERIC_EFFECTER_PDR)
+                    {
+                        space = effecterIds;
+                    }
+                    ids[{space, reference.terminusHandle, reference.id}]
+                        .push_back(handle);
+                    references.push_back(reference);
+                    break;
+                }
+                case PLDM_PDR_ENTITY_ASSOCIATION:
+                {
+                    if (body.size() < associationLength ||
+                        body.size() < associationLength +
+                                          body[associationLength - 1] *
+                                              entityLength)
+                    {
+                        malformed.push_back({{"offset", recordOffset},
+                                             {"recordHandle", handle},
+                                             {"error", "PDR data too short"}});
+                        continue;
+                    }
+                    bool logical = body[sizeof(uint16_t)] ==
+                                   PLDM_ENTITY_ASSOCIAION_LOGICAL;
+                    auto container = getEntity(body, sizeof(uint16_t) + 1);
+                    entities.emplace(container);
+                    for (size_t i = 0; i < body[associationLength - 1]; ++i)
+                    {
+                        auto child = getEntity(body, associationLength +
+                                                         i * entityLength);
+                        entities.emplace(child);
+                        children.emplace(child);
+                        associations.push_back({container, child, logical});
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        ordered_json output;
+        output["PDRCount"] = count;
+        output["PDRSize"] = offset;
+        ordered_json types;
+        for (const auto& [type, typeCount] : typeCounts)
+        {
+            types[getPDRType(type)] = typeCount;
+        }
+        output["PDRTypes"] = types;
+        output["entityCount"] = entities.size();
+        output["associationCount"] = associations.size();
+
+        ordered_json duplicateHandles = ordered_json::array();
+        for (const auto& [handle, handleCount] : handleCounts)
+        {
+            if (handleCount > 1)
+            {
+                duplicateHandles.push_back(handle);
+            }
+        }
+        output["duplicateRecordHandles"] = duplicateHandles;
+
+        const std::array<const char*, 3> idNames = {
+            "sensorID", "effecterID", "FRURecordSetIdentifier"};
+        const std::array<const char*, 3> duplicateIdKeys = {
+            "duplicateSensorIDs", "duplicateEffecterIDs",
+            "duplicateFRURecordSetIdentifiers"};
+        for (const auto& key : duplicateIdKeys)
+        {
+            output[key] = ordered_json::array();
+        }
+        for (const auto& [id, handles] : ids)
+        {
+            if (handles.size() > 1)
+            {
+                const auto& [space, terminusHandle, value] = id;
+                ordered_json duplicate;
+                duplicate["PLDMTerminusHandle"] = terminusHandle;
+                duplicate[idNames[space]] = value;
+                duplicate["recordHandles"] = handles;
+                output[duplicateIdKeys[space]].push_back(duplicate);
+            }
+        }
+
+        // Entities the sensors, effecters and FRU record sets are about must
+        // be part of the entity association graph
+        std::set<Entity> orphans;
+        ordered_json orphanEntities = ordered_json::array();
+        for (const auto& reference : references)
+        {
+            if (entities.contains(reference.entity))
+            {
+                continue;
+            }
+            orphans.emplace(reference.entity);
+            auto orphan = toJson(reference.entity);
+            orphan["recordHandle"] = reference.recordHandle;
+            orphan["PDRType"] = getPDRType(reference.type);
+            orphanEntities.push_back(orphan);
+        }
+        output["orphanEntities"] = orphanEntities;
+
+        // The system entity is the only one outside of any container, the
+        // other entities of the graph must be contained by an entity
+        ordered_json unparentedEntities = ordered_json::array();
+        for (const auto& entity : entities)
+        {
+            if (std::get<2>(entity) != 0 && !children.contains(entity))
+            {
+                unparentedEntities.push_back(toJson(entity));
+            }
+        }
+        output["unparentedEntities"] = unparentedEntities;
+        output["malformedPDRs"] = malformed;
+
+        DisplayInJson(output);
+
+        if (graphFile.empty())
+        {
+            return;
+        }
+
+        std::ofstream graph(graphFile);
+        graph << "digraph EntityAssociation {\n";
+        for (const auto& entity : entities)
+        {
+            const auto& [type, instance, container] = entity;
+            graph << "    " << toNodeName(entity) << " [label=\"" << type
+                  << " " << instance << " " << container << "\"];\n";
+        }
+        for (const auto& entity : orphans)
+        {
+            const auto& [type, instance, container] = entity;
+            graph << "    " << toNodeName(entity) << " [label=\"" << type
+                  << " " << instance << " " << container
+                  << "\", color=red];\n";
+        }
+        for (const auto& [container, child, logical] : associations)
+        {
+            graph << "    " << toNodeName(container) << " -> "
+                  << toNodeName(child)
+                  << (logical ? " [style=dashed];\n" : ";\n");
+        }
+        graph << "}\n";
+        if (!graph)
+        {
+            std::cerr << "Failed to write the graph " << graphFile << "\n";
+        }
+    }
+
+    std::string dumpFile;
+    std::string saveFile;
+    std::string graphFile;
+    uint32_t recordHandle = 0;
+    bool fetched = false;
+    std::set<uint32_t> requestedHandles;
+    std::vector<uint8_t> pdrs;
+};
+
 void registerCommand(CLI::App& app)
 {
     auto platform = app.add_subcommand("platform", "platform type command");
@@ -2163,6 +2597,11 @@ void registerCommand(CLI::App& app)
         "GetSensorReading", "get the numeric sensor reading");
     commands.push_back(std::make_unique<GetSensorReading>(
         "platform", "getSensorReading", getSensorReading));
+
+    auto analyzePDR = platform->add_subcommand(
+        "AnalyzePDR", "analyze the PDR repository and its entity associations");
+    commands.push_back(
+        std::make_unique<AnalyzePDR>("platform", "analyzePDR", analyzePDR));
 }
 
 void parseGetPDROption()
@@ -0,0 +1,105 @@
+#include "pldm_trace_cmd.hpp"
+
+#include "common/message_tracer.hpp"
+#include "pldm_cmd_helper.hpp"
+
+#include <libpldm/base.h>
+
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace pldmtool
+{
+
+namespace trace
+{
+
+namespace
+{
+
+using namespace pldmtool::helper;
+using namespace pldm::tracing;
+
+std::string tracePath{messageTracePath};
+
+/** @brief Render a trace timestamp as UTC date and time */
+std::string toTimeString(uint64_t timestamp)
+{
+    constexpr uint64_t nsPerSecond = 1000000000;
+    std::time_t seconds = static_cast<std::time_t>(timestamp / nsPerSecond);
+    std::tm tm{};
+    gmtime_r(&seconds, &tm);
+
+    std::ostringstream os;
+    os << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << '.' << std::setfill('0')
+       << std::setw(9) << timestamp % nsPerSecond;
+    return os.str();
+}
+
+std::string toHexString(const std::vector<uint8_t>& data)
+{
+    std::ostringstream os;
+    for (auto byte : data)
+    {
+        os << std::setfill('0') << std::setw(2) << std::hex
+           << static_cast<unsigned>(byte) << ' ';
+    }
+    auto str = os.str();
+    if (!str.empty())
+    {
+        str.pop_back();
+    }
+    return str;
+}
+
+void decodeTrace()
+{
+    std::ifstream traceFile(tracePath, std::ios::binary);
+    if (!traceFile)
+    {
+        std::cerr << "Failed to open the trace file " << tracePath << "\n";
+        return;
+    }
+
+    ordered_json output = ordered_json::array();
+    for (const auto& record : MessageTracer::parse(traceFile))
+    {
+        ordered_json message;
+        message["Timestamp"] = toTimeString(record.timestamp);
+        message["EID"] = record.eid;
+        message["Direction"] = record.isTx ? "Tx" : "Rx";
+        message["Length"] = record.length;
+        if (record.data.size() >= sizeof(pldm_msg_hdr))
+        {
+            auto hdr = reinterpret_cast<const pldm_msg_hdr*>(
+                record.data.data());
+            message["Request"] = static_cast<bool>(hdr->request);
+            message["InstanceID"] = hdr->instance_id;
+            message["PLDMType"] = hdr->type;
+            message["Command"] = hdr->command;
+            if (!hdr->request && record.data.size() > sizeof(pldm_msg_hdr))
+            {
+                message["CompletionCode"] = record.data[sizeof(pldm_msg_hdr)];
+            }
+        }
+        message["Data"] = toHexString(record.data);
+        output.emplace_back(std::move(message));
+    }
+    DisplayInJson(output);
+}
+
+} // namespace
+
+void registerCommand(CLI::App& app)
+{
+    auto trace = app.add_subcommand(
+        "trace", "decode the PLDM messages traced by pldmd in verbose mode");
+    trace->add_option("-f,--file", tracePath, "trace file to decode")
+        ->check(CLI::ExistingFile);
+    trace->callback([]() { decodeTrace(); });
+}
+
+} // namespace trace
+} // namespace pldmtool
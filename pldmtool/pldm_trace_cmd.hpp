@@ -0,0 +1,15 @@
+#pragma once
+
+#include <CLI/CLI.hpp>
+
+namespace pldmtool
+{
+
+namespace trace
+{
+
+void registerCommand(CLI::App& app);
+
+} // namespace trace
+
+} // namespace pldmtool
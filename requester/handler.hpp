@@ -213,6 +213,7 @@ class Handler
                 "Failure to send the PLDM request message for polling endpoint queue, response code '{RC}'",
                 "RC", rc);
             endpointMessageQueues[eid]->activeRequest = false;
+            failRequest(eid, std::move(requestMsg->responseHandler));
             return rc;
         }
 
@@ -227,7 +228,9 @@ class Handler
             error(
                 "Failed to start the instance ID expiry timer, error - {ERROR}",
                 "ERROR", e);
+            request->stop();
             endpointMessageQueues[eid]->activeRequest = false;
+            failRequest(eid, std::move(requestMsg->responseHandler));
             return PLDM_ERROR;
         }
 
@@ -433,6 +436,40 @@ class Handler
                        RequestKeyHasher>
         removeRequestContainer;
 
+    /** @brief Container of the notifications of the requests that could not
+     *         be sent, keyed by a sequence number as the instance IDs of the
+     *         requests are already freed
+     */
+    std::unordered_map<uint64_t, std::unique_ptr<sdeventplus::source::Defer>>
+        failedRequestContainer;
+    uint64_t failedRequestCount = 0;
+
+    /** @brief Call the response handler of a request that could not be sent
+     *         with an empty response, from the event loop as the caller of
+     *         registerRequest may not expect it to be called right away, and
+     *         send the next request of the endpoint
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] responseHandler - response handler of the request
+     */
+    void failRequest(mctp_eid_t eid, ResponseHandler&& responseHandler)
+    {
+        auto id = failedRequestCount++;
+        failedRequestContainer.emplace(
+            id, std::make_unique<sdeventplus::source::Defer>(
+                    event, [this, id, eid,
+                            responseHandler = std::move(responseHandler)](
+                               sdeventplus::source::EventBase&) mutable {
+            // The captures go along with the source, they are moved out first
+            auto self = this;
+            auto endpoint = eid;
+            auto handler = std::move(responseHandler);
+            self->failedRequestContainer.erase(id);
+            handler(endpoint, nullptr, 0);
+            self->pollEndpointQueue(endpoint);
+        }));
+    }
+
     /** @brief Remove request entry for which the instance ID expired
      *
      *  @param[in] key - key for the Request
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/flight_recorder.hpp"
+#include "common/message_tracer.hpp"
 #include "common/transport.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
@@ -174,7 +175,8 @@ class Request final : public RequestRetryTimer
     {
         if (verbose)
         {
-            pldm::utils::printBuffer(pldm::utils::Tx, requestMsg);
+            pldm::tracing::MessageTracer::GetInstance().record(
+                eid, pldm::utils::Tx, requestMsg);
         }
         pldm::flightrecorder::FlightRecorder::GetInstance().saveRecord(
             requestMsg, true);
@@ -0,0 +1,308 @@
+#pragma once
+
+#include "common/instance_id.hpp"
+#include "common/types.hpp"
+#include "handler.hpp"
+
+#include <libpldm/base.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace requester
+{
+
+/** @class RequestProxy
+ *
+ *  @brief Local endpoint of pldmd that takes the PLDM requests of the local
+ *  clients, such as pldmtool, over a UNIX socket and schedules them through
+ *  the requester handler, so that they share the instance IDs, the endpoint
+ *  queues and the retries of pldmd instead of racing it on the transport.
+ *
+ *  The socket is of the SOCK_SEQPACKET type, a client sends a datagram made
+ *  of the EID of the remote endpoint followed by the PLDM request message and
+ *  gets back a datagram made of the EID followed by the PLDM response
+ *  message, or by nothing if the request failed or timed out. The instance ID
+ *  of the request is replaced by one allocated by pldmd and the one of the
+ *  client is restored in the response.
+ */
+template <class RequestInterface>
+class RequestProxy
+{
+  public:
+    RequestProxy() = delete;
+    RequestProxy(const RequestProxy&) = delete;
+    RequestProxy(RequestProxy&&) = delete;
+    RequestProxy& operator=(const RequestProxy&) = delete;
+    RequestProxy& operator=(RequestProxy&&) = delete;
+
+    /** @brief Constructor, listens on the proxy socket
+     *
+     *  @param[in] event - reference to PLDM daemon's main event loop
+     *  @param[in] instanceIdDb - reference to an InstanceIdDb
+     *  @param[in] handler - PLDM request handler
+     *  @param[in] socketPath - path of the proxy socket
+     *
+     *  @throw std::system_error if the socket cannot be set up
+     */
+    RequestProxy(sdeventplus::Event& event, pldm::InstanceIdDb& instanceIdDb,
+                 Handler<RequestInterface>& handler,
+                 const std::string& socketPath) :
+        event(event), instanceIdDb(instanceIdDb), handler(handler),
+        socketPath(socketPath)
+    {
+        sockaddr_un addr{};
+        if (socketPath.size() >= sizeof(addr.sun_path))
+        {
+            throw std::system_error(ENAMETOOLONG, std::generic_category(),
+                                    "Request proxy socket path too long");
+        }
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, socketPath.c_str(), socketPath.size());
+
+        listenFd =
+            socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to create request proxy socket");
+        }
+
+        // The socket of a previous instance of pldmd is left behind
+        unlink(socketPath.c_str());
+        if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) ||
+            chmod(socketPath.c_str(), S_IRUSR | S_IWUSR) ||
+            listen(listenFd, SOMAXCONN))
+        {
+            auto err = errno;
+            close(listenFd);
+            unlink(socketPath.c_str());
+            throw std::system_error(err, std::generic_category(),
+                                    "Failed to listen on request proxy socket");
+        }
+
+        listener = std::make_unique<sdeventplus::source::IO>(
+            event, listenFd, EPOLLIN,
+            [this](sdeventplus::source::IO&, int, uint32_t) {
+                acceptClients();
+            });
+    }
+
+    ~RequestProxy()
+    {
+        clients.clear();
+        listener.reset();
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+
+  private:
+    /** @brief Connection of a local client */
+    struct Client
+    {
+        explicit Client(int fd) : fd(fd) {}
+        Client(const Client&) = delete;
+        Client& operator=(const Client&) = delete;
+
+        ~Client()
+        {
+            io.reset();
+            close(fd);
+        }
+
+        int fd;
+        std::unique_ptr<sdeventplus::source::IO> io;
+    };
+
+    /** @brief Accept the pending client connections */
+    void acceptClients()
+    {
+        while (true)
+        {
+            int fd = accept4(listenFd, nullptr, nullptr,
+                             SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0)
+            {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                {
+                    error(
+                        "Failed to accept request proxy client, error number - {ERROR}",
+                        "ERROR", errno);
+                }
+                return;
+            }
+
+            auto id = nextClientId++;
+            auto client = std::make_unique<Client>(fd);
+            client->io = std::make_unique<sdeventplus::source::IO>(
+                event, fd, EPOLLIN,
+                [this, id](sdeventplus::source::IO&, int, uint32_t) {
+                    readRequests(id);
+                });
+            clients.emplace(id, std::move(client));
+        }
+    }
+
+    /** @brief Read the pending requests of a client
+     *
+     *  @param[in] id - client ID
+     */
+    void readRequests(uint64_t id)
+    {
+        auto it = clients.find(id);
+        if (it == clients.end())
+        {
+            return;
+        }
+        auto fd = it->second->fd;
+
+        while (true)
+        {
+            auto size = recv(fd, nullptr, 0, MSG_PEEK | MSG_TRUNC);
+            if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                return;
+            }
+            if (size <= 0)
+            {
+                // The client hung up, its outstanding responses are dropped
+                clients.erase(id);
+                return;
+            }
+
+            std::vector<uint8_t> packet(size);
+            if (recv(fd, packet.data(), packet.size(), 0) != size)
+            {
+                clients.erase(id);
+                return;
+            }
+            handleRequest(id, std::move(packet));
+            if (!clients.contains(id))
+            {
+                return;
+            }
+        }
+    }
+
+    /** @brief Schedule a request of a client through the handler
+     *
+     *  @param[in] id - client ID
+     *  @param[in] packet - EID followed by the PLDM request message
+     */
+    void handleRequest(uint64_t id, std::vector<uint8_t>&& packet)
+    {
+        if (packet.size() < sizeof(mctp_eid_t) + sizeof(pldm_msg_hdr))
+        {
+            error("Request proxy packet of length {LENGTH} too short",
+                  "LENGTH", packet.size());
+            reply(id, {packet[0]});
+            return;
+        }
+
+        mctp_eid_t eid = packet[0];
+        pldm::Request request(packet.begin() + sizeof(mctp_eid_t),
+                              packet.end());
+        auto hdr = reinterpret_cast<pldm_msg_hdr*>(request.data());
+        if (!hdr->request)
+        {
+            reply(id, {eid});
+            return;
+        }
+
+        uint8_t clientInstanceId = hdr->instance_id;
+        uint8_t instanceId{};
+        try
+        {
+            instanceId = instanceIdDb.next(eid);
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to allocate instance ID for proxied request to EID '{EID}', error - {ERROR}",
+                "EID", (unsigned)eid, "ERROR", e);
+            reply(id, {eid});
+            return;
+        }
+        hdr->instance_id = instanceId;
+        uint8_t type = hdr->type;
+        uint8_t command = hdr->command;
+
+        auto rc = handler.registerRequest(
+            eid, instanceId, type, command, std::move(request),
+            [this, id, clientInstanceId](mctp_eid_t eid,
+                                         const pldm_msg* response,
+                                         size_t respMsgLen) {
+                std::vector<uint8_t> packet{eid};
+                if (response)
+                {
+                    auto msg = reinterpret_cast<const uint8_t*>(response);
+                    packet.insert(packet.end(), msg,
+                                  msg + sizeof(pldm_msg_hdr) + respMsgLen);
+                    auto hdr = reinterpret_cast<pldm_msg_hdr*>(
+                        packet.data() + sizeof(mctp_eid_t));
+                    hdr->instance_id = clientInstanceId;
+                }
+                reply(id, packet);
+            });
+        if (rc != PLDM_SUCCESS)
+        {
+            instanceIdDb.free(eid, instanceId);
+            reply(id, {eid});
+        }
+    }
+
+    /** @brief Send a response to a client, if it is still connected
+     *
+     *  @param[in] id - client ID
+     *  @param[in] packet - EID followed by the PLDM response message
+     */
+    void reply(uint64_t id, const std::vector<uint8_t>& packet)
+    {
+        auto it = clients.find(id);
+        if (it == clients.end())
+        {
+            return;
+        }
+
+        if (send(it->second->fd, packet.data(), packet.size(), MSG_NOSIGNAL) <
+            0)
+        {
+            error(
+                "Failed to send response to request proxy client, error number - {ERROR}",
+                "ERROR", errno);
+            clients.erase(it);
+        }
+    }
+
+    sdeventplus::Event& event;
+    pldm::InstanceIdDb& instanceIdDb;
+    Handler<RequestInterface>& handler;
+    std::string socketPath;
+
+    int listenFd = -1;
+    std::unique_ptr<sdeventplus::source::IO> listener;
+
+    /** @brief connected clients keyed by client ID */
+    std::unordered_map<uint64_t, std::unique_ptr<Client>> clients;
+    uint64_t nextClientId = 0;
+};
+
+} // namespace requester
+} // namespace pldm
@@ -290,3 +290,42 @@ TEST_F(HandlerTest, asyncRequestResponseByCoroutine)
 
     stdexec::sync_wait(scope.on_empty());
 }
+
+TEST_F(HandlerTest, requestSendFailure)
+{
+    class FailingRequest : public RequestRetryTimer
+    {
+      public:
+        FailingRequest(PldmTransport* /*pldmTransport*/, mctp_eid_t /*eid*/,
+                       sdeventplus::Event& event, pldm::Request&& /*request*/,
+                       uint8_t numRetries,
+                       std::chrono::milliseconds responseTimeOut,
+                       bool /*verbose*/) :
+            RequestRetryTimer(event, numRetries, responseTimeOut)
+        {}
+
+        int send() const override
+        {
+            return PLDM_ERROR;
+        }
+    };
+
+    Handler<FailingRequest> reqHandler(pldmTransport, event, instanceIdDb,
+                                       false, seconds(1), 2,
+                                       milliseconds(100));
+    pldm::Request request{};
+    auto instanceId = instanceIdDb.next(eid);
+    auto rc = reqHandler.registerRequest(
+        eid, instanceId, 0, 0, std::move(request),
+        std::move(std::bind_front(&HandlerTest::pldmResponseCallBack, this)));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    // The failure is reported from the event loop, with an empty response
+    EXPECT_EQ(callbackCount, 0);
+    waitEventExpiry(milliseconds(10));
+    EXPECT_EQ(nullResponse, true);
+    EXPECT_EQ(callbackCount, 1);
+
+    // The instance ID is freed along
+    EXPECT_EQ(instanceIdDb.next(eid), instanceId);
+}
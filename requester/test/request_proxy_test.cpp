@@ -0,0 +1,143 @@
+#include "common/instance_id.hpp"
+#include "common/types.hpp"
+#include "mock_request.hpp"
+#include "requester/handler.hpp"
+#include "requester/request_proxy.hpp"
+#include "test/test_instance_id.hpp"
+
+#include <libpldm/base.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <filesystem>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace pldm::requester;
+using namespace std::chrono;
+
+using ::testing::NiceMock;
+
+class RequestProxyTest : public testing::Test
+{
+  protected:
+    RequestProxyTest() :
+        event(sdeventplus::Event::get_default()), instanceIdDb(),
+        reqHandler(nullptr, event, instanceIdDb, false, seconds(1), 2,
+                   milliseconds(100)),
+        socketPath(std::filesystem::temp_directory_path() /
+                   "request_proxy_test.sock")
+    {}
+
+    ~RequestProxyTest()
+    {
+        for (auto fd : clientFds)
+        {
+            close(fd);
+        }
+    }
+
+    /** @brief Connect a client to the proxy socket
+     *
+     *  @return the socket of the client
+     */
+    int connectClient()
+    {
+        int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK, 0);
+        EXPECT_GE(fd, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, socketPath.c_str(),
+                     sizeof(addr.sun_path) - 1);
+        EXPECT_EQ(
+            connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+        clientFds.emplace_back(fd);
+        return fd;
+    }
+
+    /** @brief Dispatch the events till there are none for the timeout */
+    void waitEventExpiry(milliseconds timeout)
+    {
+        while (sd_event_run(event.get(),
+                            duration_cast<microseconds>(timeout).count()))
+        {}
+    }
+
+    sdeventplus::Event event;
+    TestInstanceIdDb instanceIdDb;
+    Handler<NiceMock<MockRequest>> reqHandler;
+    std::filesystem::path socketPath;
+    std::vector<int> clientFds;
+};
+
+TEST_F(RequestProxyTest, proxiedRequestResponse)
+{
+    RequestProxy<NiceMock<MockRequest>> proxy(event, instanceIdDb, reqHandler,
+                                              socketPath);
+    auto fd = connectClient();
+    waitEventExpiry(milliseconds(10));
+
+    // GetTID request of the client with instance ID 7, for EID 9
+    std::vector<uint8_t> packet{9, 0x80 | 7, PLDM_BASE, PLDM_GET_TID};
+    ASSERT_EQ(send(fd, packet.data(), packet.size(), 0),
+              static_cast<ssize_t>(packet.size()));
+    waitEventExpiry(milliseconds(10));
+
+    // pldmd has allocated the first instance ID for EID 9
+    std::vector<uint8_t> response{0, PLDM_BASE, PLDM_GET_TID, PLDM_SUCCESS,
+                                  1};
+    reqHandler.handleResponse(
+        9, 0, PLDM_BASE, PLDM_GET_TID,
+        reinterpret_cast<const pldm_msg*>(response.data()),
+        response.size() - sizeof(pldm_msg_hdr));
+
+    std::vector<uint8_t> reply(16);
+    auto size = recv(fd, reply.data(), reply.size(), 0);
+    ASSERT_EQ(size, static_cast<ssize_t>(response.size() + 1));
+    reply.resize(size);
+    EXPECT_EQ(reply, (std::vector<uint8_t>{9, 7, PLDM_BASE, PLDM_GET_TID,
+                                           PLDM_SUCCESS, 1}));
+}
+
+TEST_F(RequestProxyTest, proxiedRequestTimeout)
+{
+    RequestProxy<NiceMock<MockRequest>> proxy(event, instanceIdDb, reqHandler,
+                                              socketPath);
+    auto fd = connectClient();
+    waitEventExpiry(milliseconds(10));
+
+    std::vector<uint8_t> packet{9, 0x80 | 3, PLDM_BASE, PLDM_GET_TID};
+    ASSERT_EQ(send(fd, packet.data(), packet.size(), 0),
+              static_cast<ssize_t>(packet.size()));
+
+    // Without a response the instance ID expires, the client gets the EID
+    waitEventExpiry(milliseconds(1500));
+    std::vector<uint8_t> reply(16);
+    auto size = recv(fd, reply.data(), reply.size(), 0);
+    ASSERT_EQ(size, 1);
+    EXPECT_EQ(reply[0], 9);
+}
+
+TEST_F(RequestProxyTest, invalidPackets)
+{
+    RequestProxy<NiceMock<MockRequest>> proxy(event, instanceIdDb, reqHandler,
+                                              socketPath);
+    auto fd = connectClient();
+    waitEventExpiry(milliseconds(10));
+
+    // A response message is not forwarded, neither is a truncated header
+    std::vector<uint8_t> response{9, 2, PLDM_BASE, PLDM_GET_TID};
+    std::vector<uint8_t> truncated{9, 0x80};
+    ASSERT_GT(send(fd, response.data(), response.size(), 0), 0);
+    ASSERT_GT(send(fd, truncated.data(), truncated.size(), 0), 0);
+    waitEventExpiry(milliseconds(10));
+
+    std::vector<uint8_t> reply(16);
+    EXPECT_EQ(recv(fd, reply.data(), reply.size(), 0), 1);
+    EXPECT_EQ(reply[0], 9);
+    EXPECT_EQ(recv(fd, reply.data(), reply.size(), 0), 1);
+    EXPECT_EQ(reply[0], 9);
+}